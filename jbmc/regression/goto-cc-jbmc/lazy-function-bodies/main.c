@@ -0,0 +1,17 @@
+int reached(int x)
+{
+  return x+1;
+}
+
+int unreached(int x)
+{
+  return x-1;
+}
+
+int main(void)
+{
+  int x;
+  __CPROVER_assume(x<10);
+  __CPROVER_assert(reached(x)<11, "reached");
+  return 0;
+}
@@ -0,0 +1,21 @@
+int x, y;
+int r1, r2;
+_Bool done;
+
+void thread()
+{
+  x=1;
+  r1=y;
+  done=1;
+}
+
+int main()
+{
+  __CPROVER_ASYNC_1: thread();
+  y=1;
+  r2=x;
+  __CPROVER_assume(done);
+  // store buffering is not possible under SC
+  assert(r1==1 || r2==1);
+  assert(r1==0 || r2==0); // to fail
+}
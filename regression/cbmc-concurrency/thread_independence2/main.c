@@ -0,0 +1,15 @@
+int config;
+int result;
+
+void worker()
+{
+  // config is only written before any thread is started
+  result=config;
+}
+
+int main()
+{
+  config=5;
+  __CPROVER_ASYNC_1: worker();
+  assert(result==5); // to fail
+}
@@ -0,0 +1,14 @@
+int main()
+{
+  int a[5];
+  int x;
+
+  for(int i=0; i<5; i++)
+    a[i]=i;
+
+  // this loop is left in its second iteration at the latest
+  while(x>0)
+    x=0;
+
+  __CPROVER_assert(a[4]==4, "loop completed");
+}
@@ -0,0 +1,10 @@
+int main()
+{
+  int x;
+  __CPROVER_assume(0<=x && x<=1);
+
+  while(x<4)
+    x=x+1;
+
+  __CPROVER_assert(x<4, "loop left early");
+}
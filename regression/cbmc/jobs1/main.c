@@ -0,0 +1,29 @@
+struct pair
+{
+  int a, b;
+};
+
+static int counter;
+
+int sum(struct pair p)
+{
+  counter++;
+  return p.a+p.b;
+}
+
+int twice(int x)
+{
+  static int calls;
+  calls++;
+  return 2*x;
+}
+
+int main()
+{
+  struct pair p={1, 2};
+  int x=twice(sum(p));
+  __CPROVER_assert(x==6, "sum and twice");
+  __CPROVER_assert(counter==1, "counter");
+  __CPROVER_assert(x==7, "expected to fail");
+  return 0;
+}
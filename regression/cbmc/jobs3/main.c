@@ -0,0 +1,6 @@
+int main()
+{
+  int x;
+  __CPROVER_assert(x==x, "reflexive");
+  return 0;
+}
@@ -0,0 +1,30 @@
+int sum(int a, int b);
+
+int first(int x)
+{
+  // later is declared implicitly here
+  return later(x)+1;
+}
+
+int second(int x)
+{
+  return sum(x, 1);
+}
+
+int later(int x)
+{
+  return 2*x;
+}
+
+int sum(int a, int b)
+{
+  return a+b;
+}
+
+int main()
+{
+  __CPROVER_assert(first(1)==3, "implicit declaration");
+  __CPROVER_assert(second(1)==2, "prototype");
+  __CPROVER_assert(second(2)==2, "expected to fail");
+  return 0;
+}
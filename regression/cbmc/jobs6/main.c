@@ -0,0 +1,21 @@
+extern int a[];
+
+int first(void)
+{
+  return a[0];
+}
+
+int second(void)
+{
+  return a[1];
+}
+
+int main(void)
+{
+  // completes the type of a, which first and second use
+  extern int a[3];
+  int y=a[0];
+  __CPROVER_assert(y==first(), "same element");
+  __CPROVER_assert(sizeof(a)==3*sizeof(int), "completed type");
+  return y+second();
+}
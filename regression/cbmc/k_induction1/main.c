@@ -0,0 +1,14 @@
+int nondet_int();
+
+int main()
+{
+  int x=0;
+
+  while(nondet_int())
+  {
+    if(x<10)
+      x=x+1;
+
+    __CPROVER_assert(x<=10, "bounded");
+  }
+}
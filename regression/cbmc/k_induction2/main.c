@@ -0,0 +1,15 @@
+int nondet_int();
+
+int main()
+{
+  int x=0;
+
+  // not inductive for any k unless x is known to be non-negative
+  while(nondet_int())
+  {
+    if(x<10)
+      x=x+1;
+
+    __CPROVER_assert(x!=-1, "not minus one");
+  }
+}
@@ -0,0 +1,15 @@
+int nondet_int();
+
+int main()
+{
+  int x=0, *p=&x;
+
+  // the interval of x is not an invariant, as x is written through p
+  while(nondet_int())
+  {
+    __CPROVER_assert(x!=-1, "not minus one");
+
+    if(nondet_int())
+      *p=-1;
+  }
+}
@@ -0,0 +1,23 @@
+int called(int x)
+{
+  return x+1;
+}
+
+int via_pointer(int x)
+{
+  return x+2;
+}
+
+int unused(int x)
+{
+  return x+3;
+}
+
+int (*fp)(int)=via_pointer;
+
+int main()
+{
+  int y=called(1);
+  __CPROVER_assert(fp(y)==4, "call via pointer");
+  return 0;
+}
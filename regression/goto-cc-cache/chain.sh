@@ -0,0 +1,36 @@
+#!/usr/bin/env bash
+
+# Compile the source file twice using the same compilation cache, the second
+# time after the change given as the first option:
+#   same: no change
+#   source: the source file is changed
+#   options: the remaining options are passed to the second compilation
+
+set -e
+
+goto_cc=$1
+
+change=$2
+options=${*:3:$#-3}
+name=${*:$#}
+name=${name%.c}
+
+cache="${name}.cache"
+rm -rf "${cache}"
+cp "${name}.c" "${name}-copy.c"
+
+"${goto_cc}" --compilation-cache "${cache}" -c "${name}-copy.c" \
+  -o "${name}.o" > /dev/null
+
+if [[ "${change}" == "source" ]]; then
+  echo "int changed;" >> "${name}-copy.c"
+fi
+
+if [[ "${change}" != "options" ]]; then
+  options=
+fi
+
+"${goto_cc}" --compilation-cache "${cache}" --verbosity 8 ${options} \
+  -c "${name}-copy.c" -o "${name}.o"
+
+rm -rf "${cache}" "${name}-copy.c" "${name}.o"
@@ -0,0 +1,9 @@
+int f(int x)
+{
+  return x+1;
+}
+
+int main()
+{
+  return f(0);
+}
@@ -0,0 +1,4 @@
+int bar()
+{
+  return 2;
+}
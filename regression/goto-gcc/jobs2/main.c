@@ -0,0 +1,7 @@
+int foo();
+int bar();
+
+int main()
+{
+  return foo()+bar();
+}
@@ -40,6 +40,9 @@ then
 elif [[ "oepc" == "$strategy" ]]
 then
   strat=--one-event-per-cycle
+elif [[ "greedy" == "$strategy" ]]
+then
+  strat=--greedy-interference
 else
   strat=
 fi
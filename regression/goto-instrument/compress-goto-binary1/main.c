@@ -0,0 +1,12 @@
+int square(int x)
+{
+  return x*x;
+}
+
+int main()
+{
+  int y=square(3);
+  __CPROVER_assert(y==9, "square");
+  __CPROVER_assert(y==10, "wrong");
+  return 0;
+}
@@ -0,0 +1,22 @@
+#include <assert.h>
+
+int x, y;
+int *p, *q, **pp;
+
+int main()
+{
+  int *r;
+
+  p=&x;
+  q=p;
+  pp=&r;
+  *pp=&y;
+
+  *q=1;
+  assert(x==1);
+
+  *r=2;
+  assert(y==2);
+
+  return 0;
+}
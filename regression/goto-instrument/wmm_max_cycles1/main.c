@@ -0,0 +1,34 @@
+int x=0;
+int y=0;
+int z=0;
+int r0=0;
+int r1=0;
+int r2=0;
+int r3=0;
+
+void *P0(void *arg)
+{
+  x=1;
+  r0=y;
+  r1=z;
+}
+
+void *P1(void *arg)
+{
+  y=1;
+  r2=x;
+}
+
+void *P2(void *arg)
+{
+  z=1;
+  r3=x;
+}
+
+int main()
+{
+  __CPROVER_ASYNC_0: P0(0);
+  __CPROVER_ASYNC_1: P1(0);
+  __CPROVER_ASYNC_2: P2(0);
+  return 0;
+}
@@ -20,6 +20,7 @@ Date: August 2013
 
 #include "ai.h"
 #include "cfg_dominators.h"
+#include "post_dominators_cache.h"
 #include "reaching_definitions.h"
 
 class dependence_grapht;
@@ -220,14 +221,32 @@ public:
   using ait<dep_graph_domaint>::operator[];
   using grapht<dep_nodet>::operator[];
 
-  typedef std::map<irep_idt, cfg_post_dominatorst> post_dominators_mapt;
+  typedef post_dominators_cachet::post_dominators_mapt post_dominators_mapt;
 
   explicit dependence_grapht(const namespacet &_ns):
     ns(_ns),
+    post_dominators(local_post_dominators),
     rd(ns)
   {
   }
 
+  /// Construct a dependence graph that takes post-dominators from (and adds
+  /// them to) \p _post_dominators, which may outlive this object; this avoids
+  /// recomputing them for functions that have not changed when several
+  /// dependence graphs are built for the same goto functions
+  dependence_grapht(
+    const namespacet &_ns,
+    post_dominators_cachet &_post_dominators):
+    ns(_ns),
+    post_dominators(_post_dominators),
+    rd(ns)
+  {
+  }
+
+  // post_dominators may refer to local_post_dominators
+  dependence_grapht(const dependence_grapht &)=delete;
+  dependence_grapht &operator=(const dependence_grapht &)=delete;
+
   void initialize(const goto_functionst &goto_functions)
   {
     ait<dep_graph_domaint>::initialize(goto_functions);
@@ -241,8 +260,7 @@ public:
     if(!goto_program.empty())
     {
       const irep_idt id=goto_programt::get_function_id(goto_program);
-      cfg_post_dominatorst &pd=post_dominators[id];
-      pd(goto_program);
+      post_dominators(id, goto_program);
     }
   }
 
@@ -261,7 +279,7 @@ public:
 
   const post_dominators_mapt &cfg_post_dominators() const
   {
-    return post_dominators;
+    return post_dominators.post_dominators();
   }
 
   const reaching_definitions_analysist &reaching_definitions() const
@@ -287,7 +305,8 @@ public:
 protected:
   const namespacet &ns;
 
-  post_dominators_mapt post_dominators;
+  post_dominators_cachet local_post_dominators;
+  post_dominators_cachet &post_dominators;
   reaching_definitions_analysist rd;
 };
 
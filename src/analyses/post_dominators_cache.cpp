@@ -0,0 +1,71 @@
+/*******************************************************************\
+
+Module: Cache of Per-Function Post-Dominators
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Cache of Per-Function Post-Dominators
+
+#include "post_dominators_cache.h"
+
+#include <util/std_code.h>
+
+static std::uintptr_t address(goto_programt::const_targett t)
+{
+  return reinterpret_cast<std::uintptr_t>(&*t);
+}
+
+/// Record everything procedure_local_cfg_baset uses to compute edges; the
+/// cached results refer to instructions by iterator, hence the addresses of
+/// the instructions are part of it.
+post_dominators_cachet::control_flowt post_dominators_cachet::control_flow(
+  const goto_programt &goto_program)
+{
+  control_flowt result;
+  result.reserve(4*goto_program.instructions.size());
+
+  forall_goto_program_instructions(it, goto_program)
+  {
+    result.push_back(address(it));
+    result.push_back(it->type);
+    result.push_back(it->guard.is_true() ? 1 : it->guard.is_false() ? 2 : 0);
+    result.push_back(
+      it->is_function_call() &&
+      to_code_function_call(it->code).function().id()==ID_symbol);
+
+    result.push_back(it->targets.size());
+    for(const auto &t : it->targets)
+      result.push_back(
+        t==goto_program.instructions.end() ? 0 : address(t));
+  }
+
+  return result;
+}
+
+const cfg_post_dominatorst &post_dominators_cachet::operator()(
+  const irep_idt &function_id,
+  const goto_programt &goto_program)
+{
+  control_flowt new_control_flow=control_flow(goto_program);
+
+  const auto entry=control_flows.find(function_id);
+
+  if(entry!=control_flows.end() && entry->second==new_control_flow)
+  {
+    ++hits;
+    return post_dominators_map.at(function_id);
+  }
+
+  ++misses;
+  control_flows[function_id]=std::move(new_control_flow);
+
+  // start from a fresh object, the dominator computation accumulates
+  post_dominators_map.erase(function_id);
+  cfg_post_dominatorst &pd=post_dominators_map[function_id];
+  pd(goto_program);
+
+  return pd;
+}
@@ -0,0 +1,87 @@
+/*******************************************************************\
+
+Module: Cache of Per-Function Post-Dominators
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Cache of Per-Function Post-Dominators
+
+#ifndef CPROVER_ANALYSES_POST_DOMINATORS_CACHE_H
+#define CPROVER_ANALYSES_POST_DOMINATORS_CACHE_H
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "cfg_dominators.h"
+
+/// Keeps the post-dominators of each function across several analyses of the
+/// same goto functions, e.g., several dependence graphs constructed by a
+/// pipeline of slicing passes. The post-dominators of a function are only
+/// recomputed when its control-flow graph has changed since they were last
+/// computed, which is detected by comparing the parts of the instruction list
+/// the control-flow graph is built from (instruction addresses, types,
+/// targets and trivial guards) with those recorded when they were computed.
+class post_dominators_cachet
+{
+public:
+  typedef std::map<irep_idt, cfg_post_dominatorst> post_dominators_mapt;
+
+  post_dominators_cachet():
+    hits(0),
+    misses(0)
+  {
+  }
+
+  /// Return the post-dominators of \p goto_program, which is the body of the
+  /// function \p function_id, computing them if required
+  const cfg_post_dominatorst &operator()(
+    const irep_idt &function_id,
+    const goto_programt &goto_program);
+
+  const post_dominators_mapt &post_dominators() const
+  {
+    return post_dominators_map;
+  }
+
+  /// Drop the cached post-dominators of \p function_id, e.g., because its
+  /// body was removed
+  void invalidate(const irep_idt &function_id)
+  {
+    post_dominators_map.erase(function_id);
+    control_flows.erase(function_id);
+  }
+
+  void clear()
+  {
+    post_dominators_map.clear();
+    control_flows.clear();
+  }
+
+  std::size_t get_hits() const
+  {
+    return hits;
+  }
+
+  std::size_t get_misses() const
+  {
+    return misses;
+  }
+
+protected:
+  /// The control flow of a function, as far as its post-dominators depend on
+  /// it
+  typedef std::vector<std::uintptr_t> control_flowt;
+
+  post_dominators_mapt post_dominators_map;
+  std::map<irep_idt, control_flowt> control_flows;
+  std::size_t hits;
+  std::size_t misses;
+
+  static control_flowt control_flow(const goto_programt &goto_program);
+};
+
+#endif // CPROVER_ANALYSES_POST_DOMINATORS_CACHE_H
@@ -349,27 +349,23 @@ void rd_range_domaint::kill(
     return;
 
   bool clear_export_cache=false;
+  values_innert kept_values;
   values_innert new_values;
 
-  for(values_innert::iterator
-      it=entry->second.begin();
-      it!=entry->second.end();
-     ) // no ++it
+  for(const auto &id : entry->second)
   {
-    const reaching_definitiont &v=bv_container->get(*it);
+    const reaching_definitiont &v=bv_container->get(id);
 
     if(v.bit_begin >= range_end)
-      ++it;
+      kept_values.insert(id);
     else if(v.bit_end!=-1 &&
             v.bit_end <= range_start)
-      ++it;
+      kept_values.insert(id);
     else if(v.bit_begin >= range_start &&
             v.bit_end!=-1 &&
             v.bit_end <= range_end) // rs <= a < b <= re
     {
       clear_export_cache=true;
-
-      entry->second.erase(it++);
     }
     else if(v.bit_begin >= range_start) // rs <= a <= re < b
     {
@@ -378,8 +374,6 @@ void rd_range_domaint::kill(
       reaching_definitiont v_new=v;
       v_new.bit_begin=range_end;
       new_values.insert(bv_container->add(v_new));
-
-      entry->second.erase(it++);
     }
     else if(v.bit_end==-1 ||
             v.bit_end > range_end) // a <= rs < re < b
@@ -394,8 +388,6 @@ void rd_range_domaint::kill(
 
       new_values.insert(bv_container->add(v_new));
       new_values.insert(bv_container->add(v_new2));
-
-      entry->second.erase(it++);
     }
     else // a <= rs < b <= re
     {
@@ -404,29 +396,17 @@ void rd_range_domaint::kill(
       reaching_definitiont v_new=v;
       v_new.bit_end=range_start;
       new_values.insert(bv_container->add(v_new));
-
-      entry->second.erase(it++);
     }
   }
 
-  if(clear_export_cache)
-    export_cache.erase(identifier);
+  // leave the (possibly shared) set untouched unless something was killed
+  if(!clear_export_cache)
+    return;
 
-  values_innert::iterator it=entry->second.begin();
-  for(const auto &id : new_values)
-  {
-    while(it!=entry->second.end() && *it<id)
-      ++it;
-    if(it==entry->second.end() || id<*it)
-    {
-      entry->second.insert(it, id);
-    }
-    else if(it!=entry->second.end())
-    {
-      assert(*it==id);
-      ++it;
-    }
-  }
+  export_cache.erase(identifier);
+
+  kept_values.make_union(new_values);
+  entry->second=kept_values;
 }
 
 void rd_range_domaint::kill_inf(
@@ -484,7 +464,7 @@ bool rd_range_domaint::gen(
   v.bit_begin=range_start;
   v.bit_end=range_end;
 
-  if(!values[identifier].insert(bv_container->add(v)).second)
+  if(!values[identifier].insert(bv_container->add(v)))
     return false;
 
   export_cache.erase(identifier);
@@ -604,22 +584,7 @@ bool rd_range_domaint::merge_inner(
     }
   }
 #else
-  values_innert::iterator itr=dest.begin();
-  for(const auto &id : other)
-  {
-    while(itr!=dest.end() && *itr<id)
-      ++itr;
-    if(itr==dest.end() || id<*itr)
-    {
-      dest.insert(itr, id);
-      more=true;
-    }
-    else if(itr!=dest.end())
-    {
-      assert(*itr==id);
-      ++itr;
-    }
-  }
+  more=dest.make_union(other);
 #endif
 
   return more;
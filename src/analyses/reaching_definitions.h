@@ -17,6 +17,7 @@ Date: February 2013
 #define CPROVER_ANALYSES_REACHING_DEFINITIONS_H
 
 #include <util/base_exceptions.h>
+#include <util/sparse_bitset.h>
 #include <util/threeval.h>
 
 #include "ai.h"
@@ -187,7 +188,9 @@ private:
 
   sparse_bitvector_analysist<reaching_definitiont> *bv_container;
 
-  typedef std::set<std::size_t> values_innert;
+  // indices into bv_container; copies are shared until modified, which keeps
+  // propagating states between locations cheap
+  typedef sparse_bitsett values_innert;
   #ifdef USE_DSTRING
   typedef std::map<irep_idt, values_innert> valuest;
   #else
@@ -8,12 +8,15 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "ansi_c_language.h"
 
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 #include <fstream>
 
+#include <util/cmdline.h>
 #include <util/config.h>
 #include <util/get_base_name.h>
+#include <util/string2int.h>
 
 #include <linking/linking.h>
 #include <linking/remove_internal_symbols.h>
@@ -26,6 +29,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "ansi_c_internal_additions.h"
 #include "type2name.h"
 
+void ansi_c_languaget::get_language_options(const cmdlinet &cmdline)
+{
+  typecheck_jobs=1;
+  if(cmdline.isset("jobs"))
+    typecheck_jobs=std::max<std::size_t>(
+      1, unsafe_string2size_t(cmdline.get_value("jobs")));
+}
+
 std::set<std::string> ansi_c_languaget::extensions() const
 {
   return { "c", "i" };
@@ -111,7 +122,8 @@ bool ansi_c_languaget::typecheck(
     parse_tree,
     new_symbol_table,
     module,
-    get_message_handler()))
+    get_message_handler(),
+    typecheck_jobs))
   {
     return true;
   }
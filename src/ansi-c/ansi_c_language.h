@@ -21,6 +21,8 @@ Author: Daniel Kroening, kroening@kroening.com
 class ansi_c_languaget:public languaget
 {
 public:
+  void get_language_options(const cmdlinet &) override;
+
   bool preprocess(
     std::istream &instream,
     const std::string &path,
@@ -40,7 +42,7 @@ public:
   void show_parse(std::ostream &out) override;
 
   ~ansi_c_languaget() override;
-  ansi_c_languaget() { }
+  ansi_c_languaget():typecheck_jobs(1) { }
 
   bool from_expr(
     const exprt &expr,
@@ -75,6 +77,7 @@ public:
 protected:
   ansi_c_parse_treet parse_tree;
   std::string parse_path;
+  std::size_t typecheck_jobs;
 };
 
 std::unique_ptr<languaget> new_ansi_c_language();
@@ -21,16 +21,20 @@ void ansi_c_typecheckt::typecheck()
   {
     typecheck_declaration(*it);
   }
+
+  typecheck_deferred_function_bodies();
 }
 
 bool ansi_c_typecheck(
   ansi_c_parse_treet &ansi_c_parse_tree,
   symbol_tablet &symbol_table,
   const std::string &module,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  std::size_t jobs)
 {
   ansi_c_typecheckt ansi_c_typecheck(
     ansi_c_parse_tree, symbol_table, module, message_handler);
+  ansi_c_typecheck.set_function_body_jobs(jobs);
   return ansi_c_typecheck.typecheck_main();
 }
 
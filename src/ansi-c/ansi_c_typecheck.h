@@ -15,11 +15,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "c_typecheck_base.h"
 #include "ansi_c_parse_tree.h"
 
+/// \param jobs: if greater than one, function bodies are typechecked after
+///   all declarations, using up to this many processes
 bool ansi_c_typecheck(
   ansi_c_parse_treet &parse_tree,
   symbol_tablet &symbol_table,
   const std::string &module,
-  message_handlert &message_handler);
+  message_handlert &message_handler,
+  std::size_t jobs=1);
 
 bool ansi_c_typecheck(
   exprt &expr,
@@ -121,6 +121,12 @@ void c_typecheck_baset::typecheck_symbol(symbolt &symbol)
       throw 0;
     }
 
+    // the deferred bodies that use the symbol must see the declaration
+    // that precedes them, as they would when typechecked in source order
+    if(symbol.type!=old_it->second.type &&
+       deferred_function_body_uses.count(symbol.name)!=0)
+      typecheck_deferred_function_bodies_now();
+
     symbolt & existing_symbol=*symbol_table.get_writeable(symbol.name);
     if(symbol.is_type)
       typecheck_redefinition_type(existing_symbol, symbol);
@@ -508,16 +514,9 @@ void c_typecheck_baset::typecheck_function_body(symbolt &symbol)
 
   assert(symbol.value.is_not_nil());
 
-  // reset labels
-  labels_used.clear();
-  labels_defined.clear();
-
   // fix type
   symbol.value.type()=code_type;
 
-  // set return type
-  return_type=code_type.return_type();
-
   unsigned anon_counter=0;
 
   // Add the parameter declarations into the symbol table.
@@ -551,6 +550,23 @@ void c_typecheck_baset::typecheck_function_body(symbolt &symbol)
     move_symbol(p_symbol, new_p_symbol);
   }
 
+  if(function_body_jobs<=1 || !defer_function_body(symbol))
+    typecheck_function_code(symbol);
+}
+
+/// Typecheck the code of the body of the function \p symbol, whose parameters
+/// are in the symbol table already
+void c_typecheck_baset::typecheck_function_code(symbolt &symbol)
+{
+  const code_typet &code_type=to_code_type(symbol.type);
+
+  // reset labels
+  labels_used.clear();
+  labels_defined.clear();
+
+  // set return type
+  return_type=code_type.return_type();
+
   // typecheck the body code
   typecheck_code(to_code(symbol.value));
 
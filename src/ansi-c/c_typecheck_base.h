@@ -12,6 +12,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_ANSI_C_C_TYPECHECK_BASE_H
 #define CPROVER_ANSI_C_C_TYPECHECK_BASE_H
 
+#include <unordered_set>
+#include <vector>
+
 #include <util/symbol_table.h>
 #include <util/typecheck.h>
 #include <util/namespace.h>
@@ -38,7 +41,8 @@ public:
     mode(ID_C),
     break_is_allowed(false),
     continue_is_allowed(false),
-    case_is_allowed(false)
+    case_is_allowed(false),
+    function_body_jobs(1)
   {
   }
 
@@ -54,7 +58,8 @@ public:
     mode(ID_C),
     break_is_allowed(false),
     continue_is_allowed(false),
-    case_is_allowed(false)
+    case_is_allowed(false),
+    function_body_jobs(1)
   {
   }
 
@@ -63,6 +68,11 @@ public:
   virtual void typecheck()=0;
   virtual void typecheck_expr(exprt &expr);
 
+  void set_function_body_jobs(std::size_t jobs)
+  {
+    function_body_jobs=jobs;
+  }
+
 protected:
   symbol_tablet &symbol_table;
   const irep_idt module;
@@ -252,6 +262,24 @@ protected:
   void typecheck_redefinition_non_type(
     symbolt &old_symbol, symbolt &new_symbol);
   void typecheck_function_body(symbolt &symbol);
+  void typecheck_function_code(symbolt &symbol);
+
+  /// If greater than one, the code of function bodies is typechecked once
+  /// all declarations have been, using up to this many processes
+  std::size_t function_body_jobs;
+  std::vector<irep_idt> deferred_function_bodies;
+  std::unordered_set<irep_idt> deferred_function_body_set;
+  /// the file-scope symbols that the deferred function bodies use
+  std::unordered_set<irep_idt> deferred_function_body_uses;
+
+  bool defer_function_body(const symbolt &symbol);
+  void typecheck_deferred_function_bodies();
+  void typecheck_deferred_function_bodies_now();
+  void typecheck_deferred_function_body(const irep_idt &identifier);
+#ifndef _WIN32
+  void typecheck_function_bodies_in_parallel(
+    const std::vector<irep_idt> &bodies);
+#endif
 
   virtual void do_initializer(symbolt &symbol);
 
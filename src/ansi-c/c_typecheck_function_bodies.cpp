@@ -0,0 +1,347 @@
+/*******************************************************************\
+
+Module: ANSI-C Language Type Checking
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// ANSI-C Language Type Checking of Function Bodies
+
+#include "c_typecheck_base.h"
+
+#include "c_storage_spec.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include <util/child_processes.h>
+#include <util/symbol_serialization.h>
+#include <util/tempdir.h>
+
+/// Add the file-scope identifiers that \p irep, code or a type that has not
+/// been typechecked yet, refers to, to \p dest; the identifiers of
+/// block-scope symbols and tags contain the name of their scope
+static void find_file_scope_identifiers(
+  const irept &irep,
+  std::unordered_set<irep_idt> &dest)
+{
+  if(irep.id()==ID_symbol || irep.id()==ID_tag)
+  {
+    const irep_idt &identifier=irep.get(ID_identifier);
+    if(!identifier.empty() &&
+       id2string(identifier).find("::")==std::string::npos)
+      dest.insert(identifier);
+  }
+
+  forall_irep(it, irep.get_sub())
+    find_file_scope_identifiers(*it, dest);
+
+  forall_named_irep(it, irep.get_named_sub())
+    find_file_scope_identifiers(it->second, dest);
+}
+
+/// Does \p irep, code that has not been typechecked yet, contain a
+/// block-scope declaration of a file-scope symbol, i.e., of an `extern`
+/// variable or of a function? Such a declaration may change the type of the
+/// symbol.
+static bool declares_file_scope_symbol(const irept &irep)
+{
+  if(irep.id()==ID_declaration)
+  {
+    const ansi_c_declarationt &declaration=
+      static_cast<const ansi_c_declarationt &>(irep);
+
+    if(c_storage_spect(declaration.type()).is_extern)
+      return true;
+
+    for(const auto &declarator : declaration.declarators())
+    {
+      const typet type=declaration.full_type(declarator);
+      if(type.id()==ID_code || c_storage_spect(type).is_extern)
+        return true;
+    }
+  }
+
+  forall_irep(it, irep.get_sub())
+    if(declares_file_scope_symbol(*it))
+      return true;
+
+  return false;
+}
+
+/// Defer typechecking the code of the function \p symbol until all
+/// declarations have been typechecked, unless that could change its meaning:
+/// the code sees only the declarations that precede it, hence it is
+/// typechecked now if it uses a symbol that has not been declared yet, such
+/// as a function that is declared implicitly or later on. A later change to
+/// the declaration of a symbol it uses is handled by typecheck_symbol. Code
+/// that declares a file-scope symbol at block scope is typechecked now,
+/// after the deferred code, as the declaration may change such a symbol.
+/// \return true if the code has been deferred, false otherwise
+bool c_typecheck_baset::defer_function_body(const symbolt &symbol)
+{
+  std::unordered_set<irep_idt> uses;
+  find_file_scope_identifiers(symbol.value, uses);
+
+  std::unordered_set<irep_idt> renamed_uses;
+  for(const auto &identifier : uses)
+  {
+    asm_label_mapt::const_iterator entry=asm_label_map.find(identifier);
+    renamed_uses.insert(
+      entry==asm_label_map.end() ? identifier : entry->second);
+  }
+
+  bool defer=true;
+  for(const auto &identifier : renamed_uses)
+  {
+    if(!symbol_table.has_symbol(identifier))
+    {
+      defer=false;
+      break;
+    }
+  }
+
+  const bool declares=declares_file_scope_symbol(symbol.value);
+
+  if(!defer || declares)
+  {
+    // a redefinition replaces the body that has been deferred already
+    if(deferred_function_body_set.erase(symbol.name)!=0)
+      deferred_function_bodies.erase(
+        std::find(
+          deferred_function_bodies.begin(),
+          deferred_function_bodies.end(),
+          symbol.name));
+
+    if(declares)
+      typecheck_deferred_function_bodies_now();
+
+    return false;
+  }
+
+  deferred_function_body_uses.insert(
+    renamed_uses.begin(), renamed_uses.end());
+
+  if(deferred_function_body_set.insert(symbol.name).second)
+    deferred_function_bodies.push_back(symbol.name);
+
+  return true;
+}
+
+void c_typecheck_baset::typecheck_deferred_function_bodies()
+{
+  // all declarations have been typechecked, and the deferred code declares
+  // no file-scope symbols, hence nothing must be typechecked early anymore
+  std::vector<irep_idt> bodies;
+  bodies.swap(deferred_function_bodies);
+  deferred_function_body_set.clear();
+  deferred_function_body_uses.clear();
+
+#ifndef _WIN32
+  if(function_body_jobs>1 && bodies.size()>1)
+    typecheck_function_bodies_in_parallel(bodies);
+  else
+#endif
+  {
+    for(const auto &identifier : bodies)
+      typecheck_deferred_function_body(identifier);
+  }
+}
+
+/// Typecheck the deferred function bodies in this process, before the
+/// declaration of a symbol they use changes, or before code that may change
+/// such a declaration is typechecked. This happens between the typechecking
+/// of function bodies only.
+void c_typecheck_baset::typecheck_deferred_function_bodies_now()
+{
+  if(deferred_function_bodies.empty())
+    return;
+
+  const symbolt saved_symbol=current_symbol;
+  const typet saved_return_type=return_type;
+  const typet saved_switch_op_type=switch_op_type;
+  const std::map<irep_idt, source_locationt> saved_labels_defined=
+    labels_defined;
+  const std::map<irep_idt, source_locationt> saved_labels_used=labels_used;
+  const bool saved_break_is_allowed=break_is_allowed;
+  const bool saved_continue_is_allowed=continue_is_allowed;
+  const bool saved_case_is_allowed=case_is_allowed;
+
+  break_is_allowed=continue_is_allowed=case_is_allowed=false;
+
+  std::vector<irep_idt> bodies;
+  bodies.swap(deferred_function_bodies);
+  deferred_function_body_set.clear();
+  deferred_function_body_uses.clear();
+
+  for(const auto &identifier : bodies)
+    typecheck_deferred_function_body(identifier);
+
+  current_symbol=saved_symbol;
+  return_type=saved_return_type;
+  switch_op_type=saved_switch_op_type;
+  labels_defined=saved_labels_defined;
+  labels_used=saved_labels_used;
+  break_is_allowed=saved_break_is_allowed;
+  continue_is_allowed=saved_continue_is_allowed;
+  case_is_allowed=saved_case_is_allowed;
+}
+
+void c_typecheck_baset::typecheck_deferred_function_body(
+  const irep_idt &identifier)
+{
+  symbolt *symbol=symbol_table.get_writeable(identifier);
+  INVARIANT(symbol!=nullptr, "deferred function must be in symbol table");
+
+  current_symbol=*symbol;
+  typecheck_function_code(*symbol);
+}
+
+#ifndef _WIN32
+static bool same_symbol(const symbolt &a, const symbolt &b)
+{
+  return
+    a.type.full_eq(b.type) &&
+    a.value.full_eq(b.value) &&
+    a.location.full_eq(b.location) &&
+    a.module==b.module &&
+    a.base_name==b.base_name &&
+    a.mode==b.mode &&
+    a.pretty_name==b.pretty_name &&
+    a.is_type==b.is_type &&
+    a.is_macro==b.is_macro &&
+    a.is_exported==b.is_exported &&
+    a.is_input==b.is_input &&
+    a.is_output==b.is_output &&
+    a.is_state_var==b.is_state_var &&
+    a.is_property==b.is_property &&
+    a.is_static_lifetime==b.is_static_lifetime &&
+    a.is_thread_local==b.is_thread_local &&
+    a.is_lvalue==b.is_lvalue &&
+    a.is_file_local==b.is_file_local &&
+    a.is_extern==b.is_extern &&
+    a.is_volatile==b.is_volatile &&
+    a.is_parameter==b.is_parameter &&
+    a.is_auxiliary==b.is_auxiliary &&
+    a.is_weak==b.is_weak;
+}
+
+/// Typecheck the function \p bodies in up to `function_body_jobs` child
+/// processes. Once all declarations are in the symbol table, the bodies are
+/// largely independent: the symbols they introduce, such as local variables,
+/// are prefixed with the name of their function. Each child typechecks a
+/// contiguous range of the bodies, and writes the symbols it has added or
+/// changed to a file. These are merged in the order of the children,
+/// as is their buffered output, which keeps the messages in the order of the
+/// source file and makes the result independent of the scheduling.
+void c_typecheck_baset::typecheck_function_bodies_in_parallel(
+  const std::vector<irep_idt> &bodies)
+{
+  const std::size_t jobs=std::min(function_body_jobs, bodies.size());
+  const std::size_t chunk=(bodies.size()+jobs-1)/jobs;
+
+  std::vector<std::vector<irep_idt>> partition(jobs);
+  for(std::size_t i=0; i<bodies.size(); i++)
+    partition[i/chunk].push_back(bodies[i]);
+
+  temp_dirt tmp_dir("c-typecheck-XXXXXX");
+
+  statistics() << "Typechecking " << bodies.size()
+               << " function bodies using " << jobs << " processes" << eom;
+
+  // the children determine their changes by comparing with this copy, which
+  // shares all ireps with the symbol table
+  const symbol_tablet before=symbol_table;
+
+  const std::vector<int> status=run_in_child_processes(
+    jobs,
+    jobs,
+    tmp_dir.path,
+    get_message_handler(),
+    [this, &partition, &tmp_dir, &before](std::size_t job) {
+      const unsigned errors_before=
+        get_message_handler().get_message_count(M_ERROR);
+
+      for(const auto &identifier : partition[job])
+        typecheck_deferred_function_body(identifier);
+
+      symbol_tablet changed;
+      for(const auto &symbol_pair : symbol_table.symbols)
+      {
+        const symbol_tablet::symbolst::const_iterator old_it=
+          before.symbols.find(symbol_pair.first);
+
+        if(old_it==before.symbols.end() ||
+           !same_symbol(old_it->second, symbol_pair.second))
+          changed.add(symbol_pair.second);
+      }
+
+      std::ofstream out(
+        tmp_dir(std::to_string(job)+".symbols"), std::ios::binary);
+      write_bin_symbol_table(out, changed);
+      out.close();
+
+      return
+        get_message_handler().get_message_count(M_ERROR)!=errors_before ||
+        !out ? 1 : 0;
+    });
+
+  for(std::size_t job=0; job<jobs; job++)
+  {
+    if(status[job]<0)
+    {
+      // typecheck the bodies of this job in this process instead
+      for(const auto &identifier : partition[job])
+        typecheck_deferred_function_body(identifier);
+      partition[job].clear();
+    }
+  }
+
+  bool failed=false;
+
+  for(std::size_t job=0; job<jobs; job++)
+  {
+    if(partition[job].empty())
+      continue;
+
+    replay_child_output(tmp_dir.path, job);
+
+    symbol_tablet changed;
+    std::ifstream in(
+      tmp_dir(std::to_string(job)+".symbols"), std::ios::binary);
+
+    if(status[job]!=0 || !in || read_bin_symbol_table(in, changed))
+    {
+      failed=true;
+      continue;
+    }
+
+    for(const auto &symbol_pair : changed.symbols)
+    {
+      const symbol_tablet::symbolst::const_iterator s_it=
+        symbol_table.symbols.find(symbol_pair.first);
+
+      if(s_it!=symbol_table.symbols.end())
+      {
+        // as when typechecking serially, the first body to add a symbol
+        // determines it
+        if(!before.has_symbol(symbol_pair.first))
+          continue;
+
+        symbol_table.erase(s_it);
+      }
+
+      symbol_table.add(symbol_pair.second);
+    }
+  }
+
+  if(failed)
+  {
+    // the children's errors are not counted by our message handler
+    error() << "failed to typecheck function bodies in parallel" << eom;
+    throw 0;
+  }
+}
+#endif
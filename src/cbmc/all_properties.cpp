@@ -51,6 +51,11 @@ void bmc_all_propertiest::goal_covered(const cover_goalst::goalt &)
   }
 }
 
+bool bmc_all_propertiest::refine_assignment()
+{
+  return bmc.refine_memory_model(solver);
+}
+
 safety_checkert::resultt bmc_all_propertiest::operator()()
 {
   status() << "Passing problem to " << solver.decision_procedure_text() << eom;
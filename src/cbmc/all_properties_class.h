@@ -32,6 +32,7 @@ public:
   safety_checkert::resultt operator()();
 
   virtual void goal_covered(const cover_goalst::goalt &);
+  virtual bool refine_assignment();
 
   struct goalt
   {
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iostream>
 
 #include <util/exit_codes.h>
+#include <util/make_unique.h>
 
 #include <langapi/language_util.h>
 
@@ -29,6 +30,9 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <linking/static_lifetime_init.h>
 
+#include "bmc_auto_unwind.h"
+#include "bmc_incremental.h"
+#include "bmc_k_induction.h"
 #include "cbmc_solvers.h"
 #include "counterexample_beautification.h"
 #include "fault_localization.h"
@@ -113,6 +117,10 @@ void bmct::do_conversion()
 {
   status() << "converting SSA" << eom;
 
+  // a lazily encoded memory model adds constraints after solving
+  if(equation.has_threads() && memory_model->is_lazy())
+    prop_conv.set_all_frozen();
+
   // convert SSA
   equation.convert(prop_conv);
 
@@ -134,7 +142,7 @@ bmct::run_decision_procedure(prop_convt &prop_conv)
 
   status() << "Running " << prop_conv.decision_procedure_text() << eom;
 
-  decision_proceduret::resultt dec_result=prop_conv.dec_solve();
+  decision_proceduret::resultt dec_result=solve(prop_conv);
 
   {
     auto solver_stop = std::chrono::steady_clock::now();
@@ -146,6 +154,24 @@ bmct::run_decision_procedure(prop_convt &prop_conv)
   return dec_result;
 }
 
+bool bmct::refine_memory_model(prop_convt &prop_conv)
+{
+  return equation.has_threads() && memory_model->refine(prop_conv);
+}
+
+decision_proceduret::resultt bmct::solve(prop_convt &prop_conv)
+{
+  decision_proceduret::resultt dec_result=prop_conv.dec_solve();
+
+  while(dec_result==decision_proceduret::resultt::D_SATISFIABLE &&
+        refine_memory_model(prop_conv))
+  {
+    dec_result=prop_conv.dec_solve();
+  }
+
+  return dec_result;
+}
+
 void bmct::report_success()
 {
   result() << "VERIFICATION SUCCESSFUL" << eom;
@@ -288,8 +314,29 @@ void bmct::get_memory_model()
 {
   const std::string mm=options.get_option("mm");
 
+  if(options.get_bool_option("lazy-mm") && !mm.empty() && mm!="sc")
+  {
+    error() << "--lazy-mm is only supported with --mm sc" << eom;
+    throw "invalid memory model";
+  }
+
   if(mm.empty() || mm=="sc")
-    memory_model=util_make_unique<memory_model_sct>(ns);
+  {
+    auto memory_model_sc=util_make_unique<memory_model_sct>(ns);
+
+    // fault localization solves through prop_minimizet, which does not
+    // refine the lazy encoding
+    if(options.get_bool_option("lazy-mm"))
+    {
+      if(options.get_option("localize-faults").empty())
+        memory_model_sc->set_lazy(true);
+      else
+        warning() << "--lazy-mm does not support --localize-faults, "
+                  << "adding all memory model constraints" << eom;
+    }
+
+    memory_model=std::move(memory_model_sc);
+  }
   else if(mm=="tso")
     memory_model=util_make_unique<memory_model_tsot>(ns);
   else if(mm=="pso")
@@ -319,6 +366,12 @@ void bmct::setup()
 
   symex.unwindset.parse_unwind(options.get_option("unwind"));
   symex.unwindset.parse_unwindset(options.get_option("unwindset"));
+
+  // bmc_auto_unwindt finds the bounds of loops, but recursions are unwound
+  // up to the limit at once
+  if(!options.get_option("auto-unwind").empty() &&
+     options.get_option("unwind").empty())
+    symex.unwindset.parse_unwind(options.get_option("auto-unwind"));
 }
 
 safety_checkert::resultt bmct::execute(
@@ -578,6 +631,8 @@ int bmct::do_language_agnostic_bmc(
     path_strategy_chooser.is_valid_strategy(strategy),
     "Front-end passed us invalid path strategy '" + strategy + "'");
   worklist = path_strategy_chooser.get(strategy);
+  // with a lazy model, only the functions loaded so far are analysed
+  worklist->set_program(model.get_goto_functions());
   try
   {
     {
@@ -586,11 +641,33 @@ int bmct::do_language_agnostic_bmc(
       std::unique_ptr<cbmc_solverst::solvert> cbmc_solver;
       cbmc_solver = solvers.get_solver();
       prop_convt &pc = cbmc_solver->prop_conv();
-      bmct bmc(opts, symbol_table, mh, pc, *worklist, callback_after_symex);
-      bmc.set_ui(ui);
+      std::unique_ptr<cbmc_solverst::solvert> step_solver;
+      std::unique_ptr<bmct> bmc;
+      if(!opts.get_option("k-induction").empty())
+      {
+        step_solver = solvers.get_solver();
+        bmc = util_make_unique<bmc_k_inductiont>(
+          opts,
+          symbol_table,
+          mh,
+          pc,
+          step_solver->prop_conv(),
+          *worklist,
+          callback_after_symex);
+      }
+      else if(!opts.get_option("auto-unwind").empty())
+        bmc = util_make_unique<bmc_auto_unwindt>(
+          opts, symbol_table, mh, pc, *worklist, callback_after_symex);
+      else if(opts.get_bool_option("incremental"))
+        bmc = util_make_unique<bmc_incrementalt>(
+          opts, symbol_table, mh, pc, *worklist, callback_after_symex);
+      else
+        bmc = util_make_unique<bmct>(
+          opts, symbol_table, mh, pc, *worklist, callback_after_symex);
+      bmc->set_ui(ui);
       if(driver_configure_bmc)
-        driver_configure_bmc(bmc, symbol_table);
-      tmp_result = bmc.run(model);
+        driver_configure_bmc(*bmc, symbol_table);
+      tmp_result = bmc->run(model);
       if(tmp_result != safety_checkert::resultt::PAUSED)
         final_result = tmp_result;
     }
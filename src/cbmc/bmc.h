@@ -91,7 +91,7 @@ public:
     wrapper_goto_modelt model(outer_symbol_table, goto_functions);
     return run(model);
   }
-  resultt run(abstract_goto_modelt &);
+  virtual resultt run(abstract_goto_modelt &);
   void setup();
   safety_checkert::resultt execute(abstract_goto_modelt &);
   virtual ~bmct() { }
@@ -116,6 +116,14 @@ public:
     symex.add_recursion_unwind_handler(handler);
   }
 
+  /// Encode accesses to \p objects without events for the memory model,
+  /// see \ref goto_symext::thread_independent_objects
+  void set_thread_independent_objects(
+    const std::unordered_set<irep_idt> &objects)
+  {
+    symex.thread_independent_objects=objects;
+  }
+
   static int do_language_agnostic_bmc(
     const path_strategy_choosert &path_strategy_chooser,
     const optionst &opts,
@@ -185,6 +193,15 @@ protected:
 
   void do_conversion();
 
+  /// Add the constraints that a lazily encoded memory model has left out and
+  /// that the satisfying assignment of \p prop_conv violates
+  /// \return true if the formula needs to be solved again
+  bool refine_memory_model(prop_convt &prop_conv);
+
+  /// Solve \p prop_conv, refining a lazily encoded memory model until the
+  /// satisfying assignment is consistent with it
+  decision_proceduret::resultt solve(prop_convt &prop_conv);
+
   virtual void freeze_program_variables();
 
   virtual void show_vcc();
@@ -298,6 +315,14 @@ private:
   "(depth):"                                                                   \
   "(unwind):"                                                                  \
   "(unwindset):"                                                               \
+  "(auto-unwind):"                                                             \
+  "(incremental)"                                                              \
+  "(unwind-min):"                                                              \
+  "(unwind-max):"                                                              \
+  "(stop-when-unsat)"                                                          \
+  "(magic-numbers)"                                                            \
+  "(k-induction):"                                                             \
+  "(k-induction-invariants)"                                                   \
   "(graphml-witness):"                                                         \
   "(unwindset):"
 
@@ -310,6 +335,22 @@ private:
   " --unwind nr                  unwind nr times\n"                            \
   " --unwindset L:B,...          unwind loop L with a bound of B\n"            \
   "                              (use --show-loops to get the loop IDs)\n"     \
+  " --auto-unwind max            raise the bounds of loops and recursions\n"   \
+  "                              up to max until their unwinding\n"            \
+  "                              assertions hold\n"                            \
+  " --incremental                unwind loops one iteration at a time and\n"   \
+  "                              check the properties after each\n"            \
+  " --unwind-min nr              start with nr iterations (--incremental)\n"   \
+  " --unwind-max nr              stop after nr iterations (--incremental)\n"   \
+  " --stop-when-unsat            stop at the first bound at which the\n"       \
+  "                              assertions it adds cannot fail, even if\n"    \
+  "                              earlier ones can (--incremental)\n"           \
+  " --magic-numbers              raise bounds to the next constant of the\n"   \
+  "                              program, not by one (--incremental)\n"        \
+  " --k-induction max            prove the properties by k-induction for\n"    \
+  "                              k up to max\n"                                \
+  " --k-induction-invariants     assume the intervals of the variables at\n"   \
+  "                              loop heads in the step case\n"                \
   " --show-vcc                   show the verification conditions\n"           \
   " --slice-formula              remove assignments unrelated to property\n"   \
   " --unwinding-assertions       generate unwinding assertions (cannot be\n"   \
@@ -0,0 +1,63 @@
+/*******************************************************************\
+
+Module: Automatic Discovery of Unwinding Bounds
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Automatic Discovery of Unwinding Bounds
+
+#include "bmc_auto_unwind.h"
+
+#include <algorithm>
+
+bmc_auto_unwindt::bmc_auto_unwindt(
+  const optionst &_options,
+  const symbol_tablet &outer_symbol_table,
+  message_handlert &_message_handler,
+  prop_convt &_prop_conv,
+  path_storaget &_path_storage,
+  std::function<bool(void)> callback_after_symex):
+  bmc_incrementalt(
+    _options,
+    outer_symbol_table,
+    _message_handler,
+    _prop_conv,
+    _path_storage,
+    callback_after_symex)
+{
+  unwind_max=options.get_unsigned_int_option("auto-unwind");
+
+  initial_bounds.parse_unwind(options.get_option("unwind"));
+  initial_bounds.parse_unwindset(options.get_option("unwindset"));
+}
+
+unsigned bmc_auto_unwindt::loop_bound(const irep_idt &loop)
+{
+  const auto entry=loop_bounds.find(loop);
+  if(entry!=loop_bounds.end())
+    return entry->second;
+
+  // threads are not supported by incremental unwinding
+  const auto limit=initial_bounds.get_limit(loop, 0);
+  const unsigned bound=
+    limit.has_value() ? std::min(*limit, unwind_max) : 1;
+
+  loop_bounds[loop]=bound;
+  return bound;
+}
+
+void bmc_auto_unwindt::raise_loop_bound(const irep_idt &loop, unsigned bound)
+{
+  status() << "Unwinding assertion of " << loop << " fails, raising its bound"
+           << " to " << bound << eom;
+
+  bmc_incrementalt::raise_loop_bound(loop, bound);
+}
+
+unsigned bmc_auto_unwindt::next_bound(unsigned unwind)
+{
+  return unwind>unwind_max/2 ? unwind_max : std::max(2*unwind, 1u);
+}
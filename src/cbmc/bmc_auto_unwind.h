@@ -0,0 +1,54 @@
+/*******************************************************************\
+
+Module: Automatic Discovery of Unwinding Bounds
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Automatic Discovery of Unwinding Bounds
+
+#ifndef CPROVER_CBMC_BMC_AUTO_UNWIND_H
+#define CPROVER_CBMC_BMC_AUTO_UNWIND_H
+
+#include <goto-instrument/unwindset.h>
+
+#include "bmc_incremental.h"
+
+/// \brief Iterative deepening of the bounds of the loops whose unwinding
+/// assertions fail
+///
+/// This is the incremental bounded model checking of bmc_incrementalt with
+/// a different policy for the bounds. Each loop starts with the bound given
+/// by `--unwind` or `--unwindset`, or 1. When the bound of a loop is
+/// exceeded and the loop can be iterated again, i.e., its unwinding
+/// assertion fails, the bound is doubled, up to the limit given by
+/// `--auto-unwind`, and symbolic execution resumes from the checkpoint at
+/// the loop, in the same solver. The bounds of loops whose unwinding
+/// assertions hold are kept. A property that fails within the bounds found
+/// so far ends the search.
+///
+/// Symbolic execution cannot be resumed within a recursion, hence recursive
+/// functions are unwound up to the limit at once, unless given a bound.
+class bmc_auto_unwindt:public bmc_incrementalt
+{
+public:
+  bmc_auto_unwindt(
+    const optionst &_options,
+    const symbol_tablet &outer_symbol_table,
+    message_handlert &_message_handler,
+    prop_convt &_prop_conv,
+    path_storaget &_path_storage,
+    std::function<bool(void)> callback_after_symex);
+
+protected:
+  /// the bounds given by `--unwind` and `--unwindset`
+  unwindsett initial_bounds;
+
+  unsigned loop_bound(const irep_idt &) override;
+  void raise_loop_bound(const irep_idt &, unsigned bound) override;
+  unsigned next_bound(unsigned unwind) override;
+};
+
+#endif // CPROVER_CBMC_BMC_AUTO_UNWIND_H
@@ -48,6 +48,11 @@ public:
   // gets called by prop_covert
   virtual void satisfying_assignment();
 
+  virtual bool refine_assignment()
+  {
+    return bmc.refine_memory_model(solver);
+  }
+
   struct goalt
   {
     // a criterion is satisfied if _any_ instance is true
@@ -0,0 +1,341 @@
+/*******************************************************************\
+
+Module: Incremental Bounded Model Checking
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Incremental Bounded Model Checking
+
+#include "bmc_incremental.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <util/arith_tools.h>
+#include <util/std_expr.h>
+
+#include <solvers/prop/literal_expr.h>
+#include <solvers/prop/prop_conv.h>
+
+bmc_incrementalt::bmc_incrementalt(
+  const optionst &_options,
+  const symbol_tablet &outer_symbol_table,
+  message_handlert &_message_handler,
+  prop_convt &_prop_conv,
+  path_storaget &_path_storage,
+  std::function<bool(void)> callback_after_symex):
+  bmct(
+    _options,
+    outer_symbol_table,
+    _message_handler,
+    _prop_conv,
+    _path_storage,
+    callback_after_symex),
+  unwind_min(std::max(options.get_unsigned_int_option("unwind-min"), 1u)),
+  unwind_max(options.get_unsigned_int_option("unwind-max")),
+  activations(0),
+  converted_steps(0),
+  checked_steps(0),
+  assumption(const_literal(true)),
+  bound_reached(false),
+  stop_when_unsat(options.get_bool_option("stop-when-unsat")),
+  use_magic_numbers(options.get_bool_option("magic-numbers"))
+{
+  symex.save_loop_checkpoints=true;
+
+  add_loop_unwind_handler(
+    [this](
+      const irep_idt &function,
+      unsigned loop_number,
+      unsigned unwind,
+      unsigned &max_unwind)
+    {
+      if(unwind_max>0)
+        max_unwind=unwind_max;
+
+      const irep_idt id=id2string(function)+"."+std::to_string(loop_number);
+
+      return tvt(unwind>=loop_bound(id));
+    });
+}
+
+unsigned bmc_incrementalt::loop_bound(const irep_idt &loop)
+{
+  return loop_bounds.insert({loop, unwind_min}).first->second;
+}
+
+void bmc_incrementalt::raise_loop_bound(const irep_idt &loop, unsigned bound)
+{
+  loop_bounds[loop]=bound;
+}
+
+/// Add the positive constants in \p expr that fit an unsigned to \p dest
+static void collect_constants(const exprt &expr, std::set<unsigned> &dest)
+{
+  mp_integer value;
+  if(expr.is_constant() &&
+     (expr.type().id()==ID_signedbv || expr.type().id()==ID_unsignedbv) &&
+     !to_integer(expr, value) &&
+     value>0 &&
+     value<=std::numeric_limits<unsigned>::max())
+  {
+    dest.insert(integer2unsigned(value));
+  }
+
+  forall_operands(it, expr)
+    collect_constants(*it, dest);
+}
+
+unsigned bmc_incrementalt::next_bound(unsigned unwind)
+{
+  if(!use_magic_numbers)
+    return unwind+1;
+
+  // the steps include those of the code after the loop, whose constants
+  // are the likely bounds of later executions of the loop
+  for(const auto &step : equation.SSA_steps)
+  {
+    collect_constants(step.cond_expr, magic_numbers);
+    collect_constants(step.ssa_rhs, magic_numbers);
+  }
+
+  const std::set<unsigned>::const_iterator next=
+    magic_numbers.upper_bound(unwind);
+  if(next==magic_numbers.end())
+    return unwind+1;
+
+  return unwind_max!=0 ? std::min(*next, unwind_max) : *next;
+}
+
+bool bmc_incrementalt::property_fails(
+  std::size_t suffix,
+  literalt activation)
+{
+  exprt::operandst failures;
+
+  std::size_t n=0;
+  for(const auto &step : equation.SSA_steps)
+  {
+    // the unwinding assertions of the loops left early are only checked
+    // once the loops are left for good
+    if(n>=checked_steps &&
+       step.is_assert() &&
+       (n<suffix || symex_bmct::unwinding_assertion_id(step).empty()))
+      failures.push_back(literal_exprt(!step.cond_literal));
+
+    ++n;
+  }
+
+  const literalt fails=prop_conv.convert(disjunction(failures));
+  if(fails.is_false())
+    return false;
+
+  bvt assumptions;
+  if(!fails.is_constant())
+    assumptions.push_back(fails);
+  if(!activation.is_true())
+    assumptions.push_back(activation);
+  prop_conv.set_assumptions(assumptions);
+
+  status() << "Running " << prop_conv.decision_procedure_text() << eom;
+
+  switch(prop_conv.dec_solve())
+  {
+  case decision_proceduret::resultt::D_SATISFIABLE:
+    return true;
+
+  case decision_proceduret::resultt::D_UNSATISFIABLE:
+    prop_conv.set_assumptions(bvt());
+    return false;
+
+  case decision_proceduret::resultt::D_ERROR:
+    break;
+  }
+
+  throw "decision procedure failed";
+}
+
+safety_checkert::resultt bmc_incrementalt::report(resultt result)
+{
+  if(result==resultt::UNSAFE)
+  {
+    if(options.get_bool_option("trace"))
+    {
+      error_trace();
+      output_graphml(result);
+    }
+
+    report_failure();
+  }
+  else
+  {
+    report_success();
+    output_graphml(result);
+  }
+
+  return result;
+}
+
+safety_checkert::resultt bmc_incrementalt::run(
+  abstract_goto_modelt &goto_model)
+{
+  setup();
+
+  auto get_goto_function = [&goto_model](const irep_idt &id) ->
+    const goto_functionst::goto_functiont &
+  {
+    return goto_model.get_goto_function(id);
+  };
+
+  try
+  {
+    prop_conv.set_message_handler(get_message_handler());
+
+    // the steps of later iterations refer to those converted before
+    prop_conv.set_all_frozen();
+
+    symex.symex_from_entry_point_of(get_goto_function, symex_symbol_table);
+
+    while(symex.loop_checkpoint)
+    {
+      if(equation.has_threads())
+        throw "--incremental does not support threads";
+
+      const std::unique_ptr<symex_bmct::loop_checkpointt> checkpoint=
+        std::move(symex.loop_checkpoint);
+
+      status() << "Checking loop " << checkpoint->loop_id << " with "
+               << checkpoint->unwind << " iteration(s)" << eom;
+
+      const auto first=equation.SSA_steps.begin();
+      const auto suffix=std::next(first, checkpoint->steps);
+
+      // the steps before the checkpoint are kept
+      equation.convert_incrementally(
+        prop_conv,
+        std::next(first, converted_steps),
+        suffix,
+        const_literal(true),
+        assumption);
+      converted_steps=checkpoint->steps;
+
+      // those after it are retracted unless a property fails
+      const literalt activation=prop_conv.convert(
+        symbol_exprt(
+          "bmc_incremental::activation_"+std::to_string(activations++),
+          bool_typet()));
+      literalt suffix_assumption=assumption;
+      equation.convert_incrementally(
+        prop_conv,
+        suffix,
+        equation.SSA_steps.end(),
+        activation,
+        suffix_assumption);
+
+      const bool fails=property_fails(checkpoint->steps, activation);
+
+      if(fails && !stop_when_unsat)
+        return report(resultt::UNSAFE);
+
+      if(!fails && stop_when_unsat)
+      {
+        status() << "No assertion added within " << checkpoint->unwind
+                 << " iteration(s) of loop " << checkpoint->loop_id
+                 << " can fail" << eom;
+        return report(resultt::SAFE);
+      }
+
+      if(fails)
+      {
+        // the assertions that fail are not checked again
+        status() << "An assertion fails within " << checkpoint->unwind
+                 << " iteration(s) of loop " << checkpoint->loop_id
+                 << ", unwinding further" << eom;
+        prop_conv.set_assumptions(bvt());
+      }
+
+      checked_steps=checkpoint->steps;
+
+      // does another iteration of the loop exist?
+      bool iterate=false;
+      const literalt continuation=prop_conv.convert(checkpoint->continuation);
+      const bool capped=
+        !continuation.is_false() &&
+        unwind_max!=0 &&
+        checkpoint->unwind>=unwind_max;
+
+      if(!continuation.is_false() && !capped)
+      {
+        bvt assumptions;
+        if(!continuation.is_constant())
+          assumptions.push_back(continuation);
+        prop_conv.set_assumptions(assumptions);
+
+        const decision_proceduret::resultt result=prop_conv.dec_solve();
+        if(result==decision_proceduret::resultt::D_ERROR)
+          throw "decision procedure failed";
+
+        iterate=result==decision_proceduret::resultt::D_SATISFIABLE;
+        prop_conv.set_assumptions(bvt());
+      }
+
+      if((iterate || capped) && proved(*checkpoint))
+        return report(resultt::SAFE);
+
+      bound_reached|=capped;
+
+      prop_conv.set_to_false(literal_exprt(activation));
+      equation.SSA_steps.erase(suffix, equation.SSA_steps.end());
+
+      if(iterate)
+        raise_loop_bound(
+          checkpoint->loop_id, next_bound(checkpoint->unwind));
+      else
+        symex.skip_next_loop_checkpoint=true;
+
+      symex.resume_symex_from_saved_state(
+        get_goto_function, checkpoint->state, &equation, symex_symbol_table);
+    }
+
+    if(equation.has_threads())
+      throw "--incremental does not support threads";
+
+    // the whole program has been executed
+    equation.convert_incrementally(
+      prop_conv,
+      std::next(equation.SSA_steps.begin(), converted_steps),
+      equation.SSA_steps.end(),
+      const_literal(true),
+      assumption);
+    converted_steps=equation.SSA_steps.size();
+
+    return report(
+      property_fails(converted_steps, const_literal(true)) ?
+        resultt::UNSAFE : resultt::SAFE);
+  }
+
+  catch(const std::string &error_str)
+  {
+    error().source_location=symex.last_source_location;
+    error() << error_str << eom;
+
+    return resultt::ERROR;
+  }
+
+  catch(const char *error_str)
+  {
+    error().source_location=symex.last_source_location;
+    error() << error_str << eom;
+
+    return resultt::ERROR;
+  }
+
+  catch(const std::bad_alloc &)
+  {
+    error() << "Out of memory" << eom;
+    return resultt::ERROR;
+  }
+}
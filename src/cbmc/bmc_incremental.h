@@ -0,0 +1,96 @@
+/*******************************************************************\
+
+Module: Incremental Bounded Model Checking
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Incremental Bounded Model Checking
+
+#ifndef CPROVER_CBMC_BMC_INCREMENTAL_H
+#define CPROVER_CBMC_BMC_INCREMENTAL_H
+
+#include <map>
+#include <set>
+
+#include "bmc.h"
+
+/// \brief Bounded model checking that unwinds loops one iteration at a time
+///
+/// Symbolic execution proceeds until the bound of a loop is exceeded, where
+/// symex_bmct saves a checkpoint of its state, and then leaves the loop to
+/// run to the end of the program. The steps up to the checkpoint are added
+/// to the solver for good, those after it only under an activation literal.
+/// If no property fails and the loop can be iterated again, the steps after
+/// the checkpoint are retracted, and execution resumes from the checkpoint
+/// with the bound raised by one. Checking a further iteration thus costs
+/// one more iteration and the code after the loop, rather than a new run of
+/// symbolic execution and a new formula.
+class bmc_incrementalt:public bmct
+{
+public:
+  bmc_incrementalt(
+    const optionst &_options,
+    const symbol_tablet &outer_symbol_table,
+    message_handlert &_message_handler,
+    prop_convt &_prop_conv,
+    path_storaget &_path_storage,
+    std::function<bool(void)> callback_after_symex);
+
+  using bmct::run;
+  resultt run(abstract_goto_modelt &) override;
+
+protected:
+  /// the bounds of the loops, by loop id
+  std::map<irep_idt, unsigned> loop_bounds;
+  unsigned unwind_min;
+  /// the maximum bound, or zero if unwinding is not limited
+  unsigned unwind_max;
+
+  /// the activation literals created so far
+  std::size_t activations;
+
+  /// the steps of the equation converted for good
+  std::size_t converted_steps;
+  /// the steps whose assertions are known not to fail
+  std::size_t checked_steps;
+  /// the assumptions of the steps converted for good
+  literalt assumption;
+  /// a loop was left at `unwind_max` although it could be iterated again
+  bool bound_reached;
+  /// end unwinding at the first bound at which no new assertion fails
+  bool stop_when_unsat;
+  /// raise bounds to the next of `magic_numbers` rather than by one
+  bool use_magic_numbers;
+  /// the constants of the equation, which are candidates for loop bounds
+  std::set<unsigned> magic_numbers;
+
+  /// \return the bound of \p loop, which is `unwind_min` until raised
+  virtual unsigned loop_bound(const irep_idt &loop);
+  virtual void raise_loop_bound(const irep_idt &loop, unsigned bound);
+
+  /// \return the bound that a loop that can be iterated after \p unwind
+  ///   iterations is raised to: \p unwind plus one, or with
+  ///   `--magic-numbers` the smallest constant of the equation above it
+  virtual unsigned next_bound(unsigned unwind);
+
+  /// Called once no property fails with the loop of the checkpoint iterated
+  /// up to its bound, while further iterations remain
+  /// \return true if the properties are proved to hold regardless, which
+  ///   ends unwinding
+  virtual bool proved(const symex_bmct::loop_checkpointt &)
+  {
+    return false;
+  }
+
+  /// \return true if an assertion in the steps from `checked_steps` to
+  ///   \p suffix can fail, or one after it that is not an unwinding
+  ///   assertion, given \p activation
+  bool property_fails(std::size_t suffix, literalt activation);
+
+  virtual resultt report(resultt);
+};
+
+#endif // CPROVER_CBMC_BMC_INCREMENTAL_H
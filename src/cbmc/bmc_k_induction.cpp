@@ -0,0 +1,269 @@
+/*******************************************************************\
+
+Module: k-Induction
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// k-Induction
+
+#include "bmc_k_induction.h"
+
+#include <util/std_expr.h>
+
+#include <analyses/ai.h>
+#include <analyses/dirty.h>
+#include <analyses/interval_domain.h>
+#include <analyses/local_may_alias.h>
+#include <analyses/natural_loops.h>
+
+#include <goto-instrument/k_induction.h>
+#include <goto-instrument/loop_utils.h>
+
+#include <goto-symex/path_storage.h>
+
+#include <solvers/prop/literal_expr.h>
+#include <solvers/prop/prop_conv.h>
+
+namespace
+{
+/// Symbolic execution of the step case, whose formula is added to the
+/// solver under an activation literal
+class step_caset:public bmct
+{
+public:
+  step_caset(
+    const optionst &_options,
+    const symbol_tablet &outer_symbol_table,
+    message_handlert &_message_handler,
+    prop_convt &_prop_conv,
+    path_storaget &_path_storage):
+    bmct(
+      _options,
+      outer_symbol_table,
+      _message_handler,
+      _prop_conv,
+      _path_storage,
+      nullptr)
+  {
+  }
+
+  /// \return true if no assertion of \p goto_model can fail, given
+  ///   \p activation
+  bool holds(abstract_goto_modelt &goto_model, literalt activation);
+};
+}
+
+bool step_caset::holds(
+  abstract_goto_modelt &goto_model,
+  literalt activation)
+{
+  setup();
+
+  auto get_goto_function = [&goto_model](const irep_idt &id) ->
+    const goto_functionst::goto_functiont &
+  {
+    return goto_model.get_goto_function(id);
+  };
+
+  symex.symex_from_entry_point_of(get_goto_function, symex_symbol_table);
+
+  if(equation.has_threads())
+    throw "--k-induction does not support threads";
+
+  slice();
+
+  literalt assumption=const_literal(true);
+  equation.convert_incrementally(
+    prop_conv,
+    equation.SSA_steps.begin(),
+    equation.SSA_steps.end(),
+    activation,
+    assumption);
+
+  exprt::operandst failures;
+  for(const auto &step : equation.SSA_steps)
+    if(step.is_assert())
+      failures.push_back(literal_exprt(!step.cond_literal));
+
+  const literalt fails=prop_conv.convert(disjunction(failures));
+  if(fails.is_false())
+    return true;
+
+  bvt assumptions;
+  if(!fails.is_constant())
+    assumptions.push_back(fails);
+  assumptions.push_back(activation);
+  prop_conv.set_assumptions(assumptions);
+
+  status() << "Running " << prop_conv.decision_procedure_text() << eom;
+
+  const decision_proceduret::resultt result=prop_conv.dec_solve();
+  prop_conv.set_assumptions(bvt());
+
+  if(result==decision_proceduret::resultt::D_ERROR)
+    throw "decision procedure failed";
+
+  return result==decision_proceduret::resultt::D_UNSATISFIABLE;
+}
+
+bmc_k_inductiont::bmc_k_inductiont(
+  const optionst &_options,
+  const symbol_tablet &outer_symbol_table,
+  message_handlert &_message_handler,
+  prop_convt &_prop_conv,
+  prop_convt &_step_prop_conv,
+  path_storaget &_path_storage,
+  std::function<bool(void)> callback_after_symex):
+  bmc_incrementalt(
+    _options,
+    outer_symbol_table,
+    _message_handler,
+    _prop_conv,
+    _path_storage,
+    callback_after_symex),
+  step_prop_conv(_step_prop_conv),
+  k(unwind_min),
+  step_k(0)
+{
+  unwind_max=options.get_unsigned_int_option("k-induction");
+}
+
+unsigned bmc_k_inductiont::loop_bound(const irep_idt &)
+{
+  return k;
+}
+
+void bmc_k_inductiont::raise_loop_bound(const irep_idt &, unsigned bound)
+{
+  k=bound;
+}
+
+bool bmc_k_inductiont::proved(const symex_bmct::loop_checkpointt &)
+{
+  // the step case for this k may have been checked at another loop
+  if(k<=step_k)
+    return false;
+
+  step_k=k;
+
+  status() << "Checking the step case with k=" << k << eom;
+
+  goto_modelt step_case;
+  step_case.symbol_table=step_model.symbol_table;
+  step_case.goto_functions.copy_from(step_model.goto_functions);
+  k_induction(step_case, false, true, k);
+  step_case.goto_functions.update();
+
+  const literalt activation=step_prop_conv.convert(
+    symbol_exprt(
+      "bmc_k_induction::activation_"+std::to_string(k),
+      bool_typet()));
+
+  path_lifot step_path_storage;
+  step_caset step(
+    options,
+    step_case.symbol_table,
+    get_message_handler(),
+    step_prop_conv,
+    step_path_storage);
+  step.set_ui(ui);
+
+  const bool holds=step.holds(step_case, activation);
+
+  step_prop_conv.set_to_false(literal_exprt(activation));
+
+  if(holds)
+    status() << "The step case holds for k=" << k << eom;
+
+  return holds;
+}
+
+safety_checkert::resultt bmc_k_inductiont::report(resultt verdict)
+{
+  // the properties hold up to the bound, but no step case holds
+  if(verdict==resultt::SAFE && bound_reached)
+  {
+    warning() << "No step case holds for k up to " << unwind_max << eom;
+    result() << "VERIFICATION INCONCLUSIVE" << eom;
+    return resultt::UNKNOWN;
+  }
+
+  return bmc_incrementalt::report(verdict);
+}
+
+void bmc_k_inductiont::add_invariants()
+{
+  ait<interval_domaint> interval_analysis;
+  interval_analysis(step_model);
+
+  // the interval domain does not track writes through pointers, so its
+  // intervals of variables whose address is taken are unsound
+  const dirtyt dirty(step_model.goto_functions);
+
+  Forall_goto_functions(f_it, step_model.goto_functions)
+  {
+    goto_programt &body=f_it->second.body;
+    local_may_aliast local_may_alias(f_it->second);
+    natural_loops_mutablet natural_loops(body);
+
+    // adding the assumptions changes the loops, they are added once all
+    // invariants are known
+    std::vector<std::pair<goto_programt::targett, exprt>> invariants;
+
+    for(const auto &loop : natural_loops.loop_map)
+    {
+      modifiest modifies;
+      get_modifies(local_may_alias, loop.second, modifies);
+
+      const interval_domaint &domain=interval_analysis[loop.first];
+
+      exprt::operandst bounds;
+      for(const auto &expr : modifies)
+      {
+        if(expr.id()!=ID_symbol || dirty(to_symbol_expr(expr)))
+          continue;
+
+        const exprt bound=domain.make_expression(to_symbol_expr(expr));
+        if(!bound.is_true())
+          bounds.push_back(bound);
+      }
+
+      if(!bounds.empty())
+        invariants.push_back({loop.first, conjunction(bounds)});
+    }
+
+    // after the heads, which remain the targets of the back edges and
+    // before which the step case havocs the modified variables
+    for(const auto &invariant : invariants)
+    {
+      goto_programt::targett t=body.insert_after(invariant.first);
+      t->make_assumption(invariant.second);
+      t->source_location=invariant.first->source_location;
+      t->function=invariant.first->function;
+    }
+  }
+
+  step_model.goto_functions.update();
+}
+
+safety_checkert::resultt bmc_k_inductiont::run(
+  abstract_goto_modelt &goto_model)
+{
+  step_model.symbol_table=goto_model.get_symbol_table();
+  step_model.goto_functions.copy_from(goto_model.get_goto_functions());
+
+  if(options.get_bool_option("k-induction-invariants"))
+  {
+    status() << "Computing loop invariants" << eom;
+    add_invariants();
+  }
+
+  // the step case is checked for increasing k with the same solver
+  step_prop_conv.set_message_handler(get_message_handler());
+  step_prop_conv.set_all_frozen();
+
+  return bmc_incrementalt::run(goto_model);
+}
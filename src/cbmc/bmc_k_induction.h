@@ -0,0 +1,70 @@
+/*******************************************************************\
+
+Module: k-Induction
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// k-Induction
+
+#ifndef CPROVER_CBMC_BMC_K_INDUCTION_H
+#define CPROVER_CBMC_BMC_K_INDUCTION_H
+
+#include <goto-programs/goto_model.h>
+
+#include "bmc_incremental.h"
+
+/// \brief k-induction with one incremental solver for the base case and
+/// another for the step case
+///
+/// The base case is the incremental bounded model checking of
+/// bmc_incrementalt, with a bound k shared by all loops. Once no property
+/// fails within k iterations, the step case of goto-instrument's
+/// k_induction() transformation is checked for the same k: if the
+/// properties hold in an iteration from an arbitrary state after holding in
+/// the k iterations before, they hold in all iterations. Otherwise k is
+/// raised by one. The formula of the step case for k is added to its solver
+/// under an activation literal, and retracted once checked.
+///
+/// With `--k-induction-invariants`, the arbitrary state at the loop heads
+/// of the step case is restricted to the intervals that abstract
+/// interpretation finds for the variables modified by the loops, other than
+/// those whose address is taken.
+class bmc_k_inductiont:public bmc_incrementalt
+{
+public:
+  bmc_k_inductiont(
+    const optionst &_options,
+    const symbol_tablet &outer_symbol_table,
+    message_handlert &_message_handler,
+    prop_convt &_prop_conv,
+    prop_convt &_step_prop_conv,
+    path_storaget &_path_storage,
+    std::function<bool(void)> callback_after_symex);
+
+  using bmc_incrementalt::run;
+  resultt run(abstract_goto_modelt &) override;
+
+protected:
+  prop_convt &step_prop_conv;
+  /// the program that the step case is built from for each k
+  goto_modelt step_model;
+
+  /// the bound of all loops
+  unsigned k;
+  /// the largest k whose step case has been checked
+  unsigned step_k;
+
+  unsigned loop_bound(const irep_idt &) override;
+  void raise_loop_bound(const irep_idt &, unsigned bound) override;
+  bool proved(const symex_bmct::loop_checkpointt &) override;
+  resultt report(resultt) override;
+
+  /// Assume the intervals of the variables modified by each loop of
+  /// `step_model`, and whose address is not taken, at its head
+  void add_invariants();
+};
+
+#endif // CPROVER_CBMC_BMC_K_INDUCTION_H
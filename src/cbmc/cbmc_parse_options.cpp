@@ -54,6 +54,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-instrument/full_slicer.h>
 #include <goto-instrument/nondet_static.h>
 #include <goto-instrument/cover.h>
+#include <goto-instrument/thread_independence.h>
 
 #include <pointer-analysis/add_failed_symbols.h>
 
@@ -123,6 +124,49 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     exit(CPROVER_EXIT_USAGE_ERROR);
   }
 
+  if(cmdline.isset("auto-unwind") &&
+     (cmdline.isset("cover") ||
+      cmdline.isset("partial-loops") ||
+      cmdline.isset("paths")))
+  {
+    error() << "--auto-unwind must not be given together with --cover, "
+            << "--partial-loops or --paths" << eom;
+    exit(CPROVER_EXIT_USAGE_ERROR);
+  }
+
+  if(cmdline.isset("incremental") &&
+     (cmdline.isset("cover") ||
+      cmdline.isset("partial-loops") ||
+      cmdline.isset("paths") ||
+      cmdline.isset("auto-unwind")))
+  {
+    error() << "--incremental must not be given together with --cover, "
+            << "--partial-loops, --paths or --auto-unwind" << eom;
+    exit(CPROVER_EXIT_USAGE_ERROR);
+  }
+
+  if((cmdline.isset("stop-when-unsat") || cmdline.isset("magic-numbers")) &&
+     !cmdline.isset("incremental"))
+  {
+    error() << "--stop-when-unsat and --magic-numbers require --incremental"
+            << eom;
+    exit(CPROVER_EXIT_USAGE_ERROR);
+  }
+
+  if(cmdline.isset("k-induction") &&
+     (cmdline.isset("cover") ||
+      cmdline.isset("partial-loops") ||
+      cmdline.isset("paths") ||
+      cmdline.isset("auto-unwind") ||
+      cmdline.isset("incremental") ||
+      cmdline.isset("unwinding-assertions")))
+  {
+    error() << "--k-induction must not be given together with --cover, "
+            << "--partial-loops, --paths, --auto-unwind, --incremental or "
+            << "--unwinding-assertions" << eom;
+    exit(CPROVER_EXIT_USAGE_ERROR);
+  }
+
   if(cmdline.isset("reachability-slice") &&
      cmdline.isset("reachability-slice-fb"))
   {
@@ -151,6 +195,9 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("mm"))
     options.set_option("mm", cmdline.get_value("mm"));
 
+  if(cmdline.isset("lazy-mm"))
+    options.set_option("lazy-mm", true);
+
   if(cmdline.isset("c89"))
     config.ansi_c.set_c89();
 
@@ -223,6 +270,30 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("unwindset"))
     options.set_option("unwindset", cmdline.get_value("unwindset"));
 
+  if(cmdline.isset("auto-unwind"))
+    options.set_option("auto-unwind", cmdline.get_value("auto-unwind"));
+
+  if(cmdline.isset("incremental"))
+    options.set_option("incremental", true);
+
+  if(cmdline.isset("unwind-min"))
+    options.set_option("unwind-min", cmdline.get_value("unwind-min"));
+
+  if(cmdline.isset("unwind-max"))
+    options.set_option("unwind-max", cmdline.get_value("unwind-max"));
+
+  if(cmdline.isset("stop-when-unsat"))
+    options.set_option("stop-when-unsat", true);
+
+  if(cmdline.isset("magic-numbers"))
+    options.set_option("magic-numbers", true);
+
+  if(cmdline.isset("k-induction"))
+    options.set_option("k-induction", cmdline.get_value("k-induction"));
+
+  if(cmdline.isset("k-induction-invariants"))
+    options.set_option("k-induction-invariants", true);
+
   // constant propagation
   if(cmdline.isset("no-propagation"))
     options.set_option("propagation", false);
@@ -243,7 +314,12 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("error-label", cmdline.get_values("error-label"));
 
   // generate unwinding assertions
-  if(cmdline.isset("unwinding-assertions"))
+  // (the bounds found by --auto-unwind are checked by these, as are those
+  // of --incremental unless disabled)
+  if(cmdline.isset("unwinding-assertions") ||
+     cmdline.isset("auto-unwind") ||
+     (cmdline.isset("incremental") &&
+      !cmdline.isset("no-unwinding-assertions")))
     options.set_option("unwinding-assertions", true);
 
   if(cmdline.isset("partial-loops"))
@@ -521,12 +597,28 @@ int cbmc_parse_optionst::doit()
   if(set_properties())
     return CPROVER_EXIT_SET_PROPERTIES_FAILED;
 
+  std::function<void(bmct &, const symbol_tablet &)> configure_bmc=nullptr;
+  std::unordered_set<irep_idt> independent_objects;
+
+  if(cmdline.isset("thread-independence"))
+  {
+    status() << "Finding objects not accessed concurrently" << eom;
+    independent_objects=thread_independent_objects(goto_model);
+    statistics() << independent_objects.size()
+                 << " objects are not accessed concurrently" << eom;
+
+    configure_bmc=[&independent_objects](bmct &bmc, const symbol_tablet &) {
+      bmc.set_thread_independent_objects(independent_objects);
+    };
+  }
+
   return bmct::do_language_agnostic_bmc(
     path_strategy_chooser,
     options,
     goto_model,
     ui_message_handler.get_ui(),
-    *this);
+    *this,
+    configure_bmc);
 }
 
 bool cbmc_parse_optionst::set_properties()
@@ -925,6 +1017,9 @@ void cbmc_parse_optionst::help()
     " --show-symbol-table          show loaded symbol table\n"
     HELP_SHOW_GOTO_FUNCTIONS
     " --drop-unused-functions      drop functions trivially unreachable from main function\n" // NOLINT(*)
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --lazy-functions             only convert the functions reachable from the entry point\n"
+    " --jobs n                     typecheck and convert functions using n processes\n" // NOLINT(*)
     "\n"
     "Program instrumentation options:\n"
     HELP_GOTO_CHECK
@@ -933,6 +1028,9 @@ void cbmc_parse_optionst::help()
     " --error-label label          check that label is unreachable\n"
     " --cover CC                   create test-suite with coverage criterion CC\n" // NOLINT(*)
     " --mm MM                      memory consistency model for concurrent programs\n" // NOLINT(*)
+    " --lazy-mm                    add SC memory model constraints on demand\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --thread-independence        don't encode accesses to objects that threads do not access concurrently\n"
     HELP_REACHABILITY_SLICER
     " --full-slice                 run full slicer (experimental)\n" // NOLINT(*)
     "\n"
@@ -58,13 +58,13 @@ class optionst;
   OPT_SHOW_GOTO_FUNCTIONS \
   OPT_SHOW_PROPERTIES \
   "(show-symbol-table)(show-parse-tree)" \
-  "(drop-unused-functions)" \
+  "(drop-unused-functions)(lazy-functions)(jobs):" \
   "(property):(stop-on-fail)(trace)" \
   "(error-label):(verbosity):(no-library)" \
   "(nondet-static)" \
   "(version)" \
   "(cover):(symex-coverage-report):" \
-  "(mm):" \
+  "(mm):(lazy-mm)(thread-independence)" \
   OPT_TIMESTAMP \
   "(i386-linux)(i386-macos)(i386-win32)(win32)(winx64)(gcc)" \
   "(ppc-macos)(unsigned-char)" \
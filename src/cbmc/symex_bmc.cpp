@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <limits>
 
+#include <util/make_unique.h>
 #include <util/source_location.h>
 #include <util/simplify_expr.h>
 
@@ -104,6 +105,41 @@ void symex_bmct::merge_goto(
     symex_coverage.covered(prev_pc, state.source.pc);
 }
 
+void symex_bmct::loop_bound_exceeded(
+  statet &state,
+  const exprt &guard)
+{
+  if(save_loop_checkpoints && !loop_checkpoint)
+  {
+    if(skip_next_loop_checkpoint)
+      skip_next_loop_checkpoint=false;
+    else
+    {
+      const irep_idt id=goto_programt::loop_id(*state.source.pc);
+
+      loop_checkpoint=util_make_unique<loop_checkpointt>(state, target);
+      loop_checkpoint->loop_id=id;
+
+      // resuming executes the backwards goto again, which counts the
+      // iteration and records the goto once more
+      unsigned &unwind=loop_checkpoint->state.top().loop_iterations[id].count;
+      loop_checkpoint->unwind=unwind--;
+
+      loop_checkpoint->steps=target.SSA_steps.size();
+      if(!target.SSA_steps.empty() &&
+         target.SSA_steps.back().is_goto() &&
+         target.SSA_steps.back().source.pc==state.source.pc)
+        loop_checkpoint->steps--;
+
+      loop_checkpoint->continuation=
+        guard.is_true() ? state.guard.as_expr()
+                        : and_exprt(state.guard.as_expr(), guard);
+    }
+  }
+
+  goto_symext::loop_bound_exceeded(state, guard);
+}
+
 bool symex_bmct::get_unwind(
   const symex_targett::sourcet &source,
   unsigned unwind)
@@ -200,6 +236,29 @@ bool symex_bmct::get_unwind_recursion(
   return abort;
 }
 
+irep_idt symex_bmct::unwinding_assertion_id(
+  const symex_target_equationt::SSA_stept &step)
+{
+  if(!step.is_assert())
+    return irep_idt();
+
+  const goto_programt::instructiont &instruction=*step.source.pc;
+
+  // only unwinding assertions are generated for backwards gotos
+  if(instruction.is_goto())
+    return goto_programt::loop_id(instruction);
+
+  if(instruction.is_function_call() &&
+     step.comment=="recursion unwinding assertion")
+  {
+    const exprt &function=to_code_function_call(instruction.code).function();
+    if(function.id()==ID_symbol)
+      return to_symbol_expr(function).get_identifier();
+  }
+
+  return irep_idt();
+}
+
 void symex_bmct::no_body(const irep_idt &identifier)
 {
   if(body_warnings.insert(identifier).second)
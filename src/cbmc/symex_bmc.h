@@ -12,11 +12,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_CBMC_SYMEX_BMC_H
 #define CPROVER_CBMC_SYMEX_BMC_H
 
+#include <memory>
+
 #include <util/message.h>
 #include <util/threeval.h>
 
 #include <goto-symex/path_storage.h>
 #include <goto-symex/goto_symex.h>
+#include <goto-symex/symex_target_equation.h>
 
 #include <goto-instrument/unwindset.h>
 
@@ -82,6 +85,37 @@ public:
 
   unwindsett unwindset;
 
+  /// \return the id of the loop or recursive function if \p step is one of
+  ///   their unwinding assertions, and the empty id otherwise
+  static irep_idt unwinding_assertion_id(
+    const symex_target_equationt::SSA_stept &step);
+
+  /// The state of symbolic execution at the first loop whose bound was
+  /// exceeded, from which execution can be resumed with a higher bound
+  struct loop_checkpointt
+  {
+    loop_checkpointt(const statet &_state, symex_target_equationt &equation):
+      state(_state, &equation)
+    {
+    }
+
+    statet state;
+    /// the number of steps of the equation before the loop was left
+    std::size_t steps;
+    irep_idt loop_id;
+    unsigned unwind;
+    /// holds if the loop can be iterated another time
+    exprt continuation;
+  };
+
+  /// Save a checkpoint when a loop bound is exceeded while there is none,
+  /// for incremental unwinding
+  bool save_loop_checkpoints=false;
+  /// Do not save a checkpoint at the next loop bound, as the driver has
+  /// resumed from there to leave the loop
+  bool skip_next_loop_checkpoint=false;
+  std::unique_ptr<loop_checkpointt> loop_checkpoint;
+
 protected:
   /// Callbacks that may provide an unwind/do-not-unwind decision for a loop
   std::vector<loop_unwind_handlert> loop_unwind_handlers;
@@ -106,6 +140,8 @@ protected:
     const symex_targett::sourcet &source,
     unsigned unwind);
 
+  virtual void loop_bound_exceeded(statet &, const exprt &guard);
+
   virtual bool get_unwind_recursion(
     const irep_idt &identifier,
     const unsigned thread_nr,
@@ -0,0 +1,457 @@
+/*******************************************************************\
+
+Module: Compilation Cache
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Compilation Cache
+
+#include "compilation_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#include <process.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/utime.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+#include <util/config.h>
+#include <util/get_base_name.h>
+#include <util/irep_hash.h>
+#include <util/string_hash.h>
+#include <util/suffix.h>
+
+#include <cbmc/version.h>
+
+/// The settings of `config` that affect the translation of a source file
+static std::string config_fingerprint()
+{
+  const configt::ansi_ct &ansi_c=config.ansi_c;
+  std::ostringstream out;
+
+  out << ansi_c.int_width << ' ' << ansi_c.long_int_width << ' '
+      << ansi_c.bool_width << ' ' << ansi_c.char_width << ' '
+      << ansi_c.short_int_width << ' ' << ansi_c.long_long_int_width << ' '
+      << ansi_c.pointer_width << ' ' << ansi_c.single_width << ' '
+      << ansi_c.double_width << ' ' << ansi_c.long_double_width << ' '
+      << ansi_c.wchar_t_width << ' '
+      << ansi_c.char_is_unsigned << ansi_c.wchar_t_is_unsigned
+      << ansi_c.for_has_scope << ansi_c.single_precision_constant
+      << ansi_c.NULL_is_zero << ansi_c.string_abstraction << ' '
+      << static_cast<int>(ansi_c.c_standard) << ' '
+      << static_cast<int>(ansi_c.rounding_mode) << ' '
+      << ansi_c.alignment << ' ' << ansi_c.memory_operand_size << ' '
+      << static_cast<int>(ansi_c.endianness) << ' '
+      << static_cast<int>(ansi_c.os) << ' '
+      << ansi_c.arch << ' '
+      << static_cast<int>(ansi_c.mode) << ' '
+      << static_cast<int>(ansi_c.preprocessor) << ' '
+      << static_cast<int>(ansi_c.lib) << ' '
+      << static_cast<int>(config.cpp.cpp_standard);
+
+  for(const auto &define : ansi_c.defines)
+    out << " -D" << define;
+  for(const auto &undefine : ansi_c.undefines)
+    out << " -U" << undefine;
+  for(const auto &option : ansi_c.preprocessor_options)
+    out << ' ' << option;
+  for(const auto &include_path : ansi_c.include_paths)
+    out << " -I" << include_path;
+  for(const auto &include_file : ansi_c.include_files)
+    out << " -include " << include_file;
+
+  return out.str();
+}
+
+/// Replace \p to by \p from
+static bool move_file(const std::string &from, const std::string &to)
+{
+#ifdef _WIN32
+  std::remove(to.c_str());
+#endif
+  return std::rename(from.c_str(), to.c_str())!=0;
+}
+
+static void touch_file(const std::string &file_name)
+{
+#ifdef _WIN32
+  _utime(file_name.c_str(), nullptr);
+#else
+  utime(file_name.c_str(), nullptr);
+#endif
+}
+
+static unsigned long process_id()
+{
+#ifdef _WIN32
+  return static_cast<unsigned long>(_getpid());
+#else
+  return static_cast<unsigned long>(getpid());
+#endif
+}
+
+/// Compare the next \p size bytes of \p in with the contents of the file
+/// \p file_name
+/// \return true if they are the same, false otherwise
+static bool same_contents(
+  std::istream &in,
+  std::uint64_t size,
+  const std::string &file_name)
+{
+  std::ifstream file(file_name, std::ios::binary);
+  if(!file)
+    return false;
+
+  char buffer[1<<14], file_buffer[1<<14];
+
+  while(size>0)
+  {
+    const std::size_t chunk=
+      static_cast<std::size_t>(std::min<std::uint64_t>(size, sizeof(buffer)));
+
+    in.read(buffer, chunk);
+    file.read(file_buffer, chunk);
+
+    if(!in || !file || std::memcmp(buffer, file_buffer, chunk)!=0)
+      return false;
+
+    size-=chunk;
+  }
+
+  // the file must not be longer
+  return file.peek()==std::ifstream::traits_type::eof();
+}
+
+static std::uint64_t file_size(const std::string &file_name)
+{
+  struct stat stbuf;
+  if(stat(file_name.c_str(), &stbuf)!=0)
+    return 0;
+  return stbuf.st_size;
+}
+
+compilation_cachet::compilation_cachet(
+  const std::string &_directory,
+  std::uint64_t _max_size,
+  int _goto_binary_version,
+  message_handlert &_message_handler):
+  messaget(_message_handler),
+  directory(_directory),
+  max_size(_max_size),
+  goto_binary_version(_goto_binary_version),
+  entries_listed(false),
+  entries_size(0)
+{
+#ifdef _WIN32
+  _mkdir(directory.c_str());
+#else
+  mkdir(directory.c_str(), 0777);
+#endif
+}
+
+void compilation_cachet::list_entries()
+{
+  entries.clear();
+  entries_size=0;
+  entries_listed=true;
+
+#ifdef _WIN32
+  const std::string pattern=directory+"\\*.gb";
+  // NOLINTNEXTLINE(readability/identifiers)
+  struct _finddata_t info;
+  intptr_t handle=_findfirst(pattern.c_str(), &info);
+  if(handle!=-1)
+  {
+    do
+    {
+      if(!(info.attrib & _A_SUBDIR))
+      {
+        entryt &entry=entries[directory+"/"+info.name];
+        entry.size=info.size;
+        entry.last_use=info.time_write;
+        entries_size+=entry.size;
+      }
+    }
+    while(_findnext(handle, &info)==0);
+    _findclose(handle);
+  }
+#else
+  DIR *dir=opendir(directory.c_str());
+  if(dir!=nullptr)
+  {
+    struct dirent *ent;
+    while((ent=readdir(dir))!=nullptr)
+    {
+      if(!has_suffix(ent->d_name, ".gb"))
+        continue;
+
+      const std::string file_name=directory+"/"+ent->d_name;
+
+      struct stat stbuf;
+      if(stat(file_name.c_str(), &stbuf)!=0 || !S_ISREG(stbuf.st_mode))
+        continue;
+
+      entryt &entry=entries[file_name];
+      entry.size=stbuf.st_size;
+      entry.last_use=stbuf.st_mtime;
+      entries_size+=entry.size;
+    }
+    closedir(dir);
+  }
+#endif
+}
+
+compilation_cachet::keyt compilation_cachet::key(
+  const std::string &file_name,
+  const std::string &language,
+  const std::string &options) const
+{
+  keyt result;
+
+  std::ifstream in(file_name, std::ios::binary);
+  if(!in)
+    return result;
+
+  std::ostringstream settings;
+  settings << "goto-cc " CBMC_VERSION << '\n'
+           << goto_binary_version << '\n'
+           << language << '\n'
+           // the base name, as the names of preprocessed files are temporary
+           << get_base_name(file_name, false) << '\n'
+           << options << '\n'
+           << config_fingerprint() << '\n';
+
+  result.settings=settings.str();
+  result.file_name=file_name;
+
+  std::size_t hash=hash_string(result.settings);
+
+  char buffer[1<<16];
+  while(in)
+  {
+    in.read(buffer, sizeof(buffer));
+    hash=hash_combine(
+      hash,
+      hash_string(std::string(buffer, static_cast<std::size_t>(in.gcount()))));
+  }
+
+  if(in.bad())
+    return result;
+
+  std::ostringstream hex;
+  hex << std::hex << std::setfill('0') << std::setw(sizeof(hash)*2) << hash;
+  result.hash=hex.str();
+
+  return result;
+}
+
+std::string compilation_cachet::entry_file_name(const keyt &key) const
+{
+  return directory+"/"+key.hash+".gb";
+}
+
+// An entry consists of a header, the source, and the object file:
+//   <size of the settings> <size of the source>\n<settings><source><object>
+
+bool compilation_cachet::lookup(
+  const keyt &key,
+  const std::string &object_file)
+{
+  const std::string entry=entry_file_name(key);
+
+  std::ifstream in(entry, std::ios::binary);
+  std::uint64_t settings_size, source_size;
+  in >> settings_size >> source_size;
+
+  bool hit=in && in.get()=='\n' && settings_size==key.settings.size();
+
+  if(hit)
+  {
+    std::string settings(key.settings.size(), ' ');
+    in.read(&settings[0], settings.size());
+    hit=in && settings==key.settings &&
+        same_contents(in, source_size, key.file_name);
+  }
+
+  if(hit)
+  {
+    std::ofstream out(object_file, std::ios::binary);
+    if(in.peek()!=std::ifstream::traits_type::eof())
+      out << in.rdbuf();
+    out.close();
+    hit=!!out;
+  }
+
+  if(!hit)
+  {
+    counters.misses++;
+    debug() << "Compilation cache miss: " << key.hash << eom;
+    return false;
+  }
+
+  // record the use for the eviction order
+  in.close();
+  touch_file(entry);
+
+  counters.hits++;
+  debug() << "Compilation cache hit: " << key.hash << eom;
+  return true;
+}
+
+void compilation_cachet::store(
+  const keyt &key,
+  const std::string &object_file)
+{
+  // concurrent compilers must not see partial entries
+  const std::string tmp=
+    directory+"/"+key.hash+"."+std::to_string(process_id())+".tmp";
+  const std::string entry=entry_file_name(key);
+
+  bool error;
+
+  {
+    std::ifstream source(key.file_name, std::ios::binary);
+    std::ifstream object(object_file, std::ios::binary);
+    std::ofstream out(tmp, std::ios::binary);
+
+    out << key.settings.size() << ' ' << file_size(key.file_name) << '\n'
+        << key.settings;
+    if(source.peek()!=std::ifstream::traits_type::eof())
+      out << source.rdbuf();
+    if(object.peek()!=std::ifstream::traits_type::eof())
+      out << object.rdbuf();
+
+    out.close();
+    error=!source || !object || !out;
+  }
+
+  if(error || move_file(tmp, entry))
+  {
+    std::remove(tmp.c_str());
+    warning() << "failed to add `" << object_file
+              << "' to the compilation cache" << eom;
+    return;
+  }
+
+  counters.stores++;
+
+  if(!entries_listed)
+    list_entries();
+  else
+  {
+    // an entry of the same name is replaced
+    entryt &e=entries[entry];
+    entries_size-=e.size;
+    e.size=file_size(entry);
+    e.last_use=std::time(nullptr);
+    entries_size+=e.size;
+  }
+
+  if(entries_size>max_size)
+    evict(entry);
+}
+
+void compilation_cachet::evict(const std::string &keep)
+{
+  // other processes may have changed the entries
+  list_entries();
+
+  if(entries_size<=max_size)
+    return;
+
+  // evict the least recently used entries, down to 90% of the bound so as
+  // not to evict again on the next store
+  std::vector<entriest::iterator> order;
+  order.reserve(entries.size());
+  for(auto it=entries.begin(); it!=entries.end(); it++)
+    order.push_back(it);
+
+  std::sort(
+    order.begin(),
+    order.end(),
+    [](const entriest::iterator &a, const entriest::iterator &b)
+    {
+      return a->second.last_use<b->second.last_use;
+    });
+
+  const std::uint64_t target=max_size/10*9;
+
+  for(const auto &it : order)
+  {
+    if(entries_size<=target)
+      break;
+
+    // the time stamps may not tell the entry just stored apart
+    if(it->first==keep)
+      continue;
+
+    if(std::remove(it->first.c_str())==0)
+    {
+      entries_size-=it->second.size;
+      counters.evictions++;
+      entries.erase(it);
+    }
+  }
+}
+
+void compilation_cachet::output_statistics()
+{
+  // accumulate the counters of all runs
+  const std::string stats_file=directory+"/stats";
+  counterst total;
+
+  {
+    std::ifstream in(stats_file);
+    in >> total.hits >> total.misses >> total.stores >> total.evictions;
+    if(!in)
+      total=counterst();
+  }
+
+  total.hits+=counters.hits;
+  total.misses+=counters.misses;
+  total.stores+=counters.stores;
+  total.evictions+=counters.evictions;
+
+  const std::string tmp=
+    stats_file+"."+std::to_string(process_id())+".tmp";
+
+  {
+    std::ofstream out(tmp);
+    out << total.hits << ' ' << total.misses << ' '
+        << total.stores << ' ' << total.evictions << '\n';
+  }
+
+  if(move_file(tmp, stats_file))
+    std::remove(tmp.c_str());
+
+  list_entries();
+
+  statistics() << "Compilation cache: " << counters.hits << " hits, "
+               << counters.misses << " misses, " << counters.stores
+               << " stores, " << counters.evictions << " evictions" << eom;
+  statistics() << "Compilation cache total: " << total.hits << " hits, "
+               << total.misses << " misses, " << total.stores
+               << " stores, " << total.evictions << " evictions; "
+               << entries.size() << " entries of " << entries_size
+               << " bytes (max " << max_size << ")" << eom;
+}
@@ -0,0 +1,127 @@
+/*******************************************************************\
+
+Module: Compilation Cache
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Compilation Cache
+
+#ifndef CPROVER_GOTO_CC_COMPILATION_CACHE_H
+#define CPROVER_GOTO_CC_COMPILATION_CACHE_H
+
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <string>
+
+#include <util/message.h>
+
+/// An on-disk cache of goto object files, in the style of ccache. An entry
+/// is addressed by a hash of the (preprocessed) source file, the settings of
+/// `config` and the options of goto-cc that affect its translation and the
+/// version of goto-cc; a hit yields the object file without parsing or
+/// typechecking the source. As hashes may collide, an entry also records the
+/// source and the settings it was compiled with, which must match exactly.
+///
+/// The entries are files in a single directory. Once the entries exceed the
+/// configured size, the least recently used ones are evicted. The counters
+/// are kept in a file in the same directory, so that statistics are
+/// accumulated across runs.
+class compilation_cachet:public messaget
+{
+public:
+  struct counterst
+  {
+    std::uint64_t hits;
+    std::uint64_t misses;
+    std::uint64_t stores;
+    std::uint64_t evictions;
+
+    counterst():hits(0), misses(0), stores(0), evictions(0)
+    {
+    }
+  };
+
+  struct keyt
+  {
+    /// names the entry, empty if the source can't be read
+    std::string hash;
+    /// the settings and options the source is compiled with
+    std::string settings;
+    std::string file_name;
+
+    bool empty() const
+    {
+      return hash.empty();
+    }
+  };
+
+  /// \param _directory: where the entries are stored, created if needed
+  /// \param _max_size: bound on the size of all entries, in bytes
+  /// \param _goto_binary_version: the version of the object files
+  /// \param _message_handler: for reporting statistics and problems
+  compilation_cachet(
+    const std::string &_directory,
+    std::uint64_t _max_size,
+    int _goto_binary_version,
+    message_handlert &_message_handler);
+
+  /// Compute the key of the source file \p file_name, given the
+  /// \p language it is compiled as and the \p options of goto-cc that
+  /// affect its translation
+  /// \return the key, empty if the source can't be read
+  keyt key(
+    const std::string &file_name,
+    const std::string &language,
+    const std::string &options) const;
+
+  /// Copy the entry for \p key to \p object_file
+  /// \return true if there is an entry, false otherwise
+  bool lookup(const keyt &key, const std::string &object_file);
+
+  /// Add \p object_file as the entry for \p key, evicting entries as needed
+  void store(const keyt &key, const std::string &object_file);
+
+  /// Output the counters of this run and the accumulated ones
+  void output_statistics();
+
+  const counterst &get_counters() const
+  {
+    return counters;
+  }
+
+protected:
+  const std::string directory;
+  const std::uint64_t max_size;
+  const int goto_binary_version;
+
+  /// the counters of this run
+  counterst counters;
+
+  struct entryt
+  {
+    std::uint64_t size;
+    std::time_t last_use;
+  };
+
+  typedef std::map<std::string, entryt> entriest;
+
+  /// The entries by file name, as far as known to this process: the
+  /// directory is listed on the first store, and again only once the bound
+  /// appears to be exceeded, as other processes may have added or evicted
+  /// entries in the meantime
+  entriest entries;
+  bool entries_listed;
+  std::uint64_t entries_size;
+
+  void list_entries();
+
+  std::string entry_file_name(const keyt &key) const;
+  /// Evict entries other than \p keep until the bound is met
+  void evict(const std::string &keep);
+};
+
+#endif // CPROVER_GOTO_CC_COMPILATION_CACHE_H
@@ -12,15 +12,21 @@ Date: June 2006
 /// Compile and link source and object files.
 
 #include "compile.h"
+#include "compilation_cache.h"
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <vector>
 
+#include <util/child_processes.h>
 #include <util/cmdline.h>
 #include <util/config.h>
 #include <util/file_util.h>
 #include <util/get_base_name.h>
+#include <util/string2int.h>
 #include <util/suffix.h>
 #include <util/tempdir.h>
 #include <util/unicode.h>
@@ -115,8 +121,15 @@ bool compilet::doit()
     get_message_handler().get_message_count(messaget::M_WARNING);
 
   if(!source_files.empty())
-    if(compile())
+  {
+    const bool error=compile();
+
+    if(compilation_cache)
+      compilation_cache->output_statistics();
+
+    if(error)
       return true;
+  }
 
   if(mode==LINK_LIBRARY ||
      mode==COMPILE_LINK ||
@@ -348,12 +361,12 @@ bool compilet::link()
   convert_symbols(compiled_functions);
 
   // parse object files
-  for(const auto &file_name : object_files)
-  {
-    if(read_object_and_link(file_name, symbol_table,
-                            compiled_functions, get_message_handler()))
-      return true;
-  }
+  if(read_objects_and_link(
+       std::vector<std::string>(object_files.begin(), object_files.end()),
+       symbol_table,
+       compiled_functions,
+       get_message_handler()))
+    return true;
 
   // produce entry point?
 
@@ -386,59 +399,357 @@ bool compilet::link()
 /// \return true on error, false otherwise
 bool compilet::compile()
 {
+#ifndef _WIN32
+  // several sources written to the same object file must be compiled in
+  // order
+  if(jobs>1 &&
+     source_files.size()>1 &&
+     mode!=PREPROCESS_ONLY &&
+     !((mode==COMPILE_ONLY || mode==ASSEMBLE_ONLY) &&
+       !output_file_object.empty()))
+    return compile_in_parallel();
+#endif
+
   while(!source_files.empty())
   {
     std::string file_name=source_files.front();
     source_files.pop_front();
 
-    // Visual Studio always prints the name of the file it's doing
-    if(echo_file_name)
-      status() << file_name << eom;
+    if(compile_source_file(file_name))
+      return true;
+  }
 
-    bool r=parse_source(file_name); // don't break the program!
+  return false;
+}
 
-    if(r)
+/// parses a single source file and, when compiling only, writes its object
+/// file
+/// \return true on error, false otherwise
+bool compilet::compile_source_file(const std::string &file_name)
+{
+  // Visual Studio always prints the name of the file it's doing
+  if(echo_file_name)
+    status() << file_name << eom;
+
+  compilation_cachet::keyt cache_key;
+  const unsigned warnings_before=
+    get_message_handler().get_message_count(messaget::M_WARNING);
+
+  if(compilation_cache && (mode==COMPILE_ONLY || mode==ASSEMBLE_ONLY))
+  {
+    cache_key=compilation_cache->key(
+      file_name, override_language, compilation_cache_options());
+
+    const std::string cfn=object_file_name(file_name);
+
+    if(!cache_key.empty() &&
+       compilation_cache->lookup(cache_key, cfn) &&
+       add_cached_object_file(cfn))
+      return false;
+  }
+
+  bool r=parse_source(file_name); // don't break the program!
+
+  if(r)
+  {
+    const std::string &debug_outfile=
+      cmdline.get_value("print-rejected-preprocessed-source");
+    if(!debug_outfile.empty())
     {
-      const std::string &debug_outfile=
-        cmdline.get_value("print-rejected-preprocessed-source");
-      if(!debug_outfile.empty())
-      {
-        std::ifstream in(file_name, std::ios::binary);
-        std::ofstream out(debug_outfile, std::ios::binary);
-        out << in.rdbuf();
-        warning() << "Failed sources in " << debug_outfile << eom;
-      }
+      std::ifstream in(file_name, std::ios::binary);
+      std::ofstream out(debug_outfile, std::ios::binary);
+      out << in.rdbuf();
+      warning() << "Failed sources in " << debug_outfile << eom;
+    }
+
+    return true; // parser/typecheck error
+  }
+
+  if(mode==COMPILE_ONLY || mode==ASSEMBLE_ONLY)
+  {
+    // output an object file for every source file
+
+    // "compile" functions
+    convert_symbols(compiled_functions);
+
+    std::string cfn=object_file_name(file_name);
+
+    if(write_object_file(cfn, symbol_table, compiled_functions))
+      return true;
+
+    // a hit would not repeat the warnings, which may be fatal
+    if(!cache_key.empty() &&
+       get_message_handler().get_message_count(messaget::M_WARNING)==
+         warnings_before)
+      compilation_cache->store(cache_key, cfn);
+
+    if(add_written_cprover_symbols(symbol_table))
+      return true;
+
+    symbol_table.clear(); // clean symbol table for next source file.
+    compiled_functions.clear();
+  }
+
+  return false;
+}
+
+/// Record the object file \p object_file taken from the compilation cache
+/// \return true if the object file is usable, false otherwise
+bool compilet::add_cached_object_file(const std::string &object_file)
+{
+  // the __CPROVER symbols of the object still need to be recorded
+  symbol_tablet object_symbol_table;
+  goto_functionst object_functions;
+
+  if(read_goto_binary(
+       object_file,
+       object_symbol_table,
+       object_functions,
+       get_message_handler()) ||
+     add_written_cprover_symbols(object_symbol_table))
+  {
+    warning() << "ignoring unusable compilation cache entry for `"
+              << object_file << "'" << eom;
+    return false;
+  }
+
+  statistics() << "Using cached object `" << object_file << "'" << eom;
+  wrote_object=true;
+
+  return true;
+}
+
+std::string compilet::object_file_name(const std::string &file_name) const
+{
+  if(output_file_object=="")
+    return get_base_name(file_name, true)+"."+object_file_extension;
+  else
+    return output_file_object;
+}
+
+/// The options of goto-cc, other than those recorded in `config`, that
+/// compilation cache entries depend on; only options that change the object
+/// file belong here, hence not, e.g., the number of jobs
+std::string compilet::compilation_cache_options() const
+{
+  return "mode="+std::to_string(static_cast<int>(mode));
+}
+
+#ifndef _WIN32
+/// Compile a single source file in a child process, see
+/// compile_in_parallel(): unless only compiling, the symbols and functions
+/// of the file are written to \p object_file. When only compiling, the
+/// object file is written as usual, and the `__CPROVER` macros it contains
+/// are written to \p macros_file, so that the parent need not read the
+/// whole object file to record them.
+/// \return the exit status of the child process: 0 on success, 2 on
+///   success with warnings, 1 on failure
+int compilet::compile_job(
+  const std::string &file_name,
+  const std::string &object_file,
+  const std::string &macros_file)
+{
+  const unsigned warnings_before=
+    get_message_handler().get_message_count(messaget::M_WARNING);
+
+  if(compile_source_file(file_name))
+    return 1;
 
-      return true; // parser/typecheck error
+  if(mode==COMPILE_ONLY || mode==ASSEMBLE_ONLY)
+  {
+    symbol_tablet macros;
+    for(const auto &pair : written_macros)
+      macros.add(pair.second);
+
+    std::ofstream out(macros_file, std::ios::binary);
+    if(!out ||
+       write_goto_binary(
+         out, macros, goto_functionst(), goto_binary_version))
+    {
+      error() << "Error writing file `" << macros_file << "'" << eom;
+      return 1;
+    }
+  }
+  else
+  {
+    convert_symbols(compiled_functions);
+
+    std::ofstream out(object_file, std::ios::binary);
+    if(!out ||
+       write_goto_binary(
+         out, symbol_table, compiled_functions, goto_binary_version))
+    {
+      error() << "Error writing file `" << object_file << "'" << eom;
+      return 1;
     }
+  }
+
+  const bool warnings=
+    get_message_handler().get_message_count(messaget::M_WARNING)!=
+    warnings_before;
+
+  if(!warnings)
+    return 0;
+
+  // the parent must not add the object file to the compilation cache, as a
+  // hit would not repeat the warnings
+  return warning_is_fatal ? 1 : 2;
+}
+
+/// Parse, typecheck and convert each source file in a child process of its
+/// own, running up to `jobs` of them at a time. The output of each child is
+/// buffered in a file. Once all children have finished, the output is
+/// replayed and the results are linked in the order the source files were
+/// given in, which makes the result independent of the scheduling.
+/// \return true on error, false otherwise
+bool compilet::compile_in_parallel()
+{
+  struct compile_jobt
+  {
+    std::string file_name;
+    std::string object_file;
+    std::string macros_file;
+    compilation_cachet::keyt cache_key;
+    bool cached;
+    /// the number of the child process that compiles the file
+    std::size_t child;
+    int status;
+  };
+
+  const std::string tmp_dir=get_temporary_directory("goto-cc-XXXXXX");
+  tmp_dirs.push_back(tmp_dir);
+
+  std::vector<compile_jobt> compile_jobs;
+
+  while(!source_files.empty())
+  {
+    compile_jobt job;
+    job.file_name=source_files.front();
+    source_files.pop_front();
+
+    const std::string prefix=
+      tmp_dir+"/"+std::to_string(compile_jobs.size());
 
     if(mode==COMPILE_ONLY || mode==ASSEMBLE_ONLY)
+      job.object_file=object_file_name(job.file_name);
+    else
+      job.object_file=prefix+".gb";
+
+    job.macros_file=prefix+".macros";
+    job.child=0;
+    job.status=1;
+
+    if(compilation_cache && (mode==COMPILE_ONLY || mode==ASSEMBLE_ONLY))
+      job.cache_key=compilation_cache->key(
+        job.file_name, override_language, compilation_cache_options());
+
+    job.cached=
+      !job.cache_key.empty() &&
+      compilation_cache->lookup(job.cache_key, job.object_file);
+
+    compile_jobs.push_back(job);
+  }
+
+  // cache hits need not be compiled
+  std::vector<std::size_t> children;
+  for(std::size_t i=0; i<compile_jobs.size(); i++)
+  {
+    if(!compile_jobs[i].cached)
     {
-      // output an object file for every source file
+      compile_jobs[i].child=children.size();
+      children.push_back(i);
+    }
+  }
 
-      // "compile" functions
-      convert_symbols(compiled_functions);
+  statistics() << "Compiling " << compile_jobs.size() << " files using "
+               << jobs << " processes" << eom;
 
-      std::string cfn;
+  const std::vector<int> exit_status=run_in_child_processes(
+    children.size(),
+    jobs,
+    tmp_dir,
+    get_message_handler(),
+    [this, &compile_jobs, &children](std::size_t child) {
+      const compile_jobt &job=compile_jobs[children[child]];
 
-      if(output_file_object=="")
-        cfn=get_base_name(file_name, true)+"."+object_file_extension;
-      else
-        cfn=output_file_object;
+      // the parent maintains the cache
+      compilation_cache.reset();
+
+      // the files are compiled in parallel already
+      jobs=1;
+
+      return compile_job(job.file_name, job.object_file, job.macros_file);
+    });
+
+  for(std::size_t child=0; child<children.size(); child++)
+  {
+    compile_jobt &job=compile_jobs[children[child]];
+    job.status=exit_status[child];
+
+    if(job.status<0)
+    {
+      error() << "failed to create process for `"
+              << job.file_name << "'" << eom;
+      return true;
+    }
+  }
+
+  for(const auto &job : compile_jobs)
+  {
+    if(job.cached)
+    {
+      if(add_cached_object_file(job.object_file))
+      {
+        if(echo_file_name)
+          status() << job.file_name << eom;
+        continue;
+      }
 
-      if(write_object_file(cfn, symbol_table, compiled_functions))
+      // an unusable entry: compile the source instead
+      std::unique_ptr<compilation_cachet> cache=std::move(compilation_cache);
+      const bool error=compile_source_file(job.file_name);
+      compilation_cache=std::move(cache);
+
+      if(error)
         return true;
+      continue;
+    }
 
-      if(add_written_cprover_symbols(symbol_table))
+    replay_child_output(tmp_dir, job.child);
+
+    if(job.status!=0 && job.status!=2)
+      return true;
+
+    if(!job.cache_key.empty() && job.status==0)
+      compilation_cache->store(job.cache_key, job.object_file);
+
+    if(mode==COMPILE_ONLY || mode==ASSEMBLE_ONLY)
+    {
+      // record the __CPROVER symbols in the object file written by the child
+      symbol_tablet macros;
+      goto_functionst no_functions;
+
+      if(read_goto_binary(
+           job.macros_file,
+           macros,
+           no_functions,
+           get_message_handler()) ||
+         add_written_cprover_symbols(macros))
         return true;
 
-      symbol_table.clear(); // clean symbol table for next source file.
-      compiled_functions.clear();
+      wrote_object=true;
     }
+    else if(read_object_and_link(
+              job.object_file,
+              symbol_table,
+              compiled_functions,
+              get_message_handler()))
+      return true;
   }
 
   return false;
 }
+#endif
 
 /// parses a source file (low-level parsing)
 /// \return true on error, false otherwise
@@ -482,6 +793,10 @@ bool compilet::parse(const std::string &file_name)
 
   languagep->set_message_handler(get_message_handler());
 
+  // typecheck in parallel, unless the files are compiled in parallel
+  if(jobs>1)
+    languagep->get_language_options(cmdline);
+
   language_filet &lf=language_files.add_file(file_name);
   lf.language=std::move(languagep);
 
@@ -602,7 +917,8 @@ bool compilet::write_bin_object_file(
     return true;
   }
 
-  if(write_goto_binary(outfile, lsymbol_table, functions))
+  if(write_goto_binary(
+       outfile, lsymbol_table, functions, goto_binary_version))
     return true;
 
   unsigned cnt=function_body_count(functions);
@@ -648,6 +964,31 @@ compilet::compilet(cmdlinet &_cmdline, ui_message_handlert &mh, bool Werror):
   echo_file_name=false;
   wrote_object=false;
   working_directory=get_current_working_directory();
+
+  jobs=1;
+  if(cmdline.isset("jobs"))
+    jobs=std::max<std::size_t>(
+      1, unsafe_string2size_t(cmdline.get_value("jobs")));
+
+  goto_binary_version=
+    cmdline.isset("compress-goto-binary") ?
+    GOTO_BINARY_COMPRESSED_VERSION : GOTO_BINARY_VERSION;
+
+  if(cmdline.isset("compilation-cache"))
+  {
+    // in MiB
+    std::uint64_t cache_size=1024;
+    if(cmdline.isset("compilation-cache-size"))
+      cache_size=unsafe_string2unsigned(
+        cmdline.get_value("compilation-cache-size"));
+
+    compilation_cache=std::unique_ptr<compilation_cachet>(
+      new compilation_cachet(
+        cmdline.get_value("compilation-cache"),
+        cache_size<<20,
+        goto_binary_version,
+        get_message_handler()));
+  }
 }
 
 /// cleans up temporary files
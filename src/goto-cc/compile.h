@@ -14,12 +14,16 @@ Date: June 2006
 #ifndef CPROVER_GOTO_CC_COMPILE_H
 #define CPROVER_GOTO_CC_COMPILE_H
 
+#include <memory>
+
 #include <util/symbol.h>
 #include <util/rename_symbol.h>
 
 #include <langapi/language_ui.h>
 #include <goto-programs/goto_model.h>
 
+class compilation_cachet;
+
 class compilet:public language_uit
 {
 public:
@@ -47,6 +51,15 @@ public:
   std::string object_file_extension;
   std::string output_file_object, output_file_executable;
 
+  /// number of source files to compile concurrently
+  std::size_t jobs;
+
+  /// the version of the goto binaries written, see write_goto_binary
+  int goto_binary_version;
+
+  /// object files of previous compilations, if enabled
+  std::unique_ptr<compilation_cachet> compilation_cache;
+
   compilet(cmdlinet &_cmdline, ui_message_handlert &mh, bool Werror);
 
   ~compilet();
@@ -62,6 +75,7 @@ public:
   bool link();
 
   bool parse_source(const std::string &);
+  bool compile_source_file(const std::string &);
 
   bool write_object_file(
     const std::string &,
@@ -100,6 +114,18 @@ protected:
 
   void convert_symbols(goto_functionst &dest);
 
+  std::string object_file_name(const std::string &file_name) const;
+  std::string compilation_cache_options() const;
+  bool add_cached_object_file(const std::string &object_file);
+
+#ifndef _WIN32
+  bool compile_in_parallel();
+  int compile_job(
+    const std::string &file_name,
+    const std::string &object_file,
+    const std::string &macros_file);
+#endif
+
   bool add_written_cprover_symbols(const symbol_tablet &symbol_table);
   std::map<irep_idt, symbolt> written_macros;
 
@@ -27,6 +27,9 @@ const char *goto_cc_options_with_separated_argument[]=
   "--native-compiler",
   "--native-linker",
   "--print-rejected-preprocessed-source",
+  "--jobs",
+  "--compilation-cache",
+  "--compilation-cache-size",
   nullptr
 };
 
@@ -49,6 +52,7 @@ const char *goto_cc_options_without_argument[]=
   "--big-endian",
   "--no-arch",
   "--partial-inlining",
+  "--compress-goto-binary",
   "-?",
   nullptr
 };
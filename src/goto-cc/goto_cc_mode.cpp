@@ -64,6 +64,13 @@ void goto_cc_modet::help()
   " --native-assembler cmd      command to invoke as assembler (goto-as only)\n"
   " --print-rejected-preprocessed-source file\n"
   "                             copy failing (preprocessed) source to file\n"
+  " --jobs n                    compile up to n source files in parallel,\n"
+  "                             or typecheck the functions of a single\n"
+  "                             source file in parallel\n"
+  " --compilation-cache dir     reuse object files of earlier compilations,\n"
+  "                             stored in dir\n"
+  " --compilation-cache-size n  limit the cache to n MiB (default: 1024)\n"
+  " --compress-goto-binary      write compressed goto binaries\n"
   "\n";
 }
 
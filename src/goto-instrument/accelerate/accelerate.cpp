@@ -21,6 +21,7 @@ Author: Matt Lewis
 
 #include <ansi-c/expr2c.h>
 
+#include <algorithm>
 #include <iostream>
 #include <list>
 
@@ -108,50 +109,72 @@ int acceleratet::accelerate_loop(goto_programt::targett &loop_header)
   make_overflow_loc(loop_header, back_jump, overflow_loc);
   program.update();
 
+  accelerator_cachet::loopt loop_instructions(loop.begin(), loop.end());
+  std::sort(
+    loop_instructions.begin(),
+    loop_instructions.end(),
+    [](goto_programt::targett a, goto_programt::targett b)
+    {
+      return a->location_number<b->location_number;
+    });
+
+  if(cache==nullptr || cache->lookup(loop_instructions, accelerators))
+  {
 #if 1
-  enumerating_loop_accelerationt acceleration(
-    message_handler,
-    symbol_table,
-    goto_functions,
-    program,
-    loop,
-    loop_header,
-    accelerate_limit);
+    enumerating_loop_accelerationt acceleration(
+      message_handler,
+      symbol_table,
+      goto_functions,
+      program,
+      loop,
+      loop_header,
+      accelerate_limit);
 #else
-  disjunctive_polynomial_accelerationt
-    acceleration(symbol_table, goto_functions, program, loop, loop_header);
+    disjunctive_polynomial_accelerationt
+      acceleration(symbol_table, goto_functions, program, loop, loop_header);
 #endif
 
-  path_acceleratort accelerator;
-
-  while(acceleration.accelerate(accelerator) &&
-        (accelerate_limit < 0 ||
-         num_accelerated < accelerate_limit))
-  {
-    // set_dirty_vars(accelerator);
+    path_acceleratort accelerator;
 
-    if(is_underapproximate(accelerator))
+    while(acceleration.accelerate(accelerator) &&
+          (accelerate_limit < 0 ||
+           num_accelerated < accelerate_limit))
     {
-      // We have some underapproximated variables -- just punt for now.
+      // set_dirty_vars(accelerator);
+
+      if(is_underapproximate(accelerator))
+      {
+        // We have some underapproximated variables -- just punt for now.
 #ifdef DEBUG
-      std::cout << "Not inserting accelerator because of underapproximation\n";
+        std::cout
+          << "Not inserting accelerator because of underapproximation\n";
 #endif
 
-      continue;
-    }
+        continue;
+      }
 
-    accelerators.push_back(accelerator);
-    num_accelerated++;
+      accelerators.push_back(accelerator);
+      num_accelerated++;
 
 #ifdef DEBUG
-    std::cout << "Accelerated path:\n";
-    output_path(accelerator.path, program, ns, std::cout);
+      std::cout << "Accelerated path:\n";
+      output_path(accelerator.path, program, ns, std::cout);
 
-    std::cout << "Accelerator has "
-              << accelerator.pure_accelerator.instructions.size()
-              << " instructions\n";
+      std::cout << "Accelerator has "
+                << accelerator.pure_accelerator.instructions.size()
+                << " instructions\n";
 #endif
+    }
+
+    if(cache!=nullptr && cache->store(loop_instructions, accelerators))
+    {
+      messaget message(message_handler);
+      message.warning() << "failed to cache the accelerators of loop "
+                        << loop_header->loop_number << messaget::eom;
+    }
   }
+  else
+    num_accelerated=accelerators.size();
 
   goto_programt::instructiont skip(SKIP);
   program.insert_before_swap(loop_header, skip);
@@ -651,13 +674,25 @@ int acceleratet::accelerate_loops()
 void accelerate_functions(
   goto_modelt &goto_model,
   message_handlert &message_handler,
-  bool use_z3)
+  bool use_z3,
+  const std::string &cache_directory)
 {
+  accelerator_cachet cache(
+    cache_directory,
+    goto_model.goto_functions,
+    goto_model.symbol_table,
+    use_z3,
+    acceleratet::accelerate_limit);
+
   Forall_goto_functions(it, goto_model.goto_functions)
   {
     std::cout << "Accelerating function " << it->first << '\n';
     acceleratet accelerate(
-      it->second.body, goto_model, message_handler, use_z3);
+      it->second.body,
+      goto_model,
+      message_handler,
+      use_z3,
+      cache_directory.empty() ? nullptr : &cache);
 
     int num_accelerated=accelerate.accelerate_loops();
 
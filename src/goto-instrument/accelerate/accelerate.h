@@ -26,6 +26,7 @@ Author: Matt Lewis
 #include "subsumed.h"
 #include "scratch_program.h"
 #include "acceleration_utils.h"
+#include "accelerator_cache.h"
 
 class acceleratet
 {
@@ -34,14 +35,16 @@ public:
     goto_programt &_program,
     goto_modelt &_goto_model,
     message_handlert &message_handler,
-    bool _use_z3)
+    bool _use_z3,
+    accelerator_cachet *_cache=nullptr)
     : message_handler(message_handler),
       program(_program),
       goto_functions(_goto_model.goto_functions),
       symbol_table(_goto_model.symbol_table),
       ns(_goto_model.symbol_table),
       utils(symbol_table, message_handler, goto_functions),
-      use_z3(_use_z3)
+      use_z3(_use_z3),
+      cache(_cache)
   {
     natural_loops(program);
   }
@@ -125,11 +128,17 @@ protected:
   expr_mapt dirty_vars_map;
 
   bool use_z3;
+
+  /// where to look up and store the accelerators of loops, if any
+  accelerator_cachet *cache;
 };
 
+/// \param cache_directory: the directory in which the accelerators are
+///   cached across runs, or the empty string to not cache them
 void accelerate_functions(
   goto_modelt &,
   message_handlert &message_handler,
-  bool use_z3);
+  bool use_z3,
+  const std::string &cache_directory="");
 
 #endif // CPROVER_GOTO_INSTRUMENT_ACCELERATE_ACCELERATE_H
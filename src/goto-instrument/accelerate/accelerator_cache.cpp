@@ -0,0 +1,596 @@
+/*******************************************************************\
+
+Module: Loop Acceleration
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Cache of Loop Accelerators
+
+#include "accelerator_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <new>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+
+#include <util/file_util.h>
+#include <util/irep_hash.h>
+#include <util/irep_serialization.h>
+#include <util/std_code.h>
+#include <util/std_expr.h>
+#include <util/string2int.h>
+#include <util/string_hash.h>
+#include <util/symbol_table.h>
+
+/// To be increased when the format of the cache files changes
+#define ACCELERATOR_CACHE_VERSION "accelerator_cache_2"
+
+/// The module of the auxiliary symbols made by acceleration_utilst
+#define AUXILIARY_MODULE "scratch"
+
+namespace
+{
+/// Renames the auxiliary symbols of the acceleration to names that only
+/// depend on the order of their first occurrence
+class canonical_namest
+{
+public:
+  explicit canonical_namest(const symbol_tablet &_symbol_table):
+    symbol_table(_symbol_table)
+  {
+  }
+
+  /// the auxiliary symbols met so far, in the order of the canonical names
+  std::vector<irep_idt> auxiliary;
+
+  static irep_idt canonical_name(std::size_t n)
+  {
+    return "accelerator_cache::"+std::to_string(n);
+  }
+
+  void operator()(exprt &expr)
+  {
+    if(expr.id()==ID_symbol)
+    {
+      const irep_idt &identifier=to_symbol_expr(expr).get_identifier();
+      const symbolt *symbol=symbol_table.lookup(identifier);
+
+      if(symbol!=nullptr && symbol->module==AUXILIARY_MODULE)
+      {
+        const auto entry=
+          canonical.insert(std::make_pair(identifier, auxiliary.size()));
+        if(entry.second)
+          auxiliary.push_back(identifier);
+        to_symbol_expr(expr).set_identifier(
+          canonical_name(entry.first->second));
+      }
+    }
+
+    Forall_operands(it, expr)
+      (*this)(*it);
+  }
+
+protected:
+  const symbol_tablet &symbol_table;
+  std::map<irep_idt, std::size_t> canonical;
+};
+}
+
+typedef std::map<irep_idt, irep_idt> renamingt;
+
+static void rename(exprt &expr, const renamingt &renaming)
+{
+  if(expr.id()==ID_symbol)
+  {
+    const renamingt::const_iterator entry=
+      renaming.find(to_symbol_expr(expr).get_identifier());
+    if(entry!=renaming.end())
+      to_symbol_expr(expr).set_identifier(entry->second);
+  }
+
+  Forall_operands(it, expr)
+    rename(*it, renaming);
+}
+
+/// A hash that does not depend on the numbering of strings, which differs
+/// between runs, and ignores comments
+static std::size_t stable_hash(const irept &irep)
+{
+  std::size_t result=hash_string(id2string(irep.id()));
+
+  forall_irep(it, irep.get_sub())
+    result=hash_combine(result, stable_hash(*it));
+
+  // named operands are ordered by the numbering of their names
+  std::size_t named_sub_hash=0;
+  forall_named_irep(it, irep.get_named_sub())
+    named_sub_hash+=
+      hash_combine(hash_string(id2string(it->first)), stable_hash(it->second));
+
+  result=hash_combine(result, named_sub_hash);
+
+  return
+    hash_finalize(result, irep.get_sub().size()+irep.get_named_sub().size());
+}
+
+/// Encodes \p instructions, giving their auxiliary symbols canonical names.
+/// Targets are encoded by their index in \p instructions, and targets that
+/// are not among them as `exit`.
+static irept encode_instructions(
+  const std::vector<goto_programt::const_targett> &instructions,
+  canonical_namest &names)
+{
+  std::unordered_map<const goto_programt::instructiont *, std::size_t> index;
+  for(const auto &t : instructions)
+    index.emplace(&*t, index.size());
+
+  irept result("instructions");
+
+  for(const auto &t : instructions)
+  {
+    irept instruction("instruction");
+    instruction.set(ID_type, static_cast<long long>(t->type));
+
+    exprt &code=static_cast<exprt &>(instruction.add(ID_code));
+    code=t->code;
+    names(code);
+
+    exprt &guard=static_cast<exprt &>(instruction.add("guard"));
+    guard=t->guard;
+    names(guard);
+
+    irept::subt &targets=instruction.add("targets").get_sub();
+    for(const auto &target : t->targets)
+    {
+      const auto entry=index.find(&*target);
+      targets.push_back(
+        irept(
+          entry==index.end() ? "exit" : std::to_string(entry->second)));
+    }
+
+    result.get_sub().push_back(instruction);
+  }
+
+  return result;
+}
+
+static irept encode_program(
+  const goto_programt &program,
+  canonical_namest &names)
+{
+  std::vector<goto_programt::const_targett> instructions;
+  forall_goto_program_instructions(it, program)
+    instructions.push_back(it);
+
+  return encode_instructions(instructions, names);
+}
+
+/// Add the functions that \p instructions call to \p dest
+static void called_functions(
+  const std::vector<goto_programt::const_targett> &instructions,
+  std::vector<irep_idt> &dest)
+{
+  for(const auto &t : instructions)
+  {
+    if(!t->is_function_call())
+      continue;
+
+    const exprt &function=to_code_function_call(t->code).function();
+    if(function.id()==ID_symbol)
+      dest.push_back(to_symbol_expr(function).get_identifier());
+  }
+}
+
+/// Add the identifiers of the types that \p irep refers to by tag, and of
+/// all other symbols, to \p dest
+static void referenced_identifiers(
+  const irept &irep,
+  std::set<std::string> &dest)
+{
+  if(irep.id()==ID_symbol ||
+     irep.id()==ID_struct_tag ||
+     irep.id()==ID_union_tag ||
+     irep.id()==ID_c_enum_tag)
+  {
+    const irep_idt &identifier=irep.get(ID_identifier);
+    if(!identifier.empty())
+      dest.insert(id2string(identifier));
+  }
+
+  forall_irep(it, irep.get_sub())
+    referenced_identifiers(*it, dest);
+
+  forall_named_irep(it, irep.get_named_sub())
+    referenced_identifiers(it->second, dest);
+}
+
+/// \param [out] dest: the decimal number in \p src
+/// \return true if \p src is not a decimal number
+static bool decode_index(const irep_idt &src, std::size_t &dest)
+{
+  const std::string &s=id2string(src);
+  if(s.empty() || s.size()>9 ||
+     s.find_first_not_of("0123456789")!=std::string::npos)
+    return true;
+
+  dest=unsafe_string2size_t(s);
+  return false;
+}
+
+/// \return true if \p src is not a valid encoding of a program without
+///   exits
+static bool decode_program(
+  const irept &src,
+  const renamingt &renaming,
+  goto_programt &dest)
+{
+  std::vector<goto_programt::targett> targets;
+
+  forall_irep(it, src.get_sub())
+  {
+    const int type=it->get_int(ID_type);
+    if(type<NO_INSTRUCTION_TYPE || type>CATCH)
+      return true;
+
+    goto_programt::targett t=
+      dest.add_instruction(static_cast<goto_program_instruction_typet>(type));
+
+    t->code=static_cast<const codet &>(it->find(ID_code));
+    rename(t->code, renaming);
+    t->guard=static_cast<const exprt &>(it->find("guard"));
+    rename(t->guard, renaming);
+
+    targets.push_back(t);
+  }
+
+  std::size_t i=0;
+  forall_irep(it, src.get_sub())
+  {
+    forall_irep(t_it, it->find("targets").get_sub())
+    {
+      std::size_t target;
+      if(decode_index(t_it->id(), target) || target>=targets.size())
+        return true;
+      targets[i]->targets.push_back(targets[target]);
+    }
+    ++i;
+  }
+
+  dest.update();
+
+  return false;
+}
+
+/// Encode \p loop together with everything its accelerators depend on: the
+/// functions it calls, the types these refer to by tag, and the options of
+/// the acceleration
+static irept encode_key(
+  const accelerator_cachet::loopt &loop,
+  const goto_functionst &goto_functions,
+  const symbol_tablet &symbol_table,
+  bool use_z3,
+  int accelerate_limit,
+  canonical_namest &names)
+{
+  irept key("key");
+
+  const std::vector<goto_programt::const_targett> loop_instructions(
+    loop.begin(), loop.end());
+  key.add("loop")=encode_instructions(loop_instructions, names);
+
+  std::vector<irep_idt> worklist;
+  called_functions(loop_instructions, worklist);
+
+  // the functions are encoded in the order they are first called
+  std::set<irep_idt> seen;
+  irept::subt &functions=key.add("functions").get_sub();
+
+  while(!worklist.empty())
+  {
+    const irep_idt identifier=worklist.front();
+    worklist.erase(worklist.begin());
+
+    if(!seen.insert(identifier).second)
+      continue;
+
+    irept function("function");
+    function.set(ID_identifier, identifier);
+
+    const goto_functionst::function_mapt::const_iterator f_it=
+      goto_functions.function_map.find(identifier);
+
+    if(f_it!=goto_functions.function_map.end() &&
+       f_it->second.body_available())
+    {
+      std::vector<goto_programt::const_targett> instructions;
+      forall_goto_program_instructions(it, f_it->second.body)
+        instructions.push_back(it);
+
+      function.add(ID_code)=encode_instructions(instructions, names);
+      called_functions(instructions, worklist);
+    }
+
+    functions.push_back(function);
+  }
+
+  // the types are found by name, which is independent of the numbering of
+  // strings, and encoded in the order of their names
+  std::set<std::string> identifiers;
+  referenced_identifiers(key, identifiers);
+
+  std::map<std::string, typet> types;
+  while(!identifiers.empty())
+  {
+    const std::string identifier=*identifiers.begin();
+    identifiers.erase(identifiers.begin());
+
+    const symbolt *symbol=symbol_table.lookup(identifier);
+    if(symbol==nullptr ||
+       !symbol->is_type ||
+       !types.insert(std::make_pair(identifier, symbol->type)).second)
+      continue;
+
+    std::set<std::string> nested;
+    referenced_identifiers(symbol->type, nested);
+    for(const auto &n : nested)
+      if(types.find(n)==types.end())
+        identifiers.insert(n);
+  }
+
+  irept::subt &encoded_types=key.add("types").get_sub();
+  for(const auto &type : types)
+  {
+    irept encoded_type(ID_type);
+    encoded_type.set(ID_identifier, type.first);
+    encoded_type.add(ID_type)=type.second;
+    encoded_types.push_back(encoded_type);
+  }
+
+  key.set("use_z3", use_z3);
+  key.set("accelerate_limit", accelerate_limit);
+
+  return key;
+}
+
+std::string accelerator_cachet::file_name(const irept &key) const
+{
+  std::ostringstream name;
+  name << std::hex << stable_hash(key) << ".acc";
+  return concat_dir_file(directory, name.str());
+}
+
+/// Read the cache entry in the file \p file_name
+/// \return true if the file cannot be read or is corrupt
+static bool read_entry(const std::string &file_name, irept &entry)
+{
+  std::ifstream in(file_name, std::ios::binary);
+  if(!in)
+    return true;
+
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt serialization(ireps_container);
+
+  try
+  {
+    serialization.reference_convert(in, entry);
+  }
+
+  catch(int)
+  {
+    return true;
+  }
+
+  catch(const char *)
+  {
+    return true;
+  }
+
+  catch(const std::bad_alloc &)
+  {
+    return true;
+  }
+
+  return !in;
+}
+
+bool accelerator_cachet::lookup(
+  const loopt &loop,
+  std::list<path_acceleratort> &accelerators)
+{
+  canonical_namest names(symbol_table);
+  const irept key=encode_key(
+    loop, goto_functions, symbol_table, use_z3, accelerate_limit, names);
+
+  // the file may be the entry of another loop with the same hash, or be
+  // corrupt, which are cache misses
+  irept entry;
+  if(read_entry(file_name(key), entry) ||
+     entry.id()!=ACCELERATOR_CACHE_VERSION ||
+     entry.find("key")!=key)
+    return true;
+
+  // the auxiliary symbols of the loop keep their names, the others are
+  // added to the symbol table once the entry is decoded
+  renamingt renaming;
+  symbol_tablet new_symbols;
+  std::size_t n=0;
+  forall_irep(it, entry.find("symbols").get_sub())
+  {
+    const irep_idt canonical=canonical_namest::canonical_name(n);
+
+    if(n<names.auxiliary.size())
+      renaming[canonical]=names.auxiliary[n];
+    else
+    {
+      symbolt symbol;
+      symbol.module=AUXILIARY_MODULE;
+      symbol.type=static_cast<const typet &>(it->find(ID_type));
+
+      std::size_t suffix=0;
+      do
+      {
+        symbol.name=
+          id2string(it->get(ID_base_name))+"_cached_"+std::to_string(suffix++);
+      }
+      while(symbol_table.has_symbol(symbol.name) ||
+            new_symbols.has_symbol(symbol.name));
+
+      symbol.base_name=symbol.name;
+      symbol.pretty_name=symbol.name;
+      new_symbols.add(symbol);
+
+      renaming[canonical]=symbol.name;
+    }
+
+    ++n;
+  }
+
+  std::list<path_acceleratort> result;
+
+  forall_irep(it, entry.find("accelerators").get_sub())
+  {
+    result.push_back(path_acceleratort());
+    path_acceleratort &accelerator=result.back();
+
+    forall_irep(p_it, it->find("path").get_sub())
+    {
+      std::size_t index;
+      if(decode_index(p_it->get(ID_index), index) || index>=loop.size())
+        return true;
+
+      exprt guard=static_cast<const exprt &>(p_it->find("guard"));
+      rename(guard, renaming);
+      accelerator.path.push_back(path_nodet(loop[index], guard));
+    }
+
+    if(decode_program(
+         it->find("pure"), renaming, accelerator.pure_accelerator) ||
+       decode_program(
+         it->find("overflow"), renaming, accelerator.overflow_path))
+      return true;
+
+    forall_irep(e_it, it->find("changed").get_sub())
+    {
+      exprt expr=static_cast<const exprt &>(*e_it);
+      rename(expr, renaming);
+      accelerator.changed_vars.insert(expr);
+    }
+
+    forall_irep(e_it, it->find("dirty").get_sub())
+    {
+      exprt expr=static_cast<const exprt &>(*e_it);
+      rename(expr, renaming);
+      accelerator.dirty_vars.insert(expr);
+    }
+  }
+
+  for(const auto &symbol_pair : new_symbols.symbols)
+    symbol_table.add(symbol_pair.second);
+
+  accelerators.splice(accelerators.end(), result);
+
+  return false;
+}
+
+bool accelerator_cachet::store(
+  const loopt &loop,
+  const std::list<path_acceleratort> &accelerators)
+{
+  canonical_namest names(symbol_table);
+  const irept key=encode_key(
+    loop, goto_functions, symbol_table, use_z3, accelerate_limit, names);
+
+  std::unordered_map<const goto_programt::instructiont *, std::size_t> index;
+  for(const auto &t : loop)
+    index.emplace(&*t, index.size());
+
+  irept entry(ACCELERATOR_CACHE_VERSION);
+  entry.add("key")=key;
+
+  irept::subt &encoded_accelerators=entry.add("accelerators").get_sub();
+
+  for(const auto &accelerator : accelerators)
+  {
+    irept encoded("accelerator");
+
+    irept::subt &path=encoded.add("path").get_sub();
+    for(const auto &node : accelerator.path)
+    {
+      const auto node_index=index.find(&*node.loc);
+      if(node_index==index.end())
+        return true;
+
+      irept encoded_node("node");
+      encoded_node.set(ID_index, std::to_string(node_index->second));
+      exprt &guard=static_cast<exprt &>(encoded_node.add("guard"));
+      guard=node.guard;
+      names(guard);
+      path.push_back(encoded_node);
+    }
+
+    encoded.add("pure")=encode_program(accelerator.pure_accelerator, names);
+    encoded.add("overflow")=encode_program(accelerator.overflow_path, names);
+
+    for(const auto &expr : accelerator.changed_vars)
+    {
+      exprt e=expr;
+      names(e);
+      encoded.add("changed").get_sub().push_back(e);
+    }
+
+    for(const auto &expr : accelerator.dirty_vars)
+    {
+      exprt e=expr;
+      names(e);
+      encoded.add("dirty").get_sub().push_back(e);
+    }
+
+    encoded_accelerators.push_back(encoded);
+  }
+
+  // the symbols the accelerators introduce are made afresh on lookup
+  irept::subt &symbols=entry.add("symbols").get_sub();
+  for(const auto &identifier : names.auxiliary)
+  {
+    const symbolt &symbol=symbol_table.lookup_ref(identifier);
+
+    // strip the number that makes the name unique
+    std::string base_name=id2string(identifier);
+    const std::size_t end=base_name.find_last_not_of("0123456789");
+    if(end!=std::string::npos && base_name[end]=='_')
+      base_name.resize(end);
+
+    irept encoded_symbol("symbol");
+    encoded_symbol.set(ID_base_name, base_name);
+    encoded_symbol.add(ID_type)=symbol.type;
+    symbols.push_back(encoded_symbol);
+  }
+
+  // write to a temporary file first, so that an interrupted run does not
+  // leave a partial entry
+  const std::string name=file_name(key);
+  const std::string tmp_name=name+".tmp";
+
+  std::ofstream out(tmp_name, std::ios::binary);
+  if(!out)
+    return true;
+
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt serialization(ireps_container);
+  serialization.reference_convert(entry, out);
+  out.close();
+
+  if(!out || std::rename(tmp_name.c_str(), name.c_str())!=0)
+  {
+    std::remove(tmp_name.c_str());
+    return true;
+  }
+
+  return false;
+}
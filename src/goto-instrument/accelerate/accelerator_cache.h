@@ -0,0 +1,78 @@
+/*******************************************************************\
+
+Module: Loop Acceleration
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Cache of Loop Accelerators
+
+#ifndef CPROVER_GOTO_INSTRUMENT_ACCELERATE_ACCELERATOR_CACHE_H
+#define CPROVER_GOTO_INSTRUMENT_ACCELERATE_ACCELERATOR_CACHE_H
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include <goto-programs/goto_functions.h>
+
+#include "accelerator.h"
+
+class symbol_tablet;
+
+/// Stores the accelerators computed for loops in a directory, so that later
+/// runs can reuse them for loops with the same code instead of enumerating
+/// and accelerating their paths again.
+///
+/// An entry is keyed by the code of the loop, the bodies of the functions it
+/// calls, directly or indirectly, the definitions of the types these refer
+/// to by tag, and the options of the acceleration. The code is compared
+/// after renaming the auxiliary symbols introduced by the acceleration,
+/// whose names depend on the order in which loops are accelerated; source
+/// locations and the targets of jumps out of the loop are ignored. Other
+/// edits to the program thus keep the cached accelerators of a loop valid.
+class accelerator_cachet
+{
+public:
+  /// The instructions of a loop, in program order
+  typedef std::vector<goto_programt::targett> loopt;
+
+  accelerator_cachet(
+    const std::string &_directory,
+    const goto_functionst &_goto_functions,
+    symbol_tablet &_symbol_table,
+    bool _use_z3,
+    int _accelerate_limit):
+    directory(_directory),
+    goto_functions(_goto_functions),
+    symbol_table(_symbol_table),
+    use_z3(_use_z3),
+    accelerate_limit(_accelerate_limit)
+  {
+  }
+
+  /// Find the accelerators of \p loop in the cache. The paths of the
+  /// accelerators refer to the instructions of \p loop, and the auxiliary
+  /// symbols they introduce are added to the symbol table.
+  /// \return true if the loop is not in the cache
+  bool lookup(const loopt &loop, std::list<path_acceleratort> &accelerators);
+
+  /// Store the accelerators of \p loop in the cache
+  /// \return true if they cannot be stored
+  bool store(
+    const loopt &loop,
+    const std::list<path_acceleratort> &accelerators);
+
+protected:
+  const std::string directory;
+  const goto_functionst &goto_functions;
+  symbol_tablet &symbol_table;
+  const bool use_z3;
+  const int accelerate_limit;
+
+  std::string file_name(const irept &key) const;
+};
+
+#endif // CPROVER_GOTO_INSTRUMENT_ACCELERATE_ACCELERATOR_CACHE_H
@@ -322,8 +322,13 @@ void full_slicert::operator()(
     }
   }
 
-  // compute program dependence graph (and post-dominators)
-  dependence_grapht dep_graph(ns);
+  // compute program dependence graph (and post-dominators, unless they are
+  // cached from a previous pass and the function has not changed since)
+  post_dominators_cachet local_post_dominators_cache;
+  dependence_grapht dep_graph(
+    ns,
+    post_dominators_cache!=nullptr ?
+      *post_dominators_cache : local_post_dominators_cache);
   dep_graph(goto_functions, ns);
 
   // compute the fixedpoint
@@ -375,6 +380,16 @@ void full_slicer(
   full_slicert()(goto_functions, ns, criterion);
 }
 
+void full_slicer(
+  goto_functionst &goto_functions,
+  const namespacet &ns,
+  slicing_criteriont &criterion,
+  post_dominators_cachet &post_dominators_cache)
+{
+  full_slicert slicer(post_dominators_cache);
+  slicer(goto_functions, ns, criterion);
+}
+
 void full_slicer(
   goto_functionst &goto_functions,
   const namespacet &ns)
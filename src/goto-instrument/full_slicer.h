@@ -14,6 +14,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <goto-programs/goto_model.h>
 
+class post_dominators_cachet;
+
 void full_slicer(
   goto_functionst &,
   const namespacet &);
@@ -41,4 +43,13 @@ void full_slicer(
   const namespacet &ns,
   slicing_criteriont &criterion);
 
+/// As above, but reuse post-dominators from \p post_dominators_cache for all
+/// functions whose control flow is unchanged since a previous slicing pass
+/// that used the same cache
+void full_slicer(
+  goto_functionst &goto_functions,
+  const namespacet &ns,
+  slicing_criteriont &criterion,
+  post_dominators_cachet &post_dominators_cache);
+
 #endif // CPROVER_GOTO_INSTRUMENT_FULL_SLICER_H
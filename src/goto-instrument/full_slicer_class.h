@@ -38,6 +38,17 @@ echo 'digraph g {' > c.dot ; cat c.goto | \
 class full_slicert
 {
 public:
+  full_slicert():post_dominators_cache(nullptr)
+  {
+  }
+
+  /// Use (and update) \p _post_dominators_cache rather than computing the
+  /// post-dominators of all functions from scratch
+  explicit full_slicert(post_dominators_cachet &_post_dominators_cache):
+    post_dominators_cache(&_post_dominators_cache)
+  {
+  }
+
   void operator()(
     goto_functionst &goto_functions,
     const namespacet &ns,
@@ -59,6 +70,8 @@ protected:
   typedef cfg_baset<cfg_nodet> cfgt;
   cfgt cfg;
 
+  post_dominators_cachet *post_dominators_cache;
+
   typedef std::vector<cfgt::entryt> dep_node_to_cfgt;
   typedef std::stack<cfgt::entryt> queuet;
   typedef std::list<cfgt::entryt> jumpst;
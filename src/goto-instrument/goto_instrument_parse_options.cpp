@@ -20,6 +20,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/unicode.h>
 #include <util/json.h>
 #include <util/exit_codes.h>
+#include <util/make_unique.h>
 
 #include <goto-programs/class_hierarchy.h>
 #include <goto-programs/goto_convert_functions.h>
@@ -45,9 +46,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/show_symbol_table.h>
 
 #include <pointer-analysis/value_set_analysis.h>
+#include <pointer-analysis/demand_driven_value_sets.h>
 #include <pointer-analysis/goto_program_dereference.h>
 #include <pointer-analysis/add_failed_symbols.h>
 #include <pointer-analysis/show_value_sets.h>
+#include <pointer-analysis/unification_value_sets.h>
 
 #include <analyses/natural_loops.h>
 #include <analyses/global_may_alias.h>
@@ -704,7 +707,10 @@ int goto_instrument_parse_optionst::doit()
 
       status() << "Accelerating" << eom;
       accelerate_functions(
-        goto_model, get_message_handler(), cmdline.isset("z3"));
+        goto_model,
+        get_message_handler(),
+        cmdline.isset("z3"),
+        cmdline.get_value("accelerator-cache"));
       remove_skip(goto_model);
       goto_model.goto_functions.update();
     }
@@ -757,7 +763,11 @@ int goto_instrument_parse_optionst::doit()
       status() << "Writing GOTO program to `" << cmdline.args[1] << "'" << eom;
 
       if(write_goto_binary(
-        cmdline.args[1], goto_model, get_message_handler()))
+        cmdline.args[1],
+        goto_model,
+        get_message_handler(),
+        cmdline.isset("compress-goto-binary") ?
+          GOTO_BINARY_COMPRESSED_VERSION : GOTO_BINARY_VERSION))
         return CPROVER_EXIT_CONVERSION_FAILED;
       else
         return CPROVER_EXIT_SUCCESS;
@@ -1165,20 +1175,39 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     do_indirect_call_and_rtti_removal();
 
     status() << "Pointer Analysis" << eom;
-    value_set_analysist value_set_analysis(ns);
-    value_set_analysis(goto_model.goto_functions);
+    std::unique_ptr<value_setst> value_sets;
+    if(cmdline.isset("demand-driven-points-to"))
+    {
+      auto demand_driven_value_sets=
+        util_make_unique<demand_driven_value_setst>(ns);
+      (*demand_driven_value_sets)(goto_model.goto_functions);
+      value_sets=std::move(demand_driven_value_sets);
+    }
+    else if(cmdline.isset("unification-points-to"))
+    {
+      auto unification_value_sets=
+        util_make_unique<unification_value_setst>(ns);
+      (*unification_value_sets)(goto_model.goto_functions);
+      value_sets=std::move(unification_value_sets);
+    }
+    else
+    {
+      auto value_set_analysis=util_make_unique<value_set_analysist>(ns);
+      (*value_set_analysis)(goto_model.goto_functions);
+      value_sets=std::move(value_set_analysis);
+    }
 
     if(cmdline.isset("remove-pointers"))
     {
       // removing pointers
       status() << "Removing Pointers" << eom;
-      remove_pointers(goto_model, value_set_analysis);
+      remove_pointers(goto_model, *value_sets);
     }
 
     if(cmdline.isset("race-check"))
     {
       status() << "Adding Race Checks" << eom;
-      race_check(value_set_analysis, goto_model);
+      race_check(*value_sets, goto_model);
     }
 
     if(cmdline.isset("mm"))
@@ -1198,6 +1227,8 @@ void goto_instrument_parse_optionst::instrument_goto_program()
         inst_strategy=one_event_per_cycle;
       else if(cmdline.isset("minimum-interference"))
         inst_strategy=min_interference;
+      else if(cmdline.isset("greedy-interference"))
+        inst_strategy=greedy_interference;
       else if(cmdline.isset("read-first"))
         inst_strategy=read_first;
       else if(cmdline.isset("write-first"))
@@ -1217,6 +1248,9 @@ void goto_instrument_parse_optionst::instrument_goto_program()
       const unsigned max_po_trans=
         cmdline.isset("max-po-trans")?
         unsafe_string2unsigned(cmdline.get_value("max-po-trans")):0;
+      const unsigned max_cycles=
+        cmdline.isset("max-cycles")?
+        unsafe_string2unsigned(cmdline.get_value("max-cycles")):0;
 
       if(mm=="tso")
       {
@@ -1254,7 +1288,7 @@ void goto_instrument_parse_optionst::instrument_goto_program()
       if(model!=Unknown)
         weak_memory(
           model,
-          value_set_analysis,
+          *value_sets,
           goto_model,
           cmdline.isset("scc"),
           inst_strategy,
@@ -1264,6 +1298,7 @@ void goto_instrument_parse_optionst::instrument_goto_program()
           loops,
           max_var,
           max_po_trans,
+          max_cycles,
           !cmdline.isset("no-po-rendering"),
           cmdline.isset("render-cluster-file"),
           cmdline.isset("render-cluster-function"),
@@ -1278,7 +1313,7 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     {
       status() << "Instrumenting interrupt handler" << eom;
       interrupt(
-        value_set_analysis,
+        *value_sets,
         goto_model,
         cmdline.get_value("isr"));
     }
@@ -1287,13 +1322,13 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     if(cmdline.isset("mmio"))
     {
       status() << "Instrumenting memory-mapped I/O" << eom;
-      mmio(value_set_analysis, goto_model);
+      mmio(*value_sets, goto_model);
     }
 
     if(cmdline.isset("concurrency"))
     {
       status() << "Sequentializing concurrency" << eom;
-      concurrency(value_set_analysis, goto_model);
+      concurrency(*value_sets, goto_model);
     }
   }
 
@@ -1483,6 +1518,9 @@ void goto_instrument_parse_optionst::help()
     " --error-label label          check that label is unreachable\n"
     " --stack-depth n              add check that call stack size of non-inlined functions never exceeds n\n" // NOLINT(*)
     " --race-check                 add floating-point data race checks\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --demand-driven-points-to    use a demand-driven, flow-insensitive pointer analysis for --race-check, --mm, --isr, --mmio, --concurrency and --remove-pointers\n"
+    " --unification-points-to      use a fast, unification-based pointer analysis instead\n" // NOLINT(*)
     "\n"
     "Semantic transformations:\n"
     " --nondet-volatile            makes reads from volatile variables non-deterministic\n" // NOLINT(*)
@@ -1509,13 +1547,17 @@ void goto_instrument_parse_optionst::help()
     " --base-case                  k-induction: do base-case\n"
     " --havoc-loops                over-approximate all loops\n"
     " --accelerate                 add loop accelerators\n"
+    " --accelerator-cache <dir>    reuse the accelerators of loops stored in dir\n" // NOLINT(*)
     " --skip-loops <loop-ids>      add gotos to skip selected loops during execution\n" // NOLINT(*)
     "\n"
     "Memory model instrumentations:\n"
     " --mm <tso,pso,rmo,power>     instruments a weak memory model\n"
     " --scc                        detects critical cycles per SCC (one thread per SCC)\n" // NOLINT(*)
+    " --max-cycles <n>             stops collecting critical cycles after n cycles\n" // NOLINT(*)
     " --one-event-per-cycle        only instruments one event per cycle\n"
     " --minimum-interference       instruments an optimal number of events\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --greedy-interference        instruments a near-optimal number of events\n"
     " --my-events                  only instruments events whose ids appear in inst.evt\n" // NOLINT(*)
     " --cfg-kill                   enables symbolic execution used to reduce spurious cycles\n" // NOLINT(*)
     " --no-dependencies            no dependency analysis\n"
@@ -1549,6 +1591,7 @@ void goto_instrument_parse_optionst::help()
     " --no-system-headers          with --dump-c/--dump-cpp: generate C source expanding libc includes\n" // NOLINT(*)
     " --use-all-headers            with --dump-c/--dump-cpp: generate C source with all includes\n" // NOLINT(*)
     " --harness                    with --dump-c/--dump-cpp: include input generator in output\n" // NOLINT(*)
+    " --compress-goto-binary       write a compressed goto binary\n"
     " --version                    show version and exit\n"
     HELP_FLUSH
     " --xml-ui                     use XML-formatted output\n"
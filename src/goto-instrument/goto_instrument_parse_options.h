@@ -42,12 +42,14 @@ Author: Daniel Kroening, kroening@kroening.com
   "(assert-to-assume)" \
   "(no-assertions)(no-assumptions)(uninitialized-check)" \
   "(race-check)(scc)(one-event-per-cycle)" \
-  "(minimum-interference)" \
+  "(demand-driven-points-to)" \
+  "(unification-points-to)" \
+  "(minimum-interference)(greedy-interference)" \
   "(mm):(my-events)" \
   "(unwind):(unwindset):(unwindset-file):" \
   "(unwinding-assertions)(partial-loops)(continue-as-loops)" \
   "(log):" \
-  "(max-var):(max-po-trans):(ignore-arrays)" \
+  "(max-var):(max-po-trans):(max-cycles):(ignore-arrays)" \
   "(cfg-kill)(no-dependencies)(force-loop-duplication)" \
   "(call-graph)(reachable-call-graph)" \
   "(class-hierarchy)" \
@@ -77,7 +79,7 @@ Author: Daniel Kroening, kroening@kroening.com
   "(show-natural-loops)(accelerate)(havoc-loops)" \
   "(error-label):(string-abstraction)" \
   "(verbosity):(version)(xml-ui)(json-ui)(show-loops)" \
-  "(accelerate)(constant-propagator)" \
+  "(accelerate)(accelerator-cache):(constant-propagator)" \
   "(k-induction):(step-case)(base-case)" \
   "(show-call-sequences)(check-call-sequence)" \
   "(interpreter)(show-reaching-definitions)(count-eloc)(list-eloc)" \
@@ -86,6 +88,7 @@ Author: Daniel Kroening, kroening@kroening.com
   "(horn)(skip-loops):(apply-code-contracts)(model-argc-argv):" \
   "(show-threaded)(list-calls-args)(print-path-lengths)" \
   "(undefined-function-is-assume-false)" \
+  "(compress-goto-binary)" \
   "(remove-function-body):"\
   OPT_FLUSH \
   "(splice-call):" \
@@ -0,0 +1,93 @@
+/*******************************************************************\
+
+Module: Objects Not Accessed Concurrently by Threads
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Objects Not Accessed Concurrently by Threads
+
+#include "thread_independence.h"
+
+#include <util/cprover_prefix.h>
+#include <util/find_symbols.h>
+#include <util/prefix.h>
+
+#include <goto-programs/goto_model.h>
+
+#include <pointer-analysis/value_set_analysis_fi.h>
+
+#include <analyses/dirty.h>
+#include <analyses/is_threaded.h>
+
+#include "rw_set.h"
+
+std::unordered_set<irep_idt> thread_independent_objects(
+  const goto_modelt &goto_model)
+{
+  std::unordered_set<irep_idt> result;
+
+  const is_threadedt is_threaded(goto_model);
+  if(!is_threaded())
+    return result;
+
+  const namespacet ns(goto_model.symbol_table);
+
+  value_set_analysis_fit value_sets(ns);
+  value_sets(goto_model.goto_functions);
+
+  // objects whose address is taken may be accessed through pointers that the
+  // value sets do not track precisely
+  const dirtyt dirty(goto_model.goto_functions);
+
+  std::unordered_set<irep_idt> threaded_reads, threaded_writes;
+
+  forall_goto_functions(f_it, goto_model.goto_functions)
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      if(!is_threaded(i_it))
+        continue;
+
+      if(i_it->is_other())
+      {
+        // not covered by rw_set, assume any access
+        find_symbols_sett symbols;
+        find_symbols(i_it->code, symbols);
+        threaded_reads.insert(symbols.begin(), symbols.end());
+        threaded_writes.insert(symbols.begin(), symbols.end());
+        continue;
+      }
+
+      rw_set_loct rw_set(ns, value_sets, i_it);
+
+      forall_rw_set_r_entries(r_it, rw_set)
+        threaded_reads.insert(r_it->second.symbol_expr.get_identifier());
+
+      forall_rw_set_w_entries(w_it, rw_set)
+        threaded_writes.insert(w_it->second.symbol_expr.get_identifier());
+    }
+
+  for(const auto &symbol_pair : goto_model.symbol_table.symbols)
+  {
+    const symbolt &symbol=symbol_pair.second;
+
+    // objects of the CPROVER library may be accessed by symex itself
+    if(!symbol.is_static_lifetime ||
+       symbol.is_thread_local ||
+       symbol.is_type ||
+       symbol.type.id()==ID_code ||
+       has_prefix(id2string(symbol.name), CPROVER_PREFIX) ||
+       dirty(symbol.name))
+      continue;
+
+    if(threaded_reads.find(symbol.name)!=threaded_reads.end() &&
+       threaded_writes.find(symbol.name)!=threaded_writes.end())
+      continue;
+
+    result.insert(symbol.name);
+  }
+
+  return result;
+}
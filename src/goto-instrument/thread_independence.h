@@ -0,0 +1,31 @@
+/*******************************************************************\
+
+Module: Objects Not Accessed Concurrently by Threads
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Objects Not Accessed Concurrently by Threads
+
+#ifndef CPROVER_GOTO_INSTRUMENT_THREAD_INDEPENDENCE_H
+#define CPROVER_GOTO_INSTRUMENT_THREAD_INDEPENDENCE_H
+
+#include <unordered_set>
+
+#include <util/irep.h>
+
+class goto_modelt;
+
+/// Find the objects with static lifetime whose accesses are independent of
+/// the interleaving of threads: those whose address is never taken, and
+/// which are not both read and written at locations that may run while
+/// other threads do. Such an object is either only assigned before any
+/// thread is started, or its value is never read once threads may run.
+/// \return the identifiers of the objects, which is empty if the program
+///   does not start any threads
+std::unordered_set<irep_idt> thread_independent_objects(
+  const goto_modelt &goto_model);
+
+#endif // CPROVER_GOTO_INSTRUMENT_THREAD_INDEPENDENCE_H
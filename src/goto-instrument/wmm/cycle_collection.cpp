@@ -47,6 +47,43 @@ void event_grapht::graph_explorert::filter_thin_air(
 #endif
 }
 
+/// computes the SCCs of the po and com transitions between the events which
+/// are not filtered out
+void event_grapht::graph_explorert::compute_SCCs()
+{
+  grapht<graph_nodet<empty_edget> > transitions;
+  transitions.resize(egraph.size());
+
+  for(event_idt e=0; e<egraph.size(); e++)
+  {
+    if(filtering(e))
+      continue;
+
+    for(const auto &edge : egraph.po_out(e))
+      if(!filtering(edge.first))
+        transitions.add_edge(e, edge.first);
+
+    for(const auto &edge : egraph.com_out(e))
+      if(!filtering(edge.first))
+        transitions.add_edge(e, edge.first);
+  }
+
+  const std::size_t number_of_sccs=transitions.SCCs(scc_of);
+
+  scc_size.assign(number_of_sccs, 0);
+  for(event_idt e=0; e<egraph.size(); e++)
+    if(!filtering(e))
+      scc_size[scc_of[e]]++;
+}
+
+void event_grapht::graph_explorert::insert_cycle(
+  std::set<critical_cyclet> &set_of_cycles,
+  const critical_cyclet &new_cycle)
+{
+  if(set_of_cycles.insert(new_cycle).second)
+    egraph.cycles_collected++;
+}
+
 /// Tarjan 1972 adapted and modified for events
 void event_grapht::graph_explorert::collect_cycles(
   std::set<critical_cyclet> &set_of_cycles,
@@ -82,16 +119,33 @@ void event_grapht::graph_explorert::collect_cycles(
   if(order->empty())
     return;
 
+  compute_SCCs();
+
+  /* an event appears in the order once per outgoing edge, but exploring
+     from it again finds no new cycle */
+  std::set<event_idt> explored;
+
   for(std::list<event_idt>::const_iterator
       st_it=order->begin();
-      st_it!=order->end();
+      st_it!=order->end() && !egraph.max_cycles_reached();
       ++st_it)
   {
     event_idt source=*st_it;
+
+    /* a critical cycle has at least four events */
+    if(scc_size[scc_of[source]]<4 || !explored.insert(source).second)
+      continue;
+
     egraph.message.debug() << "explore " << egraph[source].id << messaget::eom;
+    const std::size_t cycles_before=set_of_cycles.size();
     backtrack(set_of_cycles, source, source,
       false, max_po_trans, false, false, false, "", model);
 
+    if(set_of_cycles.size()!=cycles_before)
+      egraph.message.progress() << set_of_cycles.size()
+        << " cycles collected, " << explored.size() << " events explored"
+        << messaget::eom;
+
     while(!marked_stack.empty())
     {
       event_idt up=marked_stack.top();
@@ -196,6 +250,10 @@ bool event_grapht::graph_explorert::backtrack(
   if(filtering(vertex))
     return false;
 
+  /* the events of other SCCs cannot lead back to the source */
+  if(scc_of[vertex]!=scc_of[source] || egraph.max_cycles_reached())
+    return false;
+
   egraph.message.debug() << "bcktck "<<egraph[vertex].id<<"#"<<vertex<<", "
     <<egraph[source].id<<"#"<<source<<" lw:"<<lwfence_met<<" unsafe:"
     <<unsafe_met << messaget::eom;
@@ -390,7 +448,7 @@ bool event_grapht::graph_explorert::backtrack(
           {
             egraph.message.debug() << new_cycle.print_name(model, false)
               << messaget::eom;
-            set_of_cycles.insert(new_cycle);
+            insert_cycle(set_of_cycles, new_cycle);
 #if 0
             const critical_cyclet* reduced=new_cycle.hide_internals();
             set_of_cycles.insert(*reduced);
@@ -443,7 +501,7 @@ bool event_grapht::graph_explorert::backtrack(
           {
             egraph.message.debug() << new_cycle.print_name(model, false)
               << messaget::eom;
-            set_of_cycles.insert(new_cycle);
+            insert_cycle(set_of_cycles, new_cycle);
 #if 0
             const critical_cyclet* reduced=new_cycle.hide_internals();
             set_of_cycles.insert(*reduced);
@@ -17,6 +17,7 @@ Date: 2012
 #include <list>
 #include <set>
 #include <map>
+#include <vector>
 #include <iosfwd>
 
 #include <util/graph.h>
@@ -247,6 +248,11 @@ protected:
   unsigned max_po_trans;
   bool ignore_arrays;
 
+  /* maximal number of cycles to collect (0 for no limit), and number of
+     cycles collected so far, over all the explorations */
+  std::size_t max_cycles;
+  std::size_t cycles_collected;
+
   /* graph explorer (for each cycles collection) */
   class graph_explorert
   {
@@ -291,6 +297,20 @@ protected:
        indirect thin-air */
     void filter_thin_air(std::set<critical_cyclet> &set_of_cycles);
 
+    /* SCC of each event in the po and com transitions between the events not
+       filtered out, and number of such events per SCC: a cycle through an
+       event only visits events of its SCC */
+    std::vector<std::size_t> scc_of;
+    std::vector<std::size_t> scc_size;
+
+    void compute_SCCs();
+
+    /* records a new cycle, and stops the collection once the maximal number
+       of cycles is reached */
+    void insert_cycle(
+      std::set<critical_cyclet> &set_of_cycles,
+      const critical_cyclet &new_cycle);
+
   public:
     graph_explorert(
       event_grapht &_egraph,
@@ -385,6 +405,8 @@ public:
     max_var(0),
     max_po_trans(0),
     ignore_arrays(false),
+    max_cycles(0),
+    cycles_collected(0),
     filter_thin_air(true),
     filter_uniproc(true),
     message(_message)
@@ -575,6 +597,18 @@ public:
     ignore_arrays = _ignore_arrays;
   }
 
+  /* stops the collection of cycles after _max_cycles cycles (0 for no
+     limit) */
+  void set_max_cycles(std::size_t _max_cycles)
+  {
+    max_cycles=_max_cycles;
+  }
+
+  bool max_cycles_reached() const
+  {
+    return max_cycles!=0 && cycles_collected>=max_cycles;
+  }
+
   /* collects all the pairs of events with respectively at least one cmp,
      regardless of the architecture (Pensieve'05 strategy) */
   void collect_pairs(namespacet &ns)
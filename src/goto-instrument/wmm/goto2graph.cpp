@@ -1532,7 +1532,7 @@ void instrumentert::collect_cycles_by_SCCs(memory_modelt model)
   set_of_cycles_per_SCC.resize(num_sccs,
     std::set<event_grapht::critical_cyclet>());
   for(std::vector<std::set<event_idt> >::const_iterator it=egraph_SCCs.begin();
-    it!=egraph_SCCs.end(); it++)
+    it!=egraph_SCCs.end() && !egraph.max_cycles_reached(); it++)
     if(it->size()>=4)
       egraph.collect_cycles(set_of_cycles_per_SCC[scc++], model, *it);
 }
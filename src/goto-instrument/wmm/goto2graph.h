@@ -71,6 +71,8 @@ protected:
     const set_of_cyclest &set);
   void inline instrument_minimum_interference_inserter(
     const set_of_cyclest &set);
+  void inline instrument_greedy_interference_inserter(
+    const set_of_cyclest &set);
   void inline instrument_my_events_inserter(
     const set_of_cyclest &set, const std::set<event_idt> &events);
 
@@ -15,6 +15,8 @@ Date: 2012
 
 #include <string>
 #include <fstream>
+#include <queue>
+#include <vector>
 
 #ifdef HAVE_GLPK
 #include <glpk.h>
@@ -40,6 +42,9 @@ void instrumentert::instrument_with_strategy(instrumentation_strategyt strategy)
       case min_interference:
         instrument_minimum_interference_inserter(set_of_cycles);
         break;
+      case greedy_interference:
+        instrument_greedy_interference_inserter(set_of_cycles);
+        break;
       case read_first:
         instrument_one_read_per_cycle_inserter(set_of_cycles);
         break;
@@ -65,6 +70,9 @@ void instrumentert::instrument_with_strategy(instrumentation_strategyt strategy)
         case min_interference:
           instrument_minimum_interference_inserter(set_of_cycles_per_SCC[i]);
           break;
+        case greedy_interference:
+          instrument_greedy_interference_inserter(set_of_cycles_per_SCC[i]);
+          break;
         case read_first:
           instrument_one_read_per_cycle_inserter(set_of_cycles_per_SCC[i]);
           break;
@@ -349,6 +357,109 @@ void inline instrumentert::instrument_minimum_interference_inserter(
 #endif
 }
 
+void inline instrumentert::instrument_greedy_interference_inserter(
+  const std::set<event_grapht::critical_cyclet> &set_of_cycles)
+{
+  /* Idea:
+     Approximates the problem solved by the minimum interference strategy
+     without an ILP solver: the pairs to instrument must hit every cycle,
+     and we pick greedily the pair that hits the most cycles not yet hit
+     per unit of cost, which is within a logarithmic factor of the optimum.
+
+     The gain of a pair only decreases as pairs are picked, so the gains in
+     the priority queue are upper bounds, and only the pair on top needs to
+     be re-evaluated (lazy greedy). */
+
+  typedef event_grapht::critical_cyclet::delayt delayt;
+
+  /* the cycles each unsafe pair belongs to */
+  std::map<delayt, std::size_t> edge_index;
+  std::vector<delayt> edges;
+  std::vector<std::vector<std::size_t> > cycles_of_edge;
+
+  std::size_t cycle_nb=0;
+  for(const auto &cycle : set_of_cycles)
+  {
+    for(const auto &pair : cycle.unsafe_pairs)
+    {
+      const auto entry=edge_index.insert(std::make_pair(pair, edges.size()));
+      if(entry.second)
+      {
+        edges.push_back(pair);
+        cycles_of_edge.push_back(std::vector<std::size_t>());
+      }
+      cycles_of_edge[entry.first->second].push_back(cycle_nb);
+    }
+    ++cycle_nb;
+  }
+
+  message.debug() << "edges: " << edges.size() << " cycles:"
+    << set_of_cycles.size() << messaget::eom;
+
+  std::vector<bool> hit(set_of_cycles.size(), false);
+
+  /* (gain, cost, edge), ordered by decreasing ratio gain/cost */
+  struct candidatet
+  {
+    std::size_t gain;
+    unsigned cost;
+    std::size_t edge;
+
+    bool operator<(const candidatet &other) const
+    {
+      return gain*other.cost<other.gain*cost;
+    }
+  };
+
+  std::priority_queue<candidatet> queue;
+  for(std::size_t e=0; e<edges.size(); ++e)
+    queue.push({cycles_of_edge[e].size(), cost(edges[e]), e});
+
+  unsigned total_cost=0;
+
+  while(!queue.empty())
+  {
+    candidatet top=queue.top();
+    queue.pop();
+
+    top.gain=0;
+    for(const auto c : cycles_of_edge[top.edge])
+      if(!hit[c])
+        ++top.gain;
+
+    if(top.gain==0)
+      continue;
+
+    /* the gain is outdated: put it back in its place */
+    if(!queue.empty() && top<queue.top())
+    {
+      queue.push(top);
+      continue;
+    }
+
+    for(const auto c : cycles_of_edge[top.edge])
+      hit[c]=true;
+    total_cost+=top.cost;
+
+    const delayt &e_i=edges[top.edge];
+    const abstract_eventt &first_ev=egraph[e_i.first];
+    var_to_instr.insert(first_ev.variable);
+    id2loc.insert(
+      std::pair<irep_idt, source_locationt>(
+        first_ev.variable, first_ev.source_location));
+    if(!e_i.is_po)
+    {
+      const abstract_eventt &second_ev=egraph[e_i.second];
+      var_to_instr.insert(second_ev.variable);
+      id2loc.insert(
+        std::pair<irep_idt, source_locationt>(
+          second_ev.variable, second_ev.source_location));
+    }
+  }
+
+  message.statistics() << "greedy cost: " << total_cost << messaget::eom;
+}
+
 void inline instrumentert::instrument_my_events_inserter(
   const std::set<event_grapht::critical_cyclet> &set,
   const std::set<event_idt> &my_events)
@@ -113,6 +113,7 @@ void weak_memory(
   loop_strategyt duplicate_body,
   unsigned input_max_var,
   unsigned input_max_po_trans,
+  unsigned max_cycles,
   bool render_po,
   bool render_file,
   bool render_function,
@@ -157,6 +158,8 @@ void weak_memory(
   else
     instrumenter.set_parameters_collection(max_thds, ignore_arrays);
 
+  instrumenter.egraph.set_max_cycles(max_cycles);
+
   if(SCC)
   {
     instrumenter.collect_cycles_by_SCCs(model);
@@ -167,7 +170,7 @@ void weak_memory(
       if(instrumenter.egraph_SCCs[i].size()>=4)
       {
         message.status()<<"SCC #"<<i<<": "
-          <<instrumenter.set_of_cycles_per_SCC[interesting_scc++].size()
+          <<instrumenter.set_of_cycles_per_SCC[interesting_scc].size()
           <<" cycles found"<<messaget::eom;
         total_cycles += instrumenter
           .set_of_cycles_per_SCC[interesting_scc++].size();
@@ -194,6 +197,10 @@ void weak_memory(
     }
   }
 
+  if(instrumenter.egraph.max_cycles_reached())
+    message.warning()<<"limit of "<<max_cycles<<" cycles reached: only the "
+      <<"cycles collected so far are instrumented"<<messaget::eom;
+
   if(!no_cfg_kill)
     instrumenter.cfg_cycles_filter();
 
@@ -37,6 +37,7 @@ void weak_memory(
   loop_strategyt duplicate_body,
   unsigned max_var,
   unsigned max_po_trans,
+  unsigned max_cycles,
   bool render_po,
   bool render_file,
   bool render_function,
@@ -0,0 +1,229 @@
+/*******************************************************************\
+
+Module: Frozen Goto Program
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Frozen Goto Program
+
+#include "frozen_goto_program.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+frozen_goto_programt::frozen_goto_programt(const goto_programt &src):
+  locations_ordered(true)
+{
+  std::unordered_map<const goto_programt::instructiont *, targett> index;
+  index.reserve(src.instructions.size());
+
+  for(const auto &instruction : src.instructions)
+    index.emplace(&instruction, index.size());
+
+  instructions.resize(src.instructions.size());
+
+  auto dest_it=instructions.begin();
+  for(const auto &instruction : src.instructions)
+  {
+    instructiont &dest=*dest_it;
+
+    dest.code=instruction.code;
+    dest.function=instruction.function;
+    dest.source_location=instruction.source_location;
+    dest.type=instruction.type;
+    dest.guard=instruction.guard;
+    dest.labels=instruction.labels;
+    dest.location_number=instruction.location_number;
+    dest.loop_number=instruction.loop_number;
+    dest.target_number=instruction.target_number;
+
+    dest.targets.reserve(instruction.targets.size());
+    for(const auto &t : instruction.targets)
+    {
+      const auto entry=index.find(&*t);
+      DATA_INVARIANT(
+        entry!=index.end(), "targets are instructions of the program");
+      dest.targets.push_back(entry->second);
+    }
+
+    ++dest_it;
+  }
+
+  for(targett i=0; i<instructions.size(); i++)
+  {
+    for(const auto s : get_successors(i))
+      instructions[s].incoming_edges.push_back(i);
+
+    if(i>0 &&
+       instructions[i].location_number<=instructions[i-1].location_number)
+      locations_ordered=false;
+  }
+}
+
+frozen_goto_programt::targetst frozen_goto_programt::get_successors(
+  targett target) const
+{
+  if(target>=instructions.size())
+    return targetst();
+
+  const instructiont &i=instructions[target];
+  const targett next=target+1;
+  const bool has_next=next<instructions.size();
+
+  if(i.is_goto())
+  {
+    targetst successors(i.targets);
+
+    if(!i.guard.is_true() && has_next)
+      successors.push_back(next);
+
+    return successors;
+  }
+
+  if(i.is_start_thread())
+  {
+    targetst successors(i.targets);
+
+    if(has_next)
+      successors.push_back(next);
+
+    return successors;
+  }
+
+  if(i.is_end_thread())
+  {
+    // no successors
+    return targetst();
+  }
+
+  if(i.is_throw())
+  {
+    // the successors are non-obvious
+    return targetst();
+  }
+
+  if(i.is_assume())
+  {
+    return
+      !i.guard.is_false() && has_next ? targetst{next} : targetst();
+  }
+
+  if(has_next)
+    return targetst{next};
+
+  return targetst();
+}
+
+bool frozen_goto_programt::is_backwards_goto(targett target) const
+{
+  const instructiont &i=(*this)[target];
+
+  if(!i.is_goto())
+    return false;
+
+  for(const auto t : i.targets)
+    if(t<=target)
+      return true;
+
+  return false;
+}
+
+frozen_goto_programt::targett frozen_goto_programt::find_location(
+  unsigned location_number) const
+{
+  PRECONDITION(locations_ordered);
+
+  const auto it=std::lower_bound(
+    instructions.begin(),
+    instructions.end(),
+    location_number,
+    [](const instructiont &instruction, unsigned n)
+    {
+      return instruction.location_number<n;
+    });
+
+  if(it==instructions.end() || it->location_number!=location_number)
+    return instructions.size();
+
+  return it-instructions.begin();
+}
+
+void frozen_goto_programt::thaw(goto_programt &dest) const
+{
+  dest.clear();
+
+  std::vector<goto_programt::targett> targets;
+  targets.reserve(instructions.size());
+
+  for(const auto &instruction : instructions)
+  {
+    goto_programt::targett t=dest.add_instruction(instruction.type);
+    t->code=instruction.code;
+    t->function=instruction.function;
+    t->source_location=instruction.source_location;
+    t->guard=instruction.guard;
+    t->labels=instruction.labels;
+    t->location_number=instruction.location_number;
+    t->loop_number=instruction.loop_number;
+    t->target_number=instruction.target_number;
+    targets.push_back(t);
+  }
+
+  for(targett i=0; i<instructions.size(); i++)
+    for(const auto t : instructions[i].targets)
+      targets[i]->targets.push_back(targets[t]);
+
+  dest.compute_incoming_edges();
+}
+
+frozen_goto_functionst::frozen_goto_functionst(const goto_functionst &src)
+{
+  for(const auto &f : src.function_map)
+  {
+    const auto entry=
+      function_map.emplace(f.first, frozen_goto_programt(f.second.body));
+    const frozen_goto_programt &body=entry.first->second;
+
+    if(!body.empty())
+      first_locations.emplace_back(body[0].location_number, f.first);
+  }
+
+  std::sort(first_locations.begin(), first_locations.end());
+}
+
+const frozen_goto_functionst::function_mapt::value_type *
+frozen_goto_functionst::find_location(
+  unsigned location_number,
+  frozen_goto_programt::targett &target) const
+{
+  // the last body that starts at or before the location
+  const auto it=std::upper_bound(
+    first_locations.begin(),
+    first_locations.end(),
+    location_number,
+    [](unsigned n, const first_locationst::value_type &entry)
+    {
+      return n<entry.first;
+    });
+
+  if(it==first_locations.begin())
+    return nullptr;
+
+  const function_mapt::value_type &function=
+    *function_map.find(std::prev(it)->second);
+  target=function.second.find_location(location_number);
+
+  if(target==function.second.size())
+    return nullptr;
+
+  return &function;
+}
+
+void frozen_goto_functionst::thaw(goto_functionst &dest) const
+{
+  for(const auto &f : function_map)
+    f.second.thaw(dest.function_map[f.first].body);
+}
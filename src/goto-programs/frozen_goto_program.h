@@ -0,0 +1,178 @@
+/*******************************************************************\
+
+Module: Frozen Goto Program
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Frozen Goto Program
+
+#ifndef CPROVER_GOTO_PROGRAMS_FROZEN_GOTO_PROGRAM_H
+#define CPROVER_GOTO_PROGRAMS_FROZEN_GOTO_PROGRAM_H
+
+#include <map>
+#include <vector>
+
+#include "goto_functions.h"
+#include "goto_program.h"
+
+/// An immutable, array-based form of a \ref goto_programt, for use once a
+/// program is no longer instrumented. The instructions are stored
+/// contiguously, and targets are indices into the array rather than list
+/// iterators, so that analyses can index side tables by target directly.
+///
+/// Instructions are frozen with their location numbers, which are ordered in
+/// program order; a program location can thus be found by binary search.
+/// Use \ref thaw to obtain a \ref goto_programt that can be modified again.
+class frozen_goto_programt
+{
+public:
+  /// The index of an instruction
+  typedef std::size_t targett;
+  typedef std::vector<targett> targetst;
+
+  class instructiont
+  {
+  public:
+    codet code;
+    irep_idt function;
+    source_locationt source_location;
+    goto_program_instruction_typet type;
+    exprt guard;
+
+    /// The targets of gotos, start_thread nodes and catch nodes
+    targetst targets;
+
+    /// The instructions that this one is a successor of
+    targetst incoming_edges;
+
+    goto_programt::instructiont::labelst labels;
+
+    unsigned location_number;
+    unsigned loop_number;
+    unsigned target_number;
+
+    targett get_target() const
+    {
+      PRECONDITION(targets.size()==1);
+      return targets.front();
+    }
+
+    bool is_target() const
+    {
+      return target_number!=goto_programt::instructiont::nil_target;
+    }
+
+    bool is_goto         () const { return type==GOTO;          }
+    bool is_return       () const { return type==RETURN;        }
+    bool is_assign       () const { return type==ASSIGN;        }
+    bool is_function_call() const { return type==FUNCTION_CALL; }
+    bool is_throw        () const { return type==THROW;         }
+    bool is_catch        () const { return type==CATCH;         }
+    bool is_skip         () const { return type==SKIP;          }
+    bool is_location     () const { return type==LOCATION;      }
+    bool is_other        () const { return type==OTHER;         }
+    bool is_decl         () const { return type==DECL;          }
+    bool is_dead         () const { return type==DEAD;          }
+    bool is_assume       () const { return type==ASSUME;        }
+    bool is_assert       () const { return type==ASSERT;        }
+    bool is_atomic_begin () const { return type==ATOMIC_BEGIN;  }
+    bool is_atomic_end   () const { return type==ATOMIC_END;    }
+    bool is_start_thread () const { return type==START_THREAD;  }
+    bool is_end_thread   () const { return type==END_THREAD;    }
+    bool is_end_function () const { return type==END_FUNCTION;  }
+  };
+
+  typedef std::vector<instructiont> instructionst;
+
+  /// The instructions; instruction `i` is followed by instruction `i+1`
+  /// unless it jumps
+  const instructionst &get_instructions() const
+  {
+    return instructions;
+  }
+
+  const instructiont &operator[](targett target) const
+  {
+    PRECONDITION(target<instructions.size());
+    return instructions[target];
+  }
+
+  std::size_t size() const
+  {
+    return instructions.size();
+  }
+
+  bool empty() const
+  {
+    return instructions.empty();
+  }
+
+  frozen_goto_programt():
+    locations_ordered(true)
+  {
+  }
+
+  /// Freeze \p src, which is not modified
+  explicit frozen_goto_programt(const goto_programt &src);
+
+  /// The successors of \p target, as computed by
+  /// \ref goto_programt::get_successors
+  targetst get_successors(targett target) const;
+
+  /// Is \p target a goto that may jump backwards?
+  bool is_backwards_goto(targett target) const;
+
+  /// Find the instruction with location number \p location_number; the
+  /// location numbers of the program must have been computed
+  /// \return the index of the instruction, or \ref size() if there is none
+  targett find_location(unsigned location_number) const;
+
+  /// Replace \p dest by the list form of this program, preserving the
+  /// location, loop and target numbers
+  void thaw(goto_programt &dest) const;
+
+protected:
+  instructionst instructions;
+
+  /// whether the location numbers increase strictly in program order, as
+  /// goto_programt::compute_location_numbers makes them
+  bool locations_ordered;
+};
+
+/// The frozen bodies of all functions of a \ref goto_functionst, with a
+/// lookup of program locations across functions
+class frozen_goto_functionst
+{
+public:
+  typedef std::map<irep_idt, frozen_goto_programt> function_mapt;
+
+  explicit frozen_goto_functionst(const goto_functionst &src);
+
+  const function_mapt &get_function_map() const
+  {
+    return function_map;
+  }
+
+  /// Find the instruction with location number \p location_number
+  /// \return the function the instruction belongs to, or nullptr if there is
+  ///   none; \p target is set to the index of the instruction in its body
+  const function_mapt::value_type *find_location(
+    unsigned location_number,
+    frozen_goto_programt::targett &target) const;
+
+  /// Replace the bodies in \p dest by the list form of the frozen ones
+  void thaw(goto_functionst &dest) const;
+
+protected:
+  function_mapt function_map;
+
+  /// the first location number of each non-empty body, in ascending order,
+  /// with the name of the function
+  typedef std::vector<std::pair<unsigned, irep_idt>> first_locationst;
+  first_locationst first_locations;
+};
+
+#endif // CPROVER_GOTO_PROGRAMS_FROZEN_GOTO_PROGRAM_H
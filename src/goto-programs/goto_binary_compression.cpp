@@ -0,0 +1,163 @@
+/*******************************************************************\
+
+Module: Compression of Goto Binary Sections
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Compression of Goto Binary Sections
+
+#include "goto_binary_compression.h"
+
+#include <cstring>
+
+#include <util/invariant.h>
+#include <util/make_unique.h>
+
+#include <miniz/miniz.h>
+
+/// A stream buffer that passes what is written to it to deflate in blocks
+class compressed_goto_binary_sectiont::deflate_streambuft:public std::streambuf
+{
+public:
+  deflate_streambuft():written(0)
+  {
+    std::memset(&stream, 0, sizeof(stream));
+    const int status=mz_deflateInit(&stream, MZ_BEST_SPEED);
+    CHECK_RETURN(status==MZ_OK);
+    setp(block, block+sizeof(block));
+  }
+
+  ~deflate_streambuft()
+  {
+    mz_deflateEnd(&stream);
+  }
+
+  std::string finish()
+  {
+    compress_block(MZ_FINISH);
+    return std::move(compressed);
+  }
+
+  /// the number of bytes passed to deflate
+  std::size_t written;
+
+protected:
+  mz_stream stream;
+  char block[1<<16];
+  std::string compressed;
+
+  void compress_block(int flush)
+  {
+    stream.next_in=reinterpret_cast<const unsigned char *>(pbase());
+    stream.avail_in=static_cast<unsigned>(pptr()-pbase());
+    written+=stream.avail_in;
+
+    int status;
+
+    do
+    {
+      // deflate into the end of the compressed section
+      const std::size_t size=compressed.size();
+      const std::size_t chunk=sizeof(block);
+      compressed.resize(size+chunk);
+      stream.next_out=reinterpret_cast<unsigned char *>(&compressed[size]);
+      stream.avail_out=static_cast<unsigned>(chunk);
+
+      status=mz_deflate(&stream, flush);
+      // MZ_BUF_ERROR only says that no progress was possible
+      CHECK_RETURN(
+        status==MZ_OK || status==MZ_STREAM_END || status==MZ_BUF_ERROR);
+
+      compressed.resize(size+chunk-stream.avail_out);
+    }
+    while(flush==MZ_FINISH ?
+          status!=MZ_STREAM_END :
+          stream.avail_out==0 && status!=MZ_BUF_ERROR);
+
+    setp(block, block+sizeof(block));
+  }
+
+  int_type overflow(int_type c) override
+  {
+    compress_block(MZ_NO_FLUSH);
+
+    if(!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+      *pptr()=traits_type::to_char_type(c);
+      pbump(1);
+    }
+
+    return traits_type::not_eof(c);
+  }
+};
+
+compressed_goto_binary_sectiont::compressed_goto_binary_sectiont():
+  std::ostream(nullptr),
+  buffer(util_make_unique<deflate_streambuft>())
+{
+  rdbuf(buffer.get());
+}
+
+compressed_goto_binary_sectiont::~compressed_goto_binary_sectiont()
+{
+}
+
+std::string compressed_goto_binary_sectiont::finish()
+{
+  return buffer->finish();
+}
+
+std::size_t compressed_goto_binary_sectiont::uncompressed_size() const
+{
+  return buffer->written;
+}
+
+std::string compress_goto_binary_section(const std::string &data)
+{
+  mz_ulong size=mz_compressBound(static_cast<mz_ulong>(data.size()));
+  std::string result(size, '\0');
+
+  // goto binaries are written often, hence favour speed over size
+  const int status=mz_compress2(
+    reinterpret_cast<unsigned char *>(&result[0]),
+    &size,
+    reinterpret_cast<const unsigned char *>(data.data()),
+    static_cast<mz_ulong>(data.size()),
+    MZ_BEST_SPEED);
+  CHECK_RETURN(status==MZ_OK);
+
+  result.resize(size);
+  return result;
+}
+
+bool uncompress_goto_binary_section(
+  const char *data,
+  std::size_t size,
+  std::size_t uncompressed_size,
+  std::string &dest)
+{
+  // the size is read from the file: deflate compresses at most 1032:1,
+  // hence a larger size can only stem from a corrupt file and must not be
+  // allocated
+  const std::size_t max_ratio=1032;
+  if(uncompressed_size/max_ratio>size)
+    return true;
+
+  dest.resize(uncompressed_size);
+
+  if(uncompressed_size==0)
+    return false;
+
+  mz_ulong dest_size=static_cast<mz_ulong>(uncompressed_size);
+
+  const int status=mz_uncompress(
+    reinterpret_cast<unsigned char *>(&dest[0]),
+    &dest_size,
+    reinterpret_cast<const unsigned char *>(data),
+    static_cast<mz_ulong>(size));
+
+  return status!=MZ_OK || dest_size!=uncompressed_size;
+}
@@ -0,0 +1,53 @@
+/*******************************************************************\
+
+Module: Compression of Goto Binary Sections
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Compression of Goto Binary Sections
+
+#ifndef CPROVER_GOTO_PROGRAMS_GOTO_BINARY_COMPRESSION_H
+#define CPROVER_GOTO_PROGRAMS_GOTO_BINARY_COMPRESSION_H
+
+#include <memory>
+#include <ostream>
+#include <string>
+
+/// Compress the section \p data of a goto binary using deflate, see
+/// write_goto_binary_v4
+std::string compress_goto_binary_section(const std::string &data);
+
+/// An output stream that compresses what is written to it as
+/// compress_goto_binary_section does, such that a section is never held
+/// uncompressed
+class compressed_goto_binary_sectiont:public std::ostream
+{
+public:
+  compressed_goto_binary_sectiont();
+  ~compressed_goto_binary_sectiont();
+
+  /// Complete the compression; nothing must be written afterwards
+  /// \return the compressed section
+  std::string finish();
+
+  /// \return the number of bytes written to the stream
+  std::size_t uncompressed_size() const;
+
+protected:
+  class deflate_streambuft;
+  std::unique_ptr<deflate_streambuft> buffer;
+};
+
+/// Decompress the section of \p size bytes at \p data into \p dest, which
+/// is to hold \p uncompressed_size bytes
+/// \return true on error, false otherwise
+bool uncompress_goto_binary_section(
+  const char *data,
+  std::size_t size,
+  std::size_t uncompressed_size,
+  std::string &dest);
+
+#endif // CPROVER_GOTO_PROGRAMS_GOTO_BINARY_COMPRESSION_H
@@ -10,15 +10,23 @@ Date: June 2003
 
 #include "goto_convert_functions.h"
 
+#include <algorithm>
 #include <cassert>
+#include <fstream>
 
 #include <util/base_type.h>
+#include <util/child_processes.h>
+#include <util/journalling_symbol_table.h>
 #include <util/std_code.h>
 #include <util/symbol_table.h>
 #include <util/prefix.h>
 #include <util/fresh_symbol.h>
+#include <util/tempdir.h>
 
+#include "compute_called_functions.h"
 #include "goto_inline.h"
+#include "read_goto_binary.h"
+#include "write_goto_binary.h"
 
 goto_convert_functionst::goto_convert_functionst(
   symbol_table_baset &_symbol_table,
@@ -32,27 +40,34 @@ goto_convert_functionst::~goto_convert_functionst()
 }
 
 void goto_convert_functionst::goto_convert(goto_functionst &functions)
+{
+  goto_convert(functions, 1);
+}
+
+void goto_convert_functionst::goto_convert(
+  goto_functionst &functions,
+  std::size_t jobs)
 {
   // warning! hash-table iterators are not stable
 
-  typedef std::list<irep_idt> symbol_listt;
   symbol_listt symbol_list;
 
   for(const auto &symbol_pair : symbol_table.symbols)
   {
-    if(
-      !symbol_pair.second.is_type && !symbol_pair.second.is_macro &&
-      symbol_pair.second.type.id() == ID_code &&
-      (symbol_pair.second.mode == ID_C || symbol_pair.second.mode == ID_cpp ||
-       symbol_pair.second.mode == ID_java || symbol_pair.second.mode == "jsil"))
-    {
+    if(is_function(symbol_pair.second))
       symbol_list.push_back(symbol_pair.first);
-    }
   }
 
-  for(const auto &id : symbol_list)
+#ifndef _WIN32
+  if(jobs>1 && symbol_list.size()>1)
+    convert_in_parallel(symbol_list, functions, jobs);
+  else
+#endif
   {
-    convert_function(id, functions.function_map[id]);
+    for(const auto &id : symbol_list)
+    {
+      convert_function(id, functions.function_map[id]);
+    }
   }
 
   functions.compute_location_numbers();
@@ -71,6 +86,187 @@ void goto_convert_functionst::goto_convert(goto_functionst &functions)
   #endif
 }
 
+#ifndef _WIN32
+/// Convert the functions in \p symbol_list in up to \p jobs child processes.
+/// Each child converts every `jobs`-th function, and writes the bodies
+/// together with the symbols it has added to a goto binary. The names of
+/// temporaries are prefixed with the name of their function, hence the
+/// symbols added by different children do not clash; symbols that several
+/// children add, such as `$exception_flag`, are identical. The results are
+/// merged in the order of the children, as is their buffered output, which
+/// makes the result independent of the scheduling.
+void goto_convert_functionst::convert_in_parallel(
+  const symbol_listt &symbol_list,
+  goto_functionst &functions,
+  std::size_t jobs)
+{
+  jobs=std::min(jobs, symbol_list.size());
+
+  std::vector<std::vector<irep_idt>> partition(jobs);
+  std::size_t index=0;
+  for(const auto &id : symbol_list)
+    partition[index++%jobs].push_back(id);
+
+  temp_dirt tmp_dir("goto-convert-XXXXXX");
+
+  statistics() << "Converting " << symbol_list.size() << " functions using "
+               << jobs << " processes" << eom;
+
+  message_handlert &handler=get_message_handler();
+
+  const std::vector<int> status=run_in_child_processes(
+    jobs,
+    jobs,
+    tmp_dir.path,
+    handler,
+    [this, &partition, &tmp_dir, &handler](std::size_t job) {
+      const unsigned errors_before=handler.get_message_count(M_ERROR);
+
+      journalling_symbol_tablet journal=
+        journalling_symbol_tablet::wrap(symbol_table);
+      goto_convert_functionst converter(journal, handler);
+      goto_functionst converted;
+
+      for(const auto &id : partition[job])
+        converter.convert_function(id, converted.function_map[id]);
+
+      symbol_tablet new_symbols;
+      for(const auto &id : journal.get_inserted())
+        new_symbols.add(*symbol_table.lookup(id));
+
+      std::ofstream binary(
+        tmp_dir(std::to_string(job)+".gb"), std::ios::binary);
+      const bool failed=
+        handler.get_message_count(M_ERROR)!=errors_before ||
+        !binary ||
+        write_goto_binary(binary, new_symbols, converted);
+      binary.close();
+
+      return failed || !binary ? 1 : 0;
+    });
+
+  for(std::size_t job=0; job<jobs; job++)
+  {
+    if(status[job]<0)
+    {
+      // convert the functions of this job in this process instead
+      for(const auto &id : partition[job])
+        convert_function(id, functions.function_map[id]);
+      partition[job].clear();
+    }
+  }
+
+  bool failed=false;
+
+  for(std::size_t job=0; job<jobs; job++)
+  {
+    if(partition[job].empty())
+      continue;
+
+    replay_child_output(tmp_dir.path, job);
+
+    symbol_tablet new_symbols;
+    goto_functionst converted;
+
+    if(status[job]!=0 ||
+       read_goto_binary(
+         tmp_dir(std::to_string(job)+".gb"),
+         new_symbols,
+         converted,
+         get_message_handler()))
+    {
+      failed=true;
+      continue;
+    }
+
+    for(const auto &symbol_pair : new_symbols.symbols)
+      symbol_table.insert(symbol_pair.second);
+
+    for(const auto &id : partition[job])
+    {
+      goto_functionst::goto_functiont &f=functions.function_map[id];
+      f.type=to_code_type(ns.lookup(id).type);
+
+      goto_functionst::function_mapt::iterator c_it=
+        converted.function_map.find(id);
+
+      if(c_it!=converted.function_map.end() &&
+         c_it->second.body_available())
+      {
+        f.body.swap(c_it->second.body);
+        if(c_it->second.is_hidden())
+          f.make_hidden();
+      }
+    }
+  }
+
+  if(failed)
+  {
+    // the children's errors are not counted by our message handler
+    error() << "failed to convert functions in parallel" << eom;
+    throw 0;
+  }
+}
+#endif
+
+void goto_convert_functionst::goto_convert_reachable(
+  goto_functionst &functions)
+{
+  if(!symbol_table.has_symbol(goto_functionst::entry_point()))
+  {
+    goto_convert(functions);
+    return;
+  }
+
+  std::set<irep_idt> working_queue;
+  std::set<irep_idt> done;
+
+  working_queue.insert(goto_functionst::entry_point());
+
+  while(!working_queue.empty())
+  {
+    const irep_idt id=*working_queue.begin();
+    working_queue.erase(working_queue.begin());
+
+    if(!done.insert(id).second)
+      continue;
+
+    const symbolt *symbol=symbol_table.lookup(id);
+    if(symbol==nullptr || !is_function(*symbol))
+      continue;
+
+    goto_functionst::goto_functiont &f=functions.function_map[id];
+    convert_function(id, f);
+
+    // as in compute_called_functions
+    compute_address_taken_functions(f.body, working_queue);
+
+    forall_goto_program_instructions(i_it, f.body)
+    {
+      if(!i_it->is_function_call())
+        continue;
+
+      const exprt &function=to_code_function_call(i_it->code).function();
+      if(function.id()==ID_symbol)
+        working_queue.insert(to_symbol_expr(function).get_identifier());
+    }
+  }
+
+  statistics() << "Converted " << functions.function_map.size()
+               << " reachable functions" << eom;
+
+  functions.compute_location_numbers();
+}
+
+bool goto_convert_functionst::is_function(const symbolt &symbol)
+{
+  return
+    !symbol.is_type && !symbol.is_macro &&
+    symbol.type.id()==ID_code &&
+    (symbol.mode==ID_C || symbol.mode==ID_cpp ||
+     symbol.mode==ID_java || symbol.mode=="jsil");
+}
+
 bool goto_convert_functionst::hide(const goto_programt &goto_program)
 {
   forall_goto_program_instructions(i_it, goto_program)
@@ -233,6 +429,41 @@ void goto_convert(
     message_handler);
 }
 
+void goto_convert(
+  goto_modelt &goto_model,
+  std::size_t jobs,
+  message_handlert &message_handler)
+{
+  const unsigned errors_before=
+    message_handler.get_message_count(messaget::M_ERROR);
+
+  goto_convert_functionst goto_convert_functions(
+    goto_model.symbol_table, message_handler);
+
+  try
+  {
+    goto_convert_functions.goto_convert(goto_model.goto_functions, jobs);
+  }
+
+  catch(int)
+  {
+    goto_convert_functions.error();
+  }
+
+  catch(const char *e)
+  {
+    goto_convert_functions.error() << e << messaget::eom;
+  }
+
+  catch(const std::string &e)
+  {
+    goto_convert_functions.error() << e << messaget::eom;
+  }
+
+  if(message_handler.get_message_count(messaget::M_ERROR)!=errors_before)
+    throw 0;
+}
+
 void goto_convert(
   symbol_table_baset &symbol_table,
   goto_functionst &functions,
@@ -302,3 +533,47 @@ void goto_convert(
   if(message_handler.get_message_count(messaget::M_ERROR)!=errors_before)
     throw 0;
 }
+
+void goto_convert_reachable(
+  goto_modelt &goto_model,
+  message_handlert &message_handler)
+{
+  goto_convert_reachable(
+    goto_model.symbol_table,
+    goto_model.goto_functions,
+    message_handler);
+}
+
+void goto_convert_reachable(
+  symbol_table_baset &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler)
+{
+  const unsigned errors_before=
+    message_handler.get_message_count(messaget::M_ERROR);
+
+  goto_convert_functionst goto_convert_functions(symbol_table, message_handler);
+
+  try
+  {
+    goto_convert_functions.goto_convert_reachable(functions);
+  }
+
+  catch(int)
+  {
+    goto_convert_functions.error();
+  }
+
+  catch(const char *e)
+  {
+    goto_convert_functions.error() << e << messaget::eom;
+  }
+
+  catch(const std::string &e)
+  {
+    goto_convert_functions.error() << e << messaget::eom;
+  }
+
+  if(message_handler.get_message_count(messaget::M_ERROR)!=errors_before)
+    throw 0;
+}
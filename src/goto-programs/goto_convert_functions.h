@@ -29,6 +29,12 @@ void goto_convert(
   goto_modelt &,
   message_handlert &);
 
+// convert it all, using up to the given number of processes
+void goto_convert(
+  goto_modelt &,
+  std::size_t jobs,
+  message_handlert &);
+
 // just convert a specific function
 void goto_convert(
   const irep_idt &identifier,
@@ -36,10 +42,27 @@ void goto_convert(
   goto_functionst &functions,
   message_handlert &);
 
+/// Convert only the functions that are reachable from the entry point, see
+/// compute_called_functions; functions whose address is taken count as
+/// reachable. The bodies of the other functions stay in the symbol table,
+/// and link_to_library converts any that become reachable later on. Without
+/// an entry point, all functions are converted.
+void goto_convert_reachable(
+  symbol_table_baset &symbol_table,
+  goto_functionst &functions,
+  message_handlert &);
+
+void goto_convert_reachable(
+  goto_modelt &,
+  message_handlert &);
+
 class goto_convert_functionst:public goto_convertt
 {
 public:
   void goto_convert(goto_functionst &functions);
+  /// Convert all functions, using up to \p jobs processes
+  void goto_convert(goto_functionst &functions, std::size_t jobs);
+  void goto_convert_reachable(goto_functionst &functions);
   void convert_function(
     const irep_idt &identifier,
     goto_functionst::goto_functiont &result);
@@ -51,7 +74,17 @@ public:
   virtual ~goto_convert_functionst();
 
 protected:
+  typedef std::list<irep_idt> symbol_listt;
+
   static bool hide(const goto_programt &);
+  static bool is_function(const symbolt &);
+
+#ifndef _WIN32
+  void convert_in_parallel(
+    const symbol_listt &symbol_list,
+    goto_functionst &functions,
+    std::size_t jobs);
+#endif
 
   //
   // function calls
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iostream>
 
 #include <util/config.h>
+#include <util/string2int.h>
 #include <util/unicode.h>
 
 #include <langapi/mode.h>
@@ -26,6 +27,34 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "goto_convert_functions.h"
 #include "read_goto_binary.h"
 
+/// The number of processes given with `--jobs`, or 1 if there is none
+static std::size_t get_jobs(const cmdlinet &cmdline, messaget &msg)
+{
+  if(!cmdline.isset("jobs"))
+    return 1;
+
+  const std::string value=cmdline.get_value("jobs");
+  std::size_t jobs=0;
+  if(!value.empty() &&
+     value.find_first_not_of("0123456789")==std::string::npos)
+    jobs=unsafe_string2size_t(value);
+
+  if(jobs==0)
+  {
+    msg.error() << "--jobs expects a positive number of processes, not `"
+                << value << '\'' << messaget::eom;
+    throw 0;
+  }
+
+  if(cmdline.isset("lazy-functions"))
+  {
+    msg.warning() << "--lazy-functions converts functions serially, "
+                  << "--jobs only applies to typechecking" << messaget::eom;
+  }
+
+  return jobs;
+}
+
 goto_modelt initialize_goto_model(
   const cmdlinet &cmdline,
   message_handlert &message_handler)
@@ -38,6 +67,8 @@ goto_modelt initialize_goto_model(
     throw 0;
   }
 
+  const std::size_t jobs=get_jobs(cmdline, msg);
+
   std::vector<std::string> binaries, sources;
   binaries.reserve(files.size());
   sources.reserve(files.size());
@@ -108,11 +139,14 @@ goto_modelt initialize_goto_model(
     }
   }
 
-  for(const auto &file : binaries)
+  if(!binaries.empty())
   {
     msg.status() << "Reading GOTO program from file" << messaget::eom;
 
-    if(read_object_and_link(file, goto_model, message_handler))
+    // binaries are decoded eagerly, as the passes that follow need every
+    // function body; only lazy_goto_modelt decodes them on demand, see
+    // lazy_goto_binaryt
+    if(read_objects_and_link(binaries, goto_model, message_handler))
       throw 0;
   }
 
@@ -162,10 +196,10 @@ goto_modelt initialize_goto_model(
 
   msg.status() << "Generating GOTO Program" << messaget::eom;
 
-  goto_convert(
-    goto_model.symbol_table,
-    goto_model.goto_functions,
-    message_handler);
+  if(cmdline.isset("lazy-functions"))
+    goto_convert_reachable(goto_model, message_handler);
+  else
+    goto_convert(goto_model, jobs, message_handler);
 
   // stupid hack
   config.set_object_bits_from_symbol_table(
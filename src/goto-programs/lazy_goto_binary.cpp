@@ -0,0 +1,407 @@
+/*******************************************************************\
+
+Module: Lazily Decoded Goto Binaries
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Lazily Decoded Goto Binaries
+
+#include "lazy_goto_binary.h"
+
+#include <fstream>
+#include <istream>
+#include <streambuf>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <util/irep_serialization.h>
+#include <util/message.h>
+#include <util/symbol_serialization.h>
+#include <util/symbol_table.h>
+#include <util/unicode.h>
+
+#include "goto_binary_compression.h"
+#include "goto_function.h"
+
+/// A read-only stream buffer over a block of memory
+class memory_streambuft:public std::streambuf
+{
+public:
+  memory_streambuft(const char *begin, std::size_t size)
+  {
+    char *b=const_cast<char *>(begin);
+    setg(b, b, b+size);
+  }
+
+protected:
+  pos_type seekoff(
+    off_type off,
+    std::ios_base::seekdir dir,
+    std::ios_base::openmode which) override
+  {
+    off_type base;
+
+    if(dir==std::ios_base::beg)
+      base=0;
+    else if(dir==std::ios_base::cur)
+      base=gptr()-eback();
+    else
+      base=egptr()-eback();
+
+    const off_type pos=base+off;
+    if(pos<0 || pos>egptr()-eback())
+      return pos_type(off_type(-1));
+
+    setg(eback(), eback()+pos, egptr());
+    return pos_type(pos);
+  }
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+  {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+  }
+};
+
+/// Read the header of a goto binary
+/// \return the version, or 0 if \p in is not a goto binary
+static std::size_t read_bin_header(std::istream &in)
+{
+  char hdr[4];
+  hdr[0]=static_cast<char>(in.get());
+  hdr[1]=static_cast<char>(in.get());
+  hdr[2]=static_cast<char>(in.get());
+  hdr[3]=static_cast<char>(in.get());
+
+  if(!in || hdr[0]!=0x7f || hdr[1]!='G' || hdr[2]!='B' || hdr[3]!='F')
+    return 0;
+
+  return irep_serializationt::read_gb_word(in);
+}
+
+lazy_goto_binaryt::lazy_goto_binaryt():
+  data(nullptr),
+  size(0),
+  mapped(false),
+  compressed(false),
+  sections_begin(0)
+{
+}
+
+lazy_goto_binaryt::lazy_goto_binaryt(lazy_goto_binaryt &&other):
+  data(other.data),
+  size(other.size),
+  buffer(std::move(other.buffer)),
+  mapped(other.mapped),
+  compressed(other.compressed),
+  string_table(std::move(other.string_table)),
+  symbol_ireps(std::move(other.symbol_ireps)),
+  functions(std::move(other.functions)),
+  sections_begin(other.sections_begin)
+{
+  other.data=nullptr;
+  other.size=0;
+  other.mapped=false;
+  other.functions.clear();
+}
+
+lazy_goto_binaryt &lazy_goto_binaryt::operator=(lazy_goto_binaryt &&other)
+{
+  if(this!=&other)
+  {
+    close();
+
+    data=other.data;
+    size=other.size;
+    buffer=std::move(other.buffer);
+    mapped=other.mapped;
+    compressed=other.compressed;
+    string_table=std::move(other.string_table);
+    symbol_ireps=std::move(other.symbol_ireps);
+    functions=std::move(other.functions);
+    sections_begin=other.sections_begin;
+
+    other.data=nullptr;
+    other.size=0;
+    other.mapped=false;
+    other.functions.clear();
+  }
+
+  return *this;
+}
+
+lazy_goto_binaryt::~lazy_goto_binaryt()
+{
+  close();
+}
+
+void lazy_goto_binaryt::close()
+{
+#ifndef _WIN32
+  if(mapped)
+    munmap(const_cast<char *>(data), size);
+#endif
+
+  data=nullptr;
+  size=0;
+  mapped=false;
+  buffer.clear();
+  string_table=irep_serializationt::string_tablet();
+  symbol_ireps.clear();
+  functions.clear();
+}
+
+bool lazy_goto_binaryt::is_lazy_goto_binary(const std::string &filename)
+{
+#ifdef _MSC_VER
+  std::ifstream in(widen(filename), std::ios::binary);
+#else
+  std::ifstream in(filename, std::ios::binary);
+#endif
+
+  if(!in)
+    return false;
+
+  const std::size_t version=read_bin_header(in);
+  return version==4 || version==5;
+}
+
+bool lazy_goto_binaryt::open(
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
+
+  close();
+
+#ifndef _WIN32
+  int fd=::open(filename.c_str(), O_RDONLY);
+  struct stat file_stat;
+
+  if(fd>=0 && fstat(fd, &file_stat)==0 && file_stat.st_size>0)
+  {
+    void *p=
+      mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if(p!=MAP_FAILED)
+    {
+      data=static_cast<const char *>(p);
+      size=file_stat.st_size;
+      mapped=true;
+    }
+  }
+
+  if(fd>=0)
+    ::close(fd);
+#endif
+
+  if(!mapped)
+  {
+    // no mmap: read the whole file
+#ifdef _MSC_VER
+    std::ifstream in(widen(filename), std::ios::binary);
+#else
+    std::ifstream in(filename, std::ios::binary);
+#endif
+
+    if(!in)
+    {
+      message.error() << "failed to open `" << filename << "'"
+                      << messaget::eom;
+      return true;
+    }
+
+    buffer.assign(
+      std::istreambuf_iterator<char>(in),
+      std::istreambuf_iterator<char>());
+    data=buffer.data();
+    size=buffer.size();
+  }
+
+  memory_streambuft streambuf(data, size);
+  std::istream in(&streambuf);
+
+  const std::size_t version=read_bin_header(in);
+
+  if(version!=4 && version!=5)
+  {
+    message.error() << "`" << filename << "' is not a goto binary of "
+                    << "version 4 or 5" << messaget::eom;
+    close();
+    return true;
+  }
+
+  compressed=version>=5;
+
+  const goto_binary_section_tablet section_table=
+    read_bin_section_table(in, compressed);
+
+  if(!in)
+  {
+    message.error() << "`" << filename << "' is truncated"
+                    << messaget::eom;
+    close();
+    return true;
+  }
+
+  sections_begin=static_cast<std::size_t>(in.tellg());
+
+  // the sizes and offsets are read from the file, hence the checks must not
+  // overflow
+  const std::size_t limit=sections_begin<=size ? size-sections_begin : 0;
+
+  if(section_table.strings_size>limit ||
+     section_table.symbols_size>limit-section_table.strings_size)
+  {
+    message.error() << "`" << filename << "' is truncated"
+                    << messaget::eom;
+    close();
+    return true;
+  }
+
+  for(const auto &section : section_table.functions)
+  {
+    if(section.second.offset>limit ||
+       section.second.size>limit-section.second.offset)
+    {
+      message.error() << "`" << filename << "' is truncated"
+                      << messaget::eom;
+      close();
+      return true;
+    }
+
+    functions.insert(section);
+  }
+
+  std::string uncompressed;
+  const char *begin, *end;
+
+  if(section_contents(
+       0,
+       section_table.strings_size,
+       section_table.strings_uncompressed_size,
+       uncompressed,
+       begin,
+       end))
+  {
+    message.error() << "`" << filename << "' is corrupt" << messaget::eom;
+    close();
+    return true;
+  }
+
+  {
+    memory_streambuft strings_streambuf(begin, end-begin);
+    std::istream strings_in(&strings_streambuf);
+
+    if(string_table.read(strings_in))
+    {
+      message.error() << "`" << filename << "' is corrupt" << messaget::eom;
+      close();
+      return true;
+    }
+  }
+
+  if(section_contents(
+       section_table.strings_size,
+       section_table.symbols_size,
+       section_table.symbols_uncompressed_size,
+       uncompressed,
+       begin,
+       end))
+  {
+    message.error() << "`" << filename << "' is corrupt" << messaget::eom;
+    close();
+    return true;
+  }
+
+  memory_streambuft symbols_streambuf(begin, end-begin);
+  std::istream symbols_in(&symbols_streambuf);
+
+  irep_serializationt irepconverter(symbol_ireps, string_table);
+
+  read_bin_shared_ireps(symbols_in, irepconverter);
+
+  // # of symbols
+  std::size_t count=irepconverter.read_gb_word(symbols_in);
+
+  for(std::size_t i=0; i<count && symbols_in; i++)
+  {
+    symbolt symbol;
+    read_bin_symbol(symbols_in, symbol, irepconverter);
+    symbol_table.add(symbol);
+  }
+
+  if(!symbols_in)
+  {
+    message.error() << "`" << filename << "' is corrupt" << messaget::eom;
+    close();
+    return true;
+  }
+
+  return false;
+}
+
+bool lazy_goto_binaryt::section_contents(
+  std::size_t offset,
+  std::size_t section_size,
+  std::size_t uncompressed_size,
+  std::string &uncompressed,
+  const char *&begin,
+  const char *&end) const
+{
+  const char *section=data+sections_begin+offset;
+
+  if(!compressed)
+  {
+    begin=section;
+    end=section+section_size;
+    return false;
+  }
+
+  if(uncompress_goto_binary_section(
+       section, section_size, uncompressed_size, uncompressed))
+    return true;
+
+  begin=uncompressed.data();
+  end=begin+uncompressed.size();
+  return false;
+}
+
+void lazy_goto_binaryt::read_function(
+  const irep_idt &name,
+  goto_functiont &goto_function) const
+{
+  const goto_binary_section_tablet::sectiont &section=functions.at(name);
+
+  std::string uncompressed;
+  const char *begin, *end;
+
+  if(section_contents(
+       section.offset,
+       section.size,
+       section.uncompressed_size,
+       uncompressed,
+       begin,
+       end))
+  {
+    throw "the body of `"+id2string(name)+"' is corrupt";
+  }
+
+  memory_streambuft streambuf(begin, end-begin);
+  std::istream in(&streambuf);
+
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic, string_table, &symbol_ireps);
+  read_bin_goto_function(in, goto_function, irepconverter);
+
+  if(!in)
+    throw "the body of `"+id2string(name)+"' is corrupt";
+}
@@ -0,0 +1,101 @@
+/*******************************************************************\
+
+Module: Lazily Decoded Goto Binaries
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Lazily Decoded Goto Binaries
+
+#ifndef CPROVER_GOTO_PROGRAMS_LAZY_GOTO_BINARY_H
+#define CPROVER_GOTO_PROGRAMS_LAZY_GOTO_BINARY_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <util/irep_serialization.h>
+
+#include "read_bin_goto_object.h"
+
+class message_handlert;
+
+/// A goto binary of version 4 or 5 that is mapped into memory; its
+/// symbol table is read when it is opened, but a function body is only
+/// decoded when it is requested via read_function(). lazy_goto_modelt uses
+/// this to load the functions of a goto binary on demand, provided that
+/// binary is its only input; with `jbmc --symex-driven-lazy-loading`, only
+/// the bodies that symbolic execution enters are then decoded. Tools that
+/// use initialize_goto_model, such as cbmc, decode binaries eagerly.
+class lazy_goto_binaryt
+{
+public:
+  lazy_goto_binaryt();
+  lazy_goto_binaryt(lazy_goto_binaryt &&other);
+  lazy_goto_binaryt &operator=(lazy_goto_binaryt &&other);
+  ~lazy_goto_binaryt();
+
+  lazy_goto_binaryt(const lazy_goto_binaryt &)=delete;
+  lazy_goto_binaryt &operator=(const lazy_goto_binaryt &)=delete;
+
+  /// Returns true if \p filename is a goto binary whose functions can be
+  /// decoded individually, i.e., one of version 4 or 5
+  static bool is_lazy_goto_binary(const std::string &filename);
+
+  /// Map \p filename into memory and read its symbol table into
+  /// \p symbol_table
+  /// \return true on error, false otherwise
+  bool open(
+    const std::string &filename,
+    symbol_tablet &symbol_table,
+    message_handlert &message_handler);
+
+  bool has_function(const irep_idt &name) const
+  {
+    return functions.find(name)!=functions.end();
+  }
+
+  /// Decode the body of the function \p name into \p goto_function, whose
+  /// type is left untouched
+  void read_function(const irep_idt &name, goto_functiont &goto_function)
+    const;
+
+protected:
+  const char *data;
+  std::size_t size;
+
+  /// the contents of the file on platforms without mmap
+  std::vector<char> buffer;
+  bool mapped;
+
+  /// whether sections are compressed, as in version 5
+  bool compressed;
+
+  /// the strings of all sections and the ireps of the symbol table section,
+  /// which are read when opening; mutable as irep_serializationt takes them
+  /// for writing too, but decoding a function does not change them
+  mutable irep_serializationt::string_tablet string_table;
+  mutable irep_serializationt::ireps_containert symbol_ireps;
+
+  std::unordered_map<irep_idt, goto_binary_section_tablet::sectiont>
+    functions;
+  std::size_t sections_begin;
+
+  void close();
+
+  /// Set \p begin and \p end to the contents of the section at \p offset
+  /// from the beginning of the sections, decompressing into
+  /// \p uncompressed if needed
+  /// \return true on error, false otherwise
+  bool section_contents(
+    std::size_t offset,
+    std::size_t section_size,
+    std::size_t uncompressed_size,
+    std::string &uncompressed,
+    const char *&begin,
+    const char *&end) const;
+};
+
+#endif // CPROVER_GOTO_PROGRAMS_LAZY_GOTO_BINARY_H
@@ -10,6 +10,7 @@
 
 #include "goto_functions.h"
 #include "goto_convert_functions.h"
+#include "lazy_goto_binary.h"
 
 #include <util/message.h>
 #include <langapi/language_file.h>
@@ -20,7 +21,8 @@
 /// access to goto programs while they are still under construction.
 /// The intended workflow:
 /// 1. The front-end registers the functions that are potentially
-///   available, probably by use of langapi/language_file.h
+///   available, probably by use of langapi/language_file.h, or by opening
+///   a goto binary whose function bodies can be decoded on demand
 /// 2. The main function registers functions that should be run on
 ///   each program, in sequence, after it is converted.
 /// 3. Analyses will then access functions using the `at` function
@@ -73,6 +75,7 @@ private:
   mutable std::unordered_set<irep_idt> processed_functions;
 
   language_filest &language_files;
+  const lazy_goto_binaryt &goto_binary;
   symbol_tablet &symbol_table;
   const post_process_functiont post_process_function;
   const can_generate_function_bodyt driver_program_can_generate_function_body;
@@ -84,6 +87,7 @@ public:
   lazy_goto_functions_mapt(
     underlying_mapt &goto_functions,
     language_filest &language_files,
+    const lazy_goto_binaryt &goto_binary,
     symbol_tablet &symbol_table,
     post_process_functiont post_process_function,
     can_generate_function_bodyt driver_program_can_generate_function_body,
@@ -91,6 +95,7 @@ public:
     message_handlert &message_handler)
   : goto_functions(goto_functions),
     language_files(language_files),
+    goto_binary(goto_binary),
     symbol_table(symbol_table),
     post_process_function(post_process_function),
     driver_program_can_generate_function_body(
@@ -126,6 +131,7 @@ public:
   {
     return
       language_files.can_convert_lazy_method(name) ||
+      goto_binary.has_function(name) ||
       driver_program_can_generate_function_body(name);
   }
 
@@ -181,9 +187,19 @@ private:
         name,
         function_symbol_table,
         function,
-        language_files.can_convert_lazy_method(name));
+        language_files.can_convert_lazy_method(name) ||
+          goto_binary.has_function(name));
 
-    // Second chance: see if language_filest can provide a body:
+    // Second chance: see if the goto binary has a body:
+    if(!body_provided && goto_binary.has_function(name))
+    {
+      function.type=
+        to_code_type(function_symbol_table.lookup_ref(name).type);
+      goto_binary.read_function(name, function);
+      body_provided=true;
+    }
+
+    // Third chance: see if language_filest can provide a body:
     if(!body_provided)
     {
       // Fill in symbol table entry body if not already done
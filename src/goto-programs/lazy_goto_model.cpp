@@ -30,6 +30,7 @@ lazy_goto_modelt::lazy_goto_modelt(
     goto_functions(
       goto_model->goto_functions.function_map,
       language_files,
+      goto_binary,
       symbol_table,
       [this] (
         const irep_idt &function_name,
@@ -63,6 +64,7 @@ lazy_goto_modelt::lazy_goto_modelt(lazy_goto_modelt &&other)
     goto_functions(
       goto_model->goto_functions.function_map,
       language_files,
+      goto_binary,
       symbol_table,
       [this] (
         const irep_idt &function_name,
@@ -80,6 +82,7 @@ lazy_goto_modelt::lazy_goto_modelt(lazy_goto_modelt &&other)
       other.driver_program_generate_function_body,
       other.message_handler),
     language_files(std::move(other.language_files)),
+    goto_binary(std::move(other.goto_binary)),
     post_process_function(other.post_process_function),
     post_process_functions(other.post_process_functions),
     message_handler(other.message_handler)
@@ -163,13 +166,26 @@ void lazy_goto_modelt::initialize(const cmdlinet &cmdline)
     }
   }
 
-  for(const std::string &file : binaries)
+  if(sources.empty() &&
+     binaries.size()==1 &&
+     lazy_goto_binaryt::is_lazy_goto_binary(binaries.front()))
   {
+    // nothing to link, hence function bodies are decoded on demand
     msg.status() << "Reading GOTO program from file" << messaget::eom;
 
-    if(read_object_and_link(file, *goto_model, message_handler))
+    if(goto_binary.open(binaries.front(), symbol_table, message_handler))
       throw 0;
   }
+  else
+  {
+    if(!binaries.empty())
+    {
+      msg.status() << "Reading GOTO program from file" << messaget::eom;
+
+      if(read_objects_and_link(binaries, *goto_model, message_handler))
+        throw 0;
+    }
+  }
 
   bool binaries_provided_start =
     symbol_table.has_symbol(goto_functionst::entry_point());
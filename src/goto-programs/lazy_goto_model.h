@@ -42,6 +42,7 @@ public:
   {
     goto_model = std::move(other.goto_model);
     language_files = std::move(other.language_files);
+    goto_binary = std::move(other.goto_binary);
     return *this;
   }
 
@@ -142,6 +143,7 @@ public:
 private:
   const lazy_goto_functions_mapt goto_functions;
   language_filest language_files;
+  lazy_goto_binaryt goto_binary;
 
   // Function/module processing functions
   const post_process_functiont post_process_function;
@@ -47,8 +47,7 @@ static bool link_functions(
   const symbol_tablet &src_symbol_table,
   goto_functionst &src_functions,
   const rename_symbolt &rename_symbol,
-  const std::unordered_set<irep_idt> &weak_symbols,
-  const replace_symbolt &object_type_updates)
+  const std::unordered_set<irep_idt> &weak_symbols)
 {
   namespacet ns(dest_symbol_table);
   namespacet src_ns(src_symbol_table);
@@ -107,6 +106,14 @@ static bool link_functions(
     }
   }
 
+  return false;
+}
+
+/// Replace the uses of macros in all functions by the symbols they stand for
+static void apply_macros(
+  const symbol_tablet &dest_symbol_table,
+  goto_functionst &dest_functions)
+{
   // apply macros
   rename_symbolt macro_application;
 
@@ -139,36 +146,32 @@ static bool link_functions(
       irep_idt final_id=dest_it->first;
       rename_symbols_in_function(dest_it->second, final_id, macro_application);
     }
+}
 
-  if(!object_type_updates.expr_map.empty())
-  {
-    Forall_goto_functions(dest_it, dest_functions)
-      Forall_goto_program_instructions(iit, dest_it->second.body)
-      {
-        object_type_updates(iit->code);
-        object_type_updates(iit->guard);
-      }
-  }
-
-  return false;
+goto_model_linkert::goto_model_linkert(
+  goto_modelt &_dest,
+  message_handlert &_message_handler):
+  dest(_dest),
+  message_handler(_message_handler)
+{
 }
 
-void link_goto_model(
-  goto_modelt &dest,
-  goto_modelt &src,
-  message_handlert &message_handler)
+void goto_model_linkert::link(goto_modelt &src)
 {
+  // only symbols of src can collide
   std::unordered_set<irep_idt> weak_symbols;
 
-  for(const auto &symbol_pair : dest.symbol_table.symbols)
+  for(const auto &symbol_pair : src.symbol_table.symbols)
   {
-    if(symbol_pair.second.is_weak)
+    const symbolt *symbol=dest.symbol_table.lookup(symbol_pair.first);
+    if(symbol!=nullptr && symbol->is_weak)
       weak_symbols.insert(symbol_pair.first);
   }
 
   linkingt linking(dest.symbol_table,
                    src.symbol_table,
                    message_handler);
+  linking.defer_object_type_updates=true;
 
   if(linking.typecheck_main())
     throw 0;
@@ -179,7 +182,49 @@ void link_goto_model(
       src.symbol_table,
       src.goto_functions,
       linking.rename_symbol,
-      weak_symbols,
-      linking.object_type_updates))
+      weak_symbols))
     throw 0;
+
+  // later updates of the same object supersede earlier ones
+  for(const auto &update : linking.object_type_updates.expr_map)
+    object_type_updates.expr_map[update.first]=update.second;
+}
+
+void goto_model_linkert::finalize()
+{
+  apply_macros(dest.symbol_table, dest.goto_functions);
+
+  if(object_type_updates.expr_map.empty())
+    return;
+
+  // initializers
+  for(const auto &named_symbol : dest.symbol_table.symbols)
+  {
+    if(!named_symbol.second.is_type &&
+       !named_symbol.second.is_macro &&
+       named_symbol.second.value.is_not_nil())
+    {
+      object_type_updates(
+        dest.symbol_table.get_writeable_ref(named_symbol.first).value);
+    }
+  }
+
+  Forall_goto_functions(dest_it, dest.goto_functions)
+    Forall_goto_program_instructions(iit, dest_it->second.body)
+    {
+      object_type_updates(iit->code);
+      object_type_updates(iit->guard);
+    }
+
+  object_type_updates.expr_map.clear();
+}
+
+void link_goto_model(
+  goto_modelt &dest,
+  goto_modelt &src,
+  message_handlert &message_handler)
+{
+  goto_model_linkert linker(dest, message_handler);
+  linker.link(src);
+  linker.finalize();
 }
@@ -12,9 +12,36 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_PROGRAMS_LINK_GOTO_MODEL_H
 #define CPROVER_GOTO_PROGRAMS_LINK_GOTO_MODEL_H
 
+#include <util/replace_symbol.h>
+
 class goto_modelt;
 class message_handlert;
 
+/// Links goto models into a destination model one after the other. The
+/// passes over the whole destination that are needed after linking an
+/// object, i.e., applying macros and updates of object types, are deferred
+/// to finalize(). Hence linking n objects takes time linear in their size,
+/// rather than quadratic as with repeated calls to link_goto_model().
+class goto_model_linkert
+{
+public:
+  goto_model_linkert(goto_modelt &_dest, message_handlert &_message_handler);
+
+  /// Merge \p src into the destination, moving its function bodies; throws
+  /// on conflicts
+  void link(goto_modelt &src);
+
+  /// Complete linking after the last call to link()
+  void finalize();
+
+protected:
+  goto_modelt &dest;
+  message_handlert &message_handler;
+
+  /// the accumulated updates of object types, see linkingt
+  replace_symbolt object_type_updates;
+};
+
 void link_goto_model(
   goto_modelt &dest,
   goto_modelt &src,
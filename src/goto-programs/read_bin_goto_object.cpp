@@ -13,62 +13,44 @@ Date: June 2006
 
 #include "read_bin_goto_object.h"
 
+#include <sstream>
+
 #include <util/namespace.h>
 #include <util/message.h>
+#include <util/symbol_serialization.h>
 #include <util/symbol_table.h>
 #include <util/irep_serialization.h>
 
+#include "goto_binary_compression.h"
 #include "goto_functions.h"
 
-/// read goto binary format v3
+void read_bin_shared_ireps(
+  std::istream &in,
+  irep_serializationt &irepconverter)
+{
+  std::size_t count=irepconverter.read_gb_word(in); // # of ireps
+
+  for(std::size_t i=0; i<count && in; i++)
+  {
+    irept irep;
+    irepconverter.reference_convert(in, irep);
+  }
+}
+
+/// read the symbols of a goto binary
 /// \par parameters: input stream, symbol_table, functions
-/// \return true on error, false otherwise
-bool read_bin_goto_object_v3(
+static void read_bin_symbols(
   std::istream &in,
-  const std::string &filename,
   symbol_tablet &symbol_table,
   goto_functionst &functions,
-  message_handlert &message_handler,
   irep_serializationt &irepconverter)
 {
   std::size_t count = irepconverter.read_gb_word(in); // # of symbols
 
-  for(std::size_t i=0; i<count; i++)
+  for(std::size_t i=0; i<count && in; i++)
   {
     symbolt sym;
-
-    irepconverter.reference_convert(in, sym.type);
-    irepconverter.reference_convert(in, sym.value);
-    irepconverter.reference_convert(in, sym.location);
-
-    sym.name = irepconverter.read_string_ref(in);
-    sym.module = irepconverter.read_string_ref(in);
-    sym.base_name = irepconverter.read_string_ref(in);
-    sym.mode = irepconverter.read_string_ref(in);
-    sym.pretty_name = irepconverter.read_string_ref(in);
-
-    // obsolete: symordering
-    irepconverter.read_gb_word(in);
-
-    std::size_t flags=irepconverter.read_gb_word(in);
-
-    sym.is_weak = (flags &(1 << 16))!=0;
-    sym.is_type = (flags &(1 << 15))!=0;
-    sym.is_property = (flags &(1 << 14))!=0;
-    sym.is_macro = (flags &(1 << 13))!=0;
-    sym.is_exported = (flags &(1 << 12))!=0;
-    sym.is_input = (flags &(1 << 11))!=0;
-    sym.is_output = (flags &(1 << 10))!=0;
-    sym.is_state_var = (flags &(1 << 9))!=0;
-    sym.is_parameter = (flags &(1 << 8))!=0;
-    sym.is_auxiliary = (flags &(1 << 7))!=0;
-    // sym.binding = (flags &(1 << 6))!=0;
-    sym.is_lvalue = (flags &(1 << 5))!=0;
-    sym.is_static_lifetime = (flags &(1 << 4))!=0;
-    sym.is_thread_local = (flags &(1 << 3))!=0;
-    sym.is_file_local = (flags &(1 << 2))!=0;
-    sym.is_extern = (flags &(1 << 1))!=0;
-    sym.is_volatile = (flags &1)!=0;
+    read_bin_symbol(in, sym, irepconverter);
 
     if(!sym.is_type && sym.type.id()==ID_code)
     {
@@ -80,82 +62,262 @@ bool read_bin_goto_object_v3(
 
     symbol_table.add(sym);
   }
+}
+
+void read_bin_goto_function(
+  std::istream &in,
+  goto_functiont &f,
+  irep_serializationt &irepconverter)
+{
+  typedef std::map<goto_programt::targett, std::list<unsigned> > target_mapt;
+  target_mapt target_map;
+  typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
+  rev_target_mapt rev_target_map;
+
+  bool hidden=false;
+
+  // the counts are read from the input, hence the loops stop once the
+  // input is exhausted rather than trusting them
+  std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
+  for(std::size_t i=0; i<ins_count && in; i++)
+  {
+    goto_programt::targett itarget = f.body.add_instruction();
+    goto_programt::instructiont &instruction=*itarget;
+
+    irepconverter.reference_convert(in, instruction.code);
+    instruction.function = irepconverter.read_string_ref(in);
+    irepconverter.reference_convert(in, instruction.source_location);
+    instruction.type = (goto_program_instruction_typet)
+                            irepconverter.read_gb_word(in);
+    instruction.guard.make_nil();
+    irepconverter.reference_convert(in, instruction.guard);
+    irepconverter.read_string_ref(in); // former event
+    instruction.target_number = irepconverter.read_gb_word(in);
+    if(instruction.is_target() &&
+       rev_target_map.insert(
+         rev_target_map.end(),
+         std::make_pair(instruction.target_number, itarget))->second!=itarget)
+    {
+      // a target number that occurs twice
+      in.setstate(std::ios::failbit);
+    }
+
+    std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
+    for(std::size_t i=0; i<t_count && in; i++)
+      // just save the target numbers
+      target_map[itarget].push_back(irepconverter.read_gb_word(in));
+
+    std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
+
+    for(std::size_t i=0; i<l_count && in; i++)
+    {
+      irep_idt label=irepconverter.read_string_ref(in);
+      instruction.labels.push_back(label);
+      if(label=="__CPROVER_HIDE")
+        hidden=true;
+      // The above info is normally in the type of the goto_functiont object,
+      // which should likely be stored in the binary.
+    }
+  }
 
-  count=irepconverter.read_gb_word(in); // # of functions
+  // a corrupt or truncated body is reported through the state of in
+  if(!in)
+    return;
+
+  // Resolve targets
+  for(target_mapt::iterator tit = target_map.begin();
+      tit!=target_map.end();
+      tit++)
+  {
+    goto_programt::targett ins = tit->first;
+
+    for(std::list<unsigned>::iterator nit = tit->second.begin();
+        nit!=tit->second.end();
+        nit++)
+    {
+      unsigned n=*nit;
+      rev_target_mapt::const_iterator entry=rev_target_map.find(n);
+      if(entry==rev_target_map.end())
+      {
+        in.setstate(std::ios::failbit);
+        return;
+      }
+      ins->targets.push_back(entry->second);
+    }
+  }
+
+  f.body.update();
+
+  if(hidden)
+    f.make_hidden();
+}
+
+/// read goto binary format v3
+/// \par parameters: input stream, symbol_table, functions
+/// \return true on error, false otherwise
+bool read_bin_goto_object_v3(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler,
+  irep_serializationt &irepconverter)
+{
+  read_bin_symbols(in, symbol_table, functions, irepconverter);
+
+  std::size_t count=irepconverter.read_gb_word(in); // # of functions
 
   for(std::size_t i=0; i<count; i++)
   {
     irep_idt fname=irepconverter.read_gb_string(in);
-    goto_functionst::goto_functiont &f = functions.function_map[fname];
+    read_bin_goto_function(
+      in, functions.function_map[fname], irepconverter);
+  }
+
+  functions.compute_location_numbers();
+
+  return false;
+}
+
+/// Read the compressed section of \p size bytes that is next in \p in and
+/// decompress it into \p dest
+/// \return true on error, false otherwise
+static bool read_bin_compressed_section(
+  std::istream &in,
+  std::size_t size,
+  std::size_t uncompressed_size,
+  std::string &dest)
+{
+  std::string data(size, '\0');
+  if(size!=0 && !in.read(&data[0], size))
+    return true;
+
+  return uncompress_goto_binary_section(
+    data.data(), size, uncompressed_size, dest);
+}
+
+/// read goto binary format v4 or v5, see write_goto_binary_v4; the
+/// sections are read in the order they are stored in
+/// \par parameters: input stream, symbol_table, functions, and whether
+///   sections are compressed, as in version 5
+/// \return true on error, false otherwise
+bool read_bin_goto_object_v4(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler,
+  bool compressed)
+{
+  const goto_binary_section_tablet section_table=
+    read_bin_section_table(in, compressed);
+
+  messaget message(message_handler);
+  std::string uncompressed;
+  irep_serializationt::string_tablet string_table;
+
+  bool strings_error;
+
+  if(compressed)
+  {
+    strings_error=
+      read_bin_compressed_section(
+        in,
+        section_table.strings_size,
+        section_table.strings_uncompressed_size,
+        uncompressed);
+
+    std::istringstream section(uncompressed);
+    strings_error=strings_error || string_table.read(section);
+  }
+  else
+    strings_error=string_table.read(in);
+
+  if(strings_error)
+  {
+    message.error() << "`" << filename << "' is corrupt"
+                    << messaget::eom;
+    return true;
+  }
 
-    typedef std::map<goto_programt::targett, std::list<unsigned> > target_mapt;
-    target_mapt target_map;
-    typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
-    rev_target_mapt rev_target_map;
+  // the ireps of the symbol table, which the function sections refer to
+  irep_serializationt::ireps_containert symbols_ic;
 
-    bool hidden=false;
+  {
+    irep_serializationt irepconverter(symbols_ic, string_table);
 
-    std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
-    for(std::size_t i=0; i<ins_count; i++)
+    if(compressed)
     {
-      goto_programt::targett itarget = f.body.add_instruction();
-      goto_programt::instructiont &instruction=*itarget;
-
-      irepconverter.reference_convert(in, instruction.code);
-      instruction.function = irepconverter.read_string_ref(in);
-      irepconverter.reference_convert(in, instruction.source_location);
-      instruction.type = (goto_program_instruction_typet)
-                              irepconverter.read_gb_word(in);
-      instruction.guard.make_nil();
-      irepconverter.reference_convert(in, instruction.guard);
-      irepconverter.read_string_ref(in); // former event
-      instruction.target_number = irepconverter.read_gb_word(in);
-      if(instruction.is_target() &&
-         rev_target_map.insert(
-           rev_target_map.end(),
-           std::make_pair(instruction.target_number, itarget))->second!=itarget)
-        UNREACHABLE;
-
-      std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
-      for(std::size_t i=0; i<t_count; i++)
-        // just save the target numbers
-        target_map[itarget].push_back(irepconverter.read_gb_word(in));
-
-      std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
-
-      for(std::size_t i=0; i<l_count; i++)
+      if(read_bin_compressed_section(
+           in,
+           section_table.symbols_size,
+           section_table.symbols_uncompressed_size,
+           uncompressed))
+      {
+        message.error() << "`" << filename << "' is corrupt"
+                        << messaget::eom;
+        return true;
+      }
+
+      std::istringstream section(uncompressed);
+      read_bin_shared_ireps(section, irepconverter);
+      read_bin_symbols(section, symbol_table, functions, irepconverter);
+
+      if(!section)
       {
-        irep_idt label=irepconverter.read_string_ref(in);
-        instruction.labels.push_back(label);
-        if(label=="__CPROVER_HIDE")
-          hidden=true;
-        // The above info is normally in the type of the goto_functiont object,
-        // which should likely be stored in the binary.
+        message.error() << "`" << filename << "' is corrupt"
+                        << messaget::eom;
+        return true;
       }
     }
+    else
+    {
+      read_bin_shared_ireps(in, irepconverter);
+      read_bin_symbols(in, symbol_table, functions, irepconverter);
+    }
+  }
+
+  for(const auto &section : section_table.functions)
+  {
+    irep_serializationt::ireps_containert ic;
+    irep_serializationt irepconverter(ic, string_table, &symbols_ic);
+    goto_functiont &goto_function=functions.function_map[section.first];
 
-    // Resolve targets
-    for(target_mapt::iterator tit = target_map.begin();
-        tit!=target_map.end();
-        tit++)
+    if(compressed)
     {
-      goto_programt::targett ins = tit->first;
+      if(read_bin_compressed_section(
+           in,
+           section.second.size,
+           section.second.uncompressed_size,
+           uncompressed))
+      {
+        message.error() << "`" << filename << "' is corrupt"
+                        << messaget::eom;
+        return true;
+      }
 
-      for(std::list<unsigned>::iterator nit = tit->second.begin();
-          nit!=tit->second.end();
-          nit++)
+      std::istringstream function_section(uncompressed);
+      read_bin_goto_function(function_section, goto_function, irepconverter);
+
+      if(!function_section)
       {
-        unsigned n=*nit;
-        rev_target_mapt::const_iterator entry=rev_target_map.find(n);
-        assert(entry!=rev_target_map.end());
-        ins->targets.push_back(entry->second);
+        message.error() << "`" << filename << "' is corrupt"
+                        << messaget::eom;
+        return true;
       }
     }
+    else
+      read_bin_goto_function(in, goto_function, irepconverter);
 
-    f.body.update();
+    if(!in)
+      break;
+  }
 
-    if(hidden)
-      f.make_hidden();
+  if(!in)
+  {
+    message.error() << "`" << filename << "' is truncated"
+                    << messaget::eom;
+    return true;
   }
 
   functions.compute_location_numbers();
@@ -163,6 +325,38 @@ bool read_bin_goto_object_v3(
   return false;
 }
 
+goto_binary_section_tablet read_bin_section_table(
+  std::istream &in,
+  bool compressed)
+{
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+
+  goto_binary_section_tablet section_table;
+  section_table.compressed=compressed;
+  section_table.strings_size=irepconverter.read_gb_word(in);
+  section_table.strings_uncompressed_size=
+    compressed ? irepconverter.read_gb_word(in) : section_table.strings_size;
+  section_table.symbols_size=irepconverter.read_gb_word(in);
+  section_table.symbols_uncompressed_size=
+    compressed ? irepconverter.read_gb_word(in) : section_table.symbols_size;
+
+  std::size_t count=irepconverter.read_gb_word(in); // # of functions
+
+  for(std::size_t i=0; i<count && in; i++)
+  {
+    goto_binary_section_tablet::sectiont section;
+    irep_idt fname=irepconverter.read_gb_string(in);
+    section.offset=irepconverter.read_gb_word(in);
+    section.size=irepconverter.read_gb_word(in);
+    section.uncompressed_size=
+      compressed ? irepconverter.read_gb_word(in) : section.size;
+    section_table.functions.push_back(std::make_pair(fname, section));
+  }
+
+  return section_table;
+}
+
 /// reads a goto binary file back into a symbol and a function table
 /// \par parameters: input stream, symbol table, functions
 /// \return true on error, false otherwise
@@ -235,6 +429,14 @@ bool read_bin_goto_object(
                                      irepconverter);
       break;
 
+    case 4:
+    case 5:
+      return read_bin_goto_object_v4(in, filename,
+                                     symbol_table, functions,
+                                     message_handler,
+                                     version==5);
+      break;
+
     default:
       message.error() <<
           "The input was compiled with an unsupported version of "
@@ -16,10 +16,17 @@ Date: May 2007
 
 #include <iosfwd>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include <util/irep.h>
+
+class symbolt;
 class symbol_tablet;
+class goto_functiont;
 class goto_functionst;
 class message_handlert;
+class irep_serializationt;
 
 bool read_bin_goto_object(
   std::istream &in,
@@ -28,4 +35,48 @@ bool read_bin_goto_object(
   goto_functionst &goto_functions,
   message_handlert &message_handler);
 
+/// The section table of a goto binary of version 4 or later, which follows
+/// the header. The string table section comes first, followed by the symbol
+/// table section; the offsets of the function sections are relative to the
+/// end of the section table. In version 5, each section is compressed on its
+/// own, and the table also records the size of the section once
+/// uncompressed.
+struct goto_binary_section_tablet
+{
+  struct sectiont
+  {
+    std::size_t offset;
+    /// the size as stored
+    std::size_t size;
+    /// the size once uncompressed, which is `size` unless compressed
+    std::size_t uncompressed_size;
+  };
+
+  bool compressed;
+  std::size_t strings_size;
+  std::size_t strings_uncompressed_size;
+  std::size_t symbols_size;
+  std::size_t symbols_uncompressed_size;
+
+  /// the function sections, in the order they are stored in
+  std::vector<std::pair<irep_idt, sectiont>> functions;
+};
+
+goto_binary_section_tablet read_bin_section_table(
+  std::istream &in,
+  bool compressed);
+
+/// Read the ireps that the symbol table section of a goto binary of version
+/// 4 or later begins with, which the function sections may refer to
+void read_bin_shared_ireps(
+  std::istream &in,
+  irep_serializationt &irepconverter);
+
+/// Read a function body, which is corrupt or truncated if \p in fails
+/// afterwards; counts read from \p in do not bound the input consumed
+void read_bin_goto_function(
+  std::istream &in,
+  goto_functiont &goto_function,
+  irep_serializationt &irepconverter);
+
 #endif // CPROVER_GOTO_PROGRAMS_READ_BIN_GOTO_OBJECT_H
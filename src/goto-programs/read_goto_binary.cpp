@@ -246,6 +246,52 @@ bool read_object_and_link(
   return false;
 }
 
+/// reads object files and links them, in the order given; unlike repeated
+/// calls to read_object_and_link, the whole-program passes of linking are
+/// made once only
+/// \return true on error, false otherwise
+bool read_objects_and_link(
+  const std::vector<std::string> &file_names,
+  goto_modelt &dest,
+  message_handlert &message_handler)
+{
+  if(file_names.empty())
+    return false;
+
+  goto_model_linkert linker(dest, message_handler);
+
+  try
+  {
+    for(const auto &file_name : file_names)
+    {
+      messaget(message_handler).statistics() << "Reading: "
+                                             << file_name << messaget::eom;
+
+      // we read into a temporary model, whose functions are moved to dest
+      goto_modelt temp_model;
+
+      if(read_goto_binary(
+          file_name,
+          temp_model,
+          message_handler))
+        return true;
+
+      linker.link(temp_model);
+    }
+
+    linker.finalize();
+  }
+  catch(...)
+  {
+    return true;
+  }
+
+  // reading successful, let's update config
+  config.set_from_symbol_table(dest.symbol_table);
+
+  return false;
+}
+
 /// reads an object file
 /// \par parameters: a file_name
 /// \return true on error, false otherwise
@@ -270,3 +316,27 @@ bool read_object_and_link(
 
   return result;
 }
+
+/// reads object files and links them, in the order given
+/// \return true on error, false otherwise
+bool read_objects_and_link(
+  const std::vector<std::string> &file_names,
+  symbol_tablet &dest_symbol_table,
+  goto_functionst &dest_functions,
+  message_handlert &message_handler)
+{
+  goto_modelt goto_model;
+
+  goto_model.symbol_table.swap(dest_symbol_table);
+  goto_model.goto_functions.swap(dest_functions);
+
+  bool result=read_objects_and_link(
+    file_names,
+    goto_model,
+    message_handler);
+
+  goto_model.symbol_table.swap(dest_symbol_table);
+  goto_model.goto_functions.swap(dest_functions);
+
+  return result;
+}
@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_GOTO_PROGRAMS_READ_GOTO_BINARY_H
 
 #include <string>
+#include <vector>
 
 class goto_functionst;
 class goto_modelt;
@@ -43,4 +44,15 @@ bool read_object_and_link(
   goto_modelt &,
   message_handlert &);
 
+bool read_objects_and_link(
+  const std::vector<std::string> &file_names,
+  symbol_tablet &,
+  goto_functionst &,
+  message_handlert &);
+
+bool read_objects_and_link(
+  const std::vector<std::string> &file_names,
+  goto_modelt &,
+  message_handlert &);
+
 #endif // CPROVER_GOTO_PROGRAMS_READ_GOTO_BINARY_H
@@ -12,14 +12,52 @@ Author: CM Wintersteiger
 #include "write_goto_binary.h"
 
 #include <fstream>
+#include <sstream>
 
 #include <util/message.h>
 #include <util/irep_serialization.h>
+#include <util/symbol_serialization.h>
 #include <util/symbol_table.h>
 
 #include <goto-programs/goto_model.h>
 
-/// Writes a goto program to disc, using goto binary format ver 2
+#include "goto_binary_compression.h"
+
+static void write_bin_goto_program(
+  std::ostream &out,
+  const goto_programt &goto_program,
+  irep_serializationt &irepconverter)
+{
+  // Since version 2, goto functions are not converted to ireps,
+  // instead they are saved in a custom binary format
+
+  write_gb_word(out, goto_program.instructions.size()); // # instructions
+
+  forall_goto_program_instructions(i_it, goto_program)
+  {
+    const goto_programt::instructiont &instruction = *i_it;
+
+    irepconverter.reference_convert(instruction.code, out);
+    irepconverter.write_string_ref(out, instruction.function);
+    irepconverter.reference_convert(instruction.source_location, out);
+    write_gb_word(out, (long)instruction.type);
+    irepconverter.reference_convert(instruction.guard, out);
+    irepconverter.write_string_ref(out, irep_idt()); // former event
+    write_gb_word(out, instruction.target_number);
+
+    write_gb_word(out, instruction.targets.size());
+
+    for(const auto &t_it : instruction.targets)
+      write_gb_word(out, t_it->target_number);
+
+    write_gb_word(out, instruction.labels.size());
+
+    for(const auto &l_it : instruction.labels)
+      irepconverter.write_string_ref(out, l_it);
+  }
+}
+
+/// Writes a goto program to disc, using goto binary format ver 3
 bool write_goto_binary_v3(
   std::ostream &out,
   const symbol_tablet &symbol_table,
@@ -31,45 +69,7 @@ bool write_goto_binary_v3(
   write_gb_word(out, symbol_table.symbols.size());
 
   for(const auto &symbol_pair : symbol_table.symbols)
-  {
-    // Since version 2, symbols are not converted to ireps,
-    // instead they are saved in a custom binary format
-
-    const symbolt &sym = symbol_pair.second;
-
-    irepconverter.reference_convert(sym.type, out);
-    irepconverter.reference_convert(sym.value, out);
-    irepconverter.reference_convert(sym.location, out);
-
-    irepconverter.write_string_ref(out, sym.name);
-    irepconverter.write_string_ref(out, sym.module);
-    irepconverter.write_string_ref(out, sym.base_name);
-    irepconverter.write_string_ref(out, sym.mode);
-    irepconverter.write_string_ref(out, sym.pretty_name);
-
-    write_gb_word(out, 0); // old: sym.ordering
-
-    unsigned flags=0;
-    flags = (flags << 1) | static_cast<int>(sym.is_weak);
-    flags = (flags << 1) | static_cast<int>(sym.is_type);
-    flags = (flags << 1) | static_cast<int>(sym.is_property);
-    flags = (flags << 1) | static_cast<int>(sym.is_macro);
-    flags = (flags << 1) | static_cast<int>(sym.is_exported);
-    flags = (flags << 1) | static_cast<int>(sym.is_input);
-    flags = (flags << 1) | static_cast<int>(sym.is_output);
-    flags = (flags << 1) | static_cast<int>(sym.is_state_var);
-    flags = (flags << 1) | static_cast<int>(sym.is_parameter);
-    flags = (flags << 1) | static_cast<int>(sym.is_auxiliary);
-    flags = (flags << 1) | static_cast<int>(false); // sym.binding;
-    flags = (flags << 1) | static_cast<int>(sym.is_lvalue);
-    flags = (flags << 1) | static_cast<int>(sym.is_static_lifetime);
-    flags = (flags << 1) | static_cast<int>(sym.is_thread_local);
-    flags = (flags << 1) | static_cast<int>(sym.is_file_local);
-    flags = (flags << 1) | static_cast<int>(sym.is_extern);
-    flags = (flags << 1) | static_cast<int>(sym.is_volatile);
-
-    write_gb_word(out, flags);
-  }
+    write_bin_symbol(out, symbol_pair.second, irepconverter);
 
   // now write functions, but only those with body
 
@@ -84,39 +84,237 @@ bool write_goto_binary_v3(
   {
     if(fct.second.body_available())
     {
-      // Since version 2, goto functions are not converted to ireps,
-      // instead they are saved in a custom binary format
-
       write_gb_string(out, id2string(fct.first)); // name
-      write_gb_word(out, fct.second.body.instructions.size()); // # instructions
+      write_bin_goto_program(out, fct.second.body, irepconverter);
+    }
+  }
 
-      forall_goto_program_instructions(i_it, fct.second.body)
-      {
-        const goto_programt::instructiont &instruction = *i_it;
+  // irepconverter.output_map(f);
+  // irepconverter.output_string_map(f);
 
-        irepconverter.reference_convert(instruction.code, out);
-        irepconverter.write_string_ref(out, instruction.function);
-        irepconverter.reference_convert(instruction.source_location, out);
-        write_gb_word(out, (long)instruction.type);
-        irepconverter.reference_convert(instruction.guard, out);
-        irepconverter.write_string_ref(out, irep_idt()); // former event
-        write_gb_word(out, instruction.target_number);
+  return false;
+}
 
-        write_gb_word(out, instruction.targets.size());
+/// Collects the ireps that occur in more than one section of a goto binary
+/// of version 4, see write_goto_binary_v4. As any sub-irep of such an irep
+/// occurs in the same sections, these ireps are closed under sub-ireps.
+/// The ireps are visited through their nodes in the numbering, hence each
+/// one is looked up by address only once per section.
+class shared_irepst
+{
+public:
+  explicit shared_irepst(
+    irep_serializationt::packed_numberingt &_numbering):
+    numbering(_numbering),
+    section(0)
+  {
+  }
 
-        for(const auto &t_it : instruction.targets)
-          write_gb_word(out, t_it->target_number);
+  /// the numbers of the ireps, in the order they were found to be shared
+  std::vector<std::size_t> ireps;
 
-        write_gb_word(out, instruction.labels.size());
+  void next_section()
+  {
+    section++;
+  }
+
+  void operator()(const irept &irep)
+  {
+    add(numbering.number(irep));
+  }
 
-        for(const auto &l_it : instruction.labels)
-          irepconverter.write_string_ref(out, l_it);
+protected:
+  irep_serializationt::packed_numberingt &numbering;
+  std::size_t section;
+  /// by number: the last section an irep occurs in, and the number of
+  /// sections it occurs in
+  std::vector<std::pair<std::size_t, std::size_t>> sections;
+
+  void add(std::size_t n)
+  {
+    if(n>=sections.size())
+      sections.resize(numbering.size(), std::make_pair(0, 0));
+
+    // sections are numbered from one
+    std::pair<std::size_t, std::size_t> &entry=sections[n];
+    if(entry.first==section)
+      return;
+
+    entry.first=section;
+    if(++entry.second==2)
+      ireps.push_back(n);
+
+    // see packed_numberingt::node for the layout
+    const std::size_t *node=numbering.node(n)+1;
+
+    const std::size_t sub_count=*node++;
+    for(std::size_t i=0; i<sub_count; i++)
+      add(*node++);
+
+    for(unsigned i=0; i<2; i++) // named operands, then comments
+    {
+      const std::size_t count=*node++;
+      for(std::size_t j=0; j<count; j++, node+=2)
+        add(node[1]);
+    }
+  }
+};
+
+/// A section of a goto binary as it is stored in the file, and the number
+/// of bytes it decodes to
+struct written_sectiont
+{
+  std::string data;
+  std::size_t uncompressed_size;
+};
+
+/// Serialise a section of a goto binary by passing a stream to \p writer,
+/// compressing it as it is written if \p compressed holds
+template <typename writert>
+static written_sectiont write_section(bool compressed, writert writer)
+{
+  written_sectiont section;
+
+  if(compressed)
+  {
+    compressed_goto_binary_sectiont out;
+    writer(out);
+    section.data=out.finish();
+    section.uncompressed_size=out.uncompressed_size();
+  }
+  else
+  {
+    std::ostringstream out;
+    writer(out);
+    section.data=out.str();
+    section.uncompressed_size=section.data.size();
+  }
+
+  return section;
+}
+
+/// Writes a goto program to disc, using goto binary format ver 4: the
+/// symbol table and each function body are serialised into sections of
+/// their own, using the packed encoding of ireps, see irep_serializationt.
+/// The strings of all sections are stored once, in a section that precedes
+/// the others. The ireps that occur in more than one section are stored
+/// once, at the beginning of the symbol table section, which is always
+/// decoded; a function section may refer to the ireps of the symbol table
+/// section, but not to those of other function sections. A section table
+/// with the offset and size of each section precedes the sections. This
+/// permits decoding function bodies individually, see lazy_goto_binaryt.
+/// Version 5
+/// is version 4 with each section compressed on its own, which keeps the
+/// sections individually decodable; the section table then also records
+/// the uncompressed sizes. Sections are compressed as they are serialised,
+/// but the strings are only known once all sections have been serialised,
+/// hence the sections are held in memory until they are written.
+bool write_goto_binary_v4(
+  std::ostream &out,
+  const symbol_tablet &symbol_table,
+  const goto_functionst &goto_functions,
+  bool compressed)
+{
+  irep_serializationt::string_tablet string_table;
+  // the ireps of the symbol table, which the function sections refer to
+  irep_serializationt::ireps_containert symbols_irepc;
+  written_sectiont symbols;
+
+  {
+    irep_serializationt irepconverter(symbols_irepc, string_table);
+    shared_irepst shared_ireps(irepconverter.numbering());
+
+    shared_ireps.next_section();
+    for(const auto &symbol_pair : symbol_table.symbols)
+    {
+      shared_ireps(symbol_pair.second.type);
+      shared_ireps(symbol_pair.second.value);
+      shared_ireps(symbol_pair.second.location);
+    }
+
+    for(const auto &fct : goto_functions.function_map)
+    {
+      if(!fct.second.body_available())
+        continue;
+
+      shared_ireps.next_section();
+      for(const auto &instruction : fct.second.body.instructions)
+      {
+        shared_ireps(instruction.code);
+        shared_ireps(instruction.source_location);
+        shared_ireps(instruction.guard);
       }
     }
+
+    symbols=write_section(
+      compressed,
+      [&](std::ostream &section)
+      {
+        write_gb_word(section, shared_ireps.ireps.size());
+        for(const auto n : shared_ireps.ireps)
+          irepconverter.reference_convert(n, section);
+
+        write_gb_word(section, symbol_table.symbols.size());
+
+        for(const auto &symbol_pair : symbol_table.symbols)
+          write_bin_symbol(section, symbol_pair.second, irepconverter);
+      });
   }
 
-  // irepconverter.output_map(f);
-  // irepconverter.output_string_map(f);
+  std::vector<std::pair<irep_idt, written_sectiont>> function_sections;
+
+  for(const auto &fct : goto_functions.function_map)
+  {
+    if(!fct.second.body_available())
+      continue;
+
+    irep_serializationt::ireps_containert irepc;
+    irep_serializationt irepconverter(irepc, string_table, &symbols_irepc);
+
+    function_sections.push_back(
+      std::make_pair(
+        fct.first,
+        write_section(
+          compressed,
+          [&](std::ostream &section)
+          {
+            write_bin_goto_program(section, fct.second.body, irepconverter);
+          })));
+  }
+
+  const written_sectiont strings=write_section(
+    compressed,
+    [&string_table](std::ostream &section)
+    {
+      string_table.write(section);
+    });
+
+  // the section table; offsets are relative to the end of the table, and
+  // the strings and the symbols come first
+  write_gb_word(out, strings.data.size());
+  if(compressed)
+    write_gb_word(out, strings.uncompressed_size);
+  write_gb_word(out, symbols.data.size());
+  if(compressed)
+    write_gb_word(out, symbols.uncompressed_size);
+  write_gb_word(out, function_sections.size());
+
+  std::size_t offset=strings.data.size()+symbols.data.size();
+
+  for(const auto &section : function_sections)
+  {
+    write_gb_string(out, id2string(section.first));
+    write_gb_word(out, offset);
+    write_gb_word(out, section.second.data.size());
+    if(compressed)
+      write_gb_word(out, section.second.uncompressed_size);
+    offset+=section.second.data.size();
+  }
+
+  out << strings.data << symbols.data;
+
+  for(const auto &section : function_sections)
+    out << section.second.data;
 
   return false;
 }
@@ -160,6 +358,11 @@ bool write_goto_binary(
     return write_goto_binary_v3(
       out, symbol_table, goto_functions, irepconverter);
 
+  case 4:
+  case 5:
+    return write_goto_binary_v4(
+      out, symbol_table, goto_functions, version==5);
+
   default:
     throw "unknown goto binary version";
   }
@@ -171,7 +374,8 @@ bool write_goto_binary(
 bool write_goto_binary(
   const std::string &filename,
   const goto_modelt &goto_model,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  int version)
 {
   std::ofstream out(filename, std::ios::binary);
 
@@ -183,5 +387,5 @@ bool write_goto_binary(
     return true;
   }
 
-  return write_goto_binary(out, goto_model);
+  return write_goto_binary(out, goto_model, version);
 }
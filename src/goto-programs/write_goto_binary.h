@@ -12,7 +12,9 @@ Author: CM Wintersteiger
 #ifndef CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H
 #define CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H
 
-#define GOTO_BINARY_VERSION 3
+#define GOTO_BINARY_VERSION 4
+/// the version with compressed sections, written on request only
+#define GOTO_BINARY_COMPRESSED_VERSION 5
 
 #include <iosfwd>
 #include <string>
@@ -36,6 +38,7 @@ bool write_goto_binary(
 bool write_goto_binary(
   const std::string &filename,
   const goto_modelt &,
-  message_handlert &);
+  message_handlert &,
+  int version=GOTO_BINARY_VERSION);
 
 #endif // CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H
@@ -209,6 +209,12 @@ public:
   /// if we know the source language in use, irep_idt() otherwise.
   irep_idt language_mode;
 
+  /// Objects with static lifetime that threads do not access concurrently,
+  /// as found by a static analysis of the program. Accesses to these are
+  /// encoded like those to thread-local objects, without shared read and
+  /// write events for the memory model.
+  std::unordered_set<irep_idt> thread_independent_objects;
+
 protected:
   /// The symbol table associated with the goto-program that we're
   /// executing. This symbol table will not additionally contain objects
@@ -25,8 +25,10 @@ goto_symex_statet::goto_symex_statet()
   : depth(0),
     symex_target(nullptr),
     atomic_section_id(0),
+    thread_independent_objects(nullptr),
     record_events(true),
-    dirty()
+    dirty(),
+    merging_paths(false)
 {
   threads.resize(1);
   new_frame();
@@ -522,6 +524,22 @@ void goto_symex_statet::rename(
   }
 }
 
+bool goto_symex_statet::is_shared_object(
+  const irep_idt &identifier,
+  const namespacet &ns) const
+{
+  if(identifier=="goto_symex::\\guard")
+    return false;
+
+  // these are accessed like thread-local objects
+  if(thread_independent_objects!=nullptr &&
+     thread_independent_objects->find(identifier)!=
+       thread_independent_objects->end())
+    return false;
+
+  return ns.lookup(identifier).is_shared() || dirty(identifier);
+}
+
 /// thread encoding
 bool goto_symex_statet::l2_thread_read_encoding(
   ssa_exprt &expr,
@@ -533,9 +551,7 @@ bool goto_symex_statet::l2_thread_read_encoding(
 
   // is it a shared object?
   const irep_idt &obj_identifier=expr.get_object_name();
-  if(
-    obj_identifier == "goto_symex::\\guard" ||
-    (!ns.lookup(obj_identifier).is_shared() && !(dirty)(obj_identifier)))
+  if(!is_shared_object(obj_identifier, ns))
     return false;
 
   ssa_exprt ssa_l1=expr;
@@ -677,9 +693,7 @@ bool goto_symex_statet::l2_thread_write_encoding(
 
   // is it a shared object?
   const irep_idt &obj_identifier=expr.get_object_name();
-  if(
-    obj_identifier == "goto_symex::\\guard" ||
-    (!ns.lookup(obj_identifier).is_shared() && !(dirty)(obj_identifier)))
+  if(!is_shared_object(obj_identifier, ns))
     return false; // not shared
 
   // see whether we are within an atomic section
@@ -364,6 +364,14 @@ public:
   bool l2_thread_read_encoding(ssa_exprt &expr, const namespacet &ns);
   bool l2_thread_write_encoding(const ssa_exprt &expr, const namespacet &ns);
 
+  /// Objects that threads do not access concurrently, see
+  /// \ref goto_symext::thread_independent_objects; may be null
+  const std::unordered_set<irep_idt> *thread_independent_objects;
+
+  /// Are the accesses to \p identifier recorded as shared read and write
+  /// events when there are threads?
+  bool is_shared_object(const irep_idt &identifier, const namespacet &ns) const;
+
   void populate_dirty_for_function(
     const irep_idt &id, const goto_functiont &);
 
@@ -381,6 +389,12 @@ public:
   bool has_saved_next_instruction;
   bool saved_target_is_backwards;
 
+  /// \brief With path exploration, the paths through a branch are merged
+  /// rather than saved until `merge_join` is reached, see
+  /// \ref path_storaget::merge_paths
+  bool merging_paths;
+  goto_programt::const_targett merge_join;
+
 private:
   /// \brief Dangerous, do not use
   ///
@@ -15,6 +15,7 @@ Author: Michael Tautschnig, michael.tautschnig@cs.ox.ac.uk
 
 memory_model_baset::memory_model_baset(const namespacet &_ns):
   partial_order_concurrencyt(_ns),
+  lazy(false),
   var_cnt(0)
 {
 }
@@ -98,7 +99,8 @@ void memory_model_baset::read_from(symex_target_equationt &equation)
         add_constraint(equation,
           read_from, is_rfi?"rfi":"rf", r->source);
 
-        if(!is_rfi)
+        // when encoding lazily, this is added on demand
+        if(!is_rfi && !lazy)
         {
           // if r reads from w, then w must have happened before r
           const implies_exprt cond(s, before(w, r));
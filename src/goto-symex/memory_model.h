@@ -14,6 +14,8 @@ Author: Michael Tautschnig, michael.tautschnig@cs.ox.ac.uk
 
 #include "partial_order_concurrency.h"
 
+class prop_convt;
+
 class memory_model_baset:public partial_order_concurrencyt
 {
 public:
@@ -22,7 +24,24 @@ public:
 
   virtual void operator()(symex_target_equationt &)=0;
 
+  /// Does the memory model leave constraints to \ref refine?
+  bool is_lazy() const
+  {
+    return lazy;
+  }
+
+  /// Add those constraints that a lazy encoding has left out and that the
+  /// satisfying assignment of \p prop_conv violates
+  /// \return true if constraints have been added, in which case the formula
+  ///   needs to be solved again
+  virtual bool refine(prop_convt &)
+  {
+    return false;
+  }
+
 protected:
+  bool lazy;
+
   // program order
   bool po(event_it e1, event_it e2);
 
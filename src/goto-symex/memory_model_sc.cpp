@@ -11,8 +11,13 @@ Author: Michael Tautschnig, michael.tautschnig@cs.ox.ac.uk
 
 #include "memory_model_sc.h"
 
+#include <iterator>
+
+#include <util/simplify_expr.h>
 #include <util/std_expr.h>
 
+#include <solvers/prop/prop_conv.h>
+
 void memory_model_sct::operator()(symex_target_equationt &equation)
 {
   statistics() << "Adding SC constraints" << eom;
@@ -21,9 +26,14 @@ void memory_model_sct::operator()(symex_target_equationt &equation)
   build_clock_type(equation);
 
   read_from(equation);
-  write_serialization_external(equation);
   program_order(equation);
-  from_read(equation);
+
+  // when encoding lazily, these are added by refine
+  if(!lazy)
+  {
+    write_serialization_external(equation);
+    from_read(equation);
+  }
 }
 
 exprt memory_model_sct::before(event_it e1, event_it e2)
@@ -333,3 +343,147 @@ void memory_model_sct::from_read(symex_target_equationt &equation)
     }
   }
 }
+
+bool memory_model_sct::refine(prop_convt &prop_conv)
+{
+  if(!lazy)
+    return false;
+
+  const std::size_t ws=refine_write_serialization_external(prop_conv);
+  const std::size_t rf=refine_read_from(prop_conv);
+
+  if(ws==0 && rf==0)
+    return false;
+
+  statistics() << "Refining SC constraints: " << ws << " ws-ext, "
+               << rf << " rf-order/fr" << eom;
+
+  return true;
+}
+
+/// Does \p expr evaluate to true in the satisfying assignment of
+/// \p prop_conv? Expressions over symbols that have not been converted do
+/// not evaluate to a constant, and thus do not hold.
+bool memory_model_sct::holds(
+  const prop_convt &prop_conv,
+  const exprt &expr) const
+{
+  exprt value=prop_conv.get(expr);
+  simplify(value, ns);
+  return value.is_true();
+}
+
+/// Add \p cond to the formula of \p prop_conv, unless it has been added
+/// before, which avoids adding constraints that do not evaluate over and
+/// over again
+/// \return true if the constraint has been added
+bool memory_model_sct::add_refinement(
+  prop_convt &prop_conv,
+  const exprt &cond)
+{
+  exprt tmp=cond;
+  simplify(tmp, ns);
+
+  if(!refinements.insert(tmp).second)
+    return false;
+
+  prop_conv.set_to_true(tmp);
+  return true;
+}
+
+std::size_t memory_model_sct::refine_write_serialization_external(
+  prop_convt &prop_conv)
+{
+  std::size_t added=0;
+
+  for(const auto &address : address_map)
+  {
+    const a_rect &a_rec=address.second;
+
+    for(event_listt::const_iterator
+        w_it1=a_rec.writes.begin();
+        w_it1!=a_rec.writes.end();
+        ++w_it1)
+    {
+      for(event_listt::const_iterator w_it2=std::next(w_it1);
+          w_it2!=a_rec.writes.end();
+          ++w_it2)
+      {
+        // external?
+        if((*w_it1)->source.thread_nr==
+           (*w_it2)->source.thread_nr)
+          continue;
+
+        // ws is a total order, no two elements have the same rank; this is
+        // what the choice symbol of write_serialization_external amounts to
+        const or_exprt ws(
+          before(*w_it1, *w_it2),
+          before(*w_it2, *w_it1));
+
+        if(!holds(prop_conv, ws) && add_refinement(prop_conv, ws))
+          added++;
+      }
+    }
+  }
+
+  return added;
+}
+
+std::size_t memory_model_sct::refine_read_from(prop_convt &prop_conv)
+{
+  std::size_t added=0;
+
+  for(const auto &choice : choice_symbols)
+  {
+    const event_it r=choice.first.first;
+    const event_it w_prime=choice.first.second;
+    const symbol_exprt &rf=choice.second;
+
+    // only the write that r reads from in this assignment matters
+    if(!holds(prop_conv, rf))
+      continue;
+
+    if(w_prime->source.thread_nr!=r->source.thread_nr)
+    {
+      // if r reads from w', then w' must have happened before r
+      const implies_exprt cond(rf, before(w_prime, r));
+
+      if(!holds(prop_conv, cond) && add_refinement(prop_conv, cond))
+        added++;
+    }
+
+    if(prop_conv.l_get(r->guard_literal).is_false())
+      continue;
+
+    const address_mapt::const_iterator a_it=address_map.find(address(r));
+    INVARIANT(
+      a_it!=address_map.end(), "reads are recorded with their address");
+
+    // from-read: (w', w) in ws and (w', r) in rf -> (r, w) in fr
+    for(const auto &w : a_it->second.writes)
+    {
+      if(w==w_prime)
+        continue;
+
+      exprt ws;
+
+      if(po(w_prime, w) &&
+         !program_order_is_relaxed(w_prime, w))
+        ws=true_exprt();
+      else if(po(w, w_prime) &&
+              !program_order_is_relaxed(w, w_prime))
+        continue;
+      else
+        ws=before(w_prime, w);
+
+      const implies_exprt cond(
+        and_exprt(r->guard, w->guard, ws, rf),
+        before(r, w));
+
+      if(!holds(prop_conv, cond) && add_refinement(prop_conv, cond))
+        added++;
+    }
+  }
+
+  return added;
+}
@@ -12,6 +12,8 @@ Author: Michael Tautschnig, michael.tautschnig@cs.ox.ac.uk
 #ifndef CPROVER_GOTO_SYMEX_MEMORY_MODEL_SC_H
 #define CPROVER_GOTO_SYMEX_MEMORY_MODEL_SC_H
 
+#include <unordered_set>
+
 #include "memory_model.h"
 
 class memory_model_sct:public memory_model_baset
@@ -24,6 +26,17 @@ public:
 
   virtual void operator()(symex_target_equationt &equation);
 
+  /// Encode the write serialisation, from-read and read-from order
+  /// constraints, which are quadratic and cubic in the number of events per
+  /// address, on demand: \ref refine adds them only where a satisfying
+  /// assignment violates them
+  void set_lazy(bool _lazy)
+  {
+    lazy=_lazy;
+  }
+
+  virtual bool refine(prop_convt &prop_conv);
+
 protected:
   virtual exprt before(event_it e1, event_it e2);
   virtual bool program_order_is_relaxed(
@@ -39,6 +52,14 @@ protected:
   void program_order(symex_target_equationt &equation);
   void from_read(symex_target_equationt &equation);
   void write_serialization_external(symex_target_equationt &equation);
+
+  // the constraints added by refine
+  std::unordered_set<exprt, irep_hash> refinements;
+
+  bool holds(const prop_convt &prop_conv, const exprt &expr) const;
+  bool add_refinement(prop_convt &prop_conv, const exprt &cond);
+  std::size_t refine_write_serialization_external(prop_convt &prop_conv);
+  std::size_t refine_read_from(prop_convt &prop_conv);
 };
 
 #endif // CPROVER_GOTO_SYMEX_MEMORY_MODEL_SC_H
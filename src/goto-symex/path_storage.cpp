@@ -8,10 +8,15 @@ Author: Kareem Khazem <karkhaz@karkhaz.com>
 
 #include "path_storage.h"
 
+#include <limits>
 #include <sstream>
 
 #include <util/exit_codes.h>
 #include <util/make_unique.h>
+#include <util/std_code.h>
+#include <util/std_expr.h>
+
+#include <goto-programs/goto_functions.h>
 
 // _____________________________________________________________________________
 // path_lifot
@@ -69,6 +74,286 @@ std::size_t path_fifot::size() const
   return paths.size();
 }
 
+// _____________________________________________________________________________
+// path_merging_lifot
+
+bool path_merging_lifot::merge_paths(
+  goto_programt::const_targett branch,
+  goto_programt::const_targett &join)
+{
+  if(branch->is_backwards_goto())
+    return false;
+
+  // the paths join once all jumps out of the instructions between the branch
+  // and its target have been passed
+  join = branch->get_target();
+  std::size_t region_size = 0;
+
+  for(auto it = std::next(branch); it != join; ++it)
+  {
+    if(++region_size > max_region_size)
+      return false;
+
+    if(it->is_goto())
+    {
+      if(it->is_backwards_goto() || it->targets.size() != 1)
+        return false;
+
+      if(it->get_target()->location_number > join->location_number)
+        join = it->get_target();
+    }
+    else if(
+      it->is_function_call() || it->is_start_thread() ||
+      it->is_end_thread() || it->is_atomic_begin() || it->is_atomic_end() ||
+      it->is_throw() || it->is_catch() || it->is_end_function())
+      return false;
+  }
+
+  return true;
+}
+
+// _____________________________________________________________________________
+// path_random_restartt
+
+path_storaget::patht &path_random_restartt::private_peek()
+{
+  last_peeked = paths.end();
+  --last_peeked;
+
+  if(++resumptions % restart_interval == 0 && paths.size() > 1)
+  {
+    // the output of std::uniform_int_distribution differs between standard
+    // libraries, that of the generator does not
+    const std::size_t choice = generator() % (paths.size() - 1);
+    last_peeked = std::next(paths.begin(), choice);
+  }
+
+  return *last_peeked;
+}
+
+// _____________________________________________________________________________
+// path_priorityt
+
+void path_priorityt::save(const patht &path)
+{
+  entries.emplace_back(path, saved++);
+  const entry_itt entry = std::prev(entries.end());
+  entry->score = score(entry->target);
+  queue.insert(entry);
+  targets.emplace(&*entry->target, entry);
+}
+
+void path_priorityt::push(
+  const path_storaget::patht &next_instruction,
+  const path_storaget::patht &jump_target)
+{
+  save(next_instruction);
+  save(jump_target);
+}
+
+void path_priorityt::rescore(goto_programt::const_targett target)
+{
+  const auto range = targets.equal_range(&*target);
+  if(range.first == range.second)
+    return;
+
+  const std::size_t new_score = score(target);
+  for(auto it = range.first; it != range.second; ++it)
+  {
+    if(new_score == it->second->score)
+      continue;
+
+    // the order of the queue must not change while an entry is in it
+    queue.erase(it->second);
+    it->second->score = new_score;
+    queue.insert(it->second);
+  }
+}
+
+void path_priorityt::rescore()
+{
+  queue.clear();
+  for(entry_itt it = entries.begin(); it != entries.end(); ++it)
+  {
+    it->score = score(it->target);
+    queue.insert(it);
+  }
+}
+
+path_storaget::patht &path_priorityt::private_peek()
+{
+  last_peeked = *queue.begin();
+  return last_peeked->path;
+}
+
+void path_priorityt::private_pop()
+{
+  PRECONDITION(last_peeked != entries.end());
+  queue.erase(last_peeked);
+
+  const auto range = targets.equal_range(&*last_peeked->target);
+  for(auto it = range.first; it != range.second; ++it)
+  {
+    if(it->second == last_peeked)
+    {
+      targets.erase(it);
+      break;
+    }
+  }
+
+  entries.erase(last_peeked);
+  last_peeked = entries.end();
+}
+
+std::size_t path_priorityt::size() const
+{
+  return entries.size();
+}
+
+// _____________________________________________________________________________
+// path_coveraget
+
+void path_coveraget::executed(goto_programt::const_targett pc)
+{
+  ++execution_counts[&*pc];
+  rescore(pc);
+}
+
+std::size_t path_coveraget::score(goto_programt::const_targett target)
+{
+  const auto entry = execution_counts.find(&*target);
+  return entry == execution_counts.end() ? 0 : entry->second;
+}
+
+// _____________________________________________________________________________
+// path_distancet
+
+void path_distancet::set_program(const goto_functionst &goto_functions)
+{
+  program = util_make_unique<frozen_goto_functionst>(goto_functions);
+  const frozen_goto_functionst::function_mapt &function_map =
+    program->get_function_map();
+
+  first_nodes.clear();
+  std::size_t node_count = 0;
+  for(const auto &function : function_map)
+  {
+    first_nodes[function.first] = node_count;
+    node_count += function.second.size();
+  }
+
+  nodes.clear();
+  nodes.resize(node_count);
+
+  for(const auto &function : function_map)
+  {
+    const frozen_goto_programt &body = function.second;
+    const std::size_t first = first_nodes[function.first];
+
+    for(frozen_goto_programt::targett i = 0; i < body.size(); ++i)
+    {
+      nodes[first + i].assertion = body[i].is_assert();
+
+      if(body[i].is_function_call())
+      {
+        const exprt &callee = to_code_function_call(body[i].code).function();
+        const auto callee_body =
+          callee.id() == ID_symbol
+            ? function_map.find(to_symbol_expr(callee).get_identifier())
+            : function_map.end();
+
+        if(callee_body != function_map.end() && !callee_body->second.empty())
+        {
+          const std::size_t callee_first = first_nodes[callee_body->first];
+          nodes[callee_first].predecessors.push_back(first + i);
+          if(i + 1 < body.size())
+          {
+            nodes[first + i + 1].predecessors.push_back(
+              callee_first + callee_body->second.size() - 1);
+          }
+          continue;
+        }
+      }
+
+      for(const auto successor : body.get_successors(i))
+        nodes[first + successor].predecessors.push_back(first + i);
+    }
+  }
+
+  update_distances();
+  rescore();
+}
+
+std::size_t path_distancet::node(goto_programt::const_targett pc) const
+{
+  if(!program)
+    return nodes.size();
+
+  const auto function = program->get_function_map().find(pc->function);
+  if(function == program->get_function_map().end())
+    return nodes.size();
+
+  // location numbers may be local to functions in lazily loaded programs,
+  // but are ordered within each function
+  const frozen_goto_programt::targett target =
+    function->second.find_location(pc->location_number);
+  if(target == function->second.size())
+    return nodes.size();
+
+  return first_nodes.at(function->first) + target;
+}
+
+void path_distancet::executed(goto_programt::const_targett pc)
+{
+  const std::size_t n = node(pc);
+  if(n < nodes.size() && nodes[n].assertion && !nodes[n].reached)
+  {
+    nodes[n].reached = true;
+    update_distances();
+    rescore();
+  }
+}
+
+void path_distancet::update_distances()
+{
+  // breadth-first search backwards from all the assertions not reached yet
+  std::list<std::size_t> queue;
+
+  for(std::size_t n = 0; n < nodes.size(); ++n)
+  {
+    if(nodes[n].assertion && !nodes[n].reached)
+    {
+      nodes[n].distance = 0;
+      queue.push_back(n);
+    }
+    else
+      nodes[n].distance = std::numeric_limits<std::size_t>::max();
+  }
+
+  while(!queue.empty())
+  {
+    const nodet &current = nodes[queue.front()];
+    queue.pop_front();
+
+    for(const auto predecessor : current.predecessors)
+    {
+      nodet &p = nodes[predecessor];
+      if(p.distance == std::numeric_limits<std::size_t>::max())
+      {
+        p.distance = current.distance + 1;
+        queue.push_back(predecessor);
+      }
+    }
+  }
+}
+
+std::size_t path_distancet::score(goto_programt::const_targett target)
+{
+  const std::size_t n = node(target);
+  return n == nodes.size() ? std::numeric_limits<std::size_t>::max()
+                           : nodes[n].distance;
+}
+
 // _____________________________________________________________________________
 // path_strategy_choosert
 
@@ -120,6 +405,37 @@ path_strategy_choosert::path_strategy_choosert()
          "                              the program tree breadth-first.\n",
          []() { // NOLINT(whitespace/braces)
            return util_make_unique<path_fifot>();
+         }}},
+       {"merge",
+        {" merge                        like lifo, but the paths through\n"
+         "                              small branches without loops or\n"
+         "                              function calls are merged where\n"
+         "                              they join rather than explored\n"
+         "                              one at a time.\n",
+         []() { // NOLINT(whitespace/braces)
+           return util_make_unique<path_merging_lifot>();
+         }}},
+       {"coverage",
+        {" coverage                     paths are popped starting at the\n"
+         "                              instruction that has been executed\n"
+         "                              least often, preferring code not\n"
+         "                              covered yet.\n",
+         []() { // NOLINT(whitespace/braces)
+           return util_make_unique<path_coveraget>();
+         }}},
+       {"distance",
+        {" distance                     paths are popped starting at the\n"
+         "                              instruction closest to an assertion\n"
+         "                              that has not been reached yet.\n",
+         []() { // NOLINT(whitespace/braces)
+           return util_make_unique<path_distancet>();
+         }}},
+       {"random-restart",
+        {" random-restart               like lifo, but every 16th path is\n"
+         "                              chosen at random among the others,\n"
+         "                              to escape deep subtrees.\n",
+         []() { // NOLINT(whitespace/braces)
+           return util_make_unique<path_random_restartt>();
          }}}})
 {
 }
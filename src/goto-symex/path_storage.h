@@ -13,7 +13,14 @@
 #include <util/ui_message.h>
 #include <util/invariant.h>
 
+#include <goto-programs/frozen_goto_program.h>
+
 #include <memory>
+#include <random>
+#include <set>
+#include <unordered_map>
+
+class goto_functionst;
 
 /// \brief Storage for symbolic execution paths to be resumed later
 ///
@@ -71,6 +78,35 @@ public:
   /// \brief How many paths does this storage contain?
   virtual std::size_t size() const = 0;
 
+  /// \brief Should the paths through a branch be merged rather than saved?
+  ///
+  /// Called when symbolic execution reaches a conditional goto instruction
+  /// with two successors, before any path is saved.
+  ///
+  /// \param branch the conditional goto instruction
+  /// \param [out] join the instruction where all paths through the branch
+  ///   have joined again, if they are to be merged
+  /// \return true if the paths are to be merged at `join` as they are without
+  ///   path exploration, false if they are to be pushed to the storage
+  virtual bool merge_paths(
+    goto_programt::const_targett branch,
+    goto_programt::const_targett &join)
+  {
+    return false;
+  }
+
+  /// \brief Called with the functions of the program before symbolic
+  /// execution starts, for strategies that analyse it
+  virtual void set_program(const goto_functionst &)
+  {
+  }
+
+  /// \brief Called when symbolic execution reaches an instruction on a
+  /// feasible path
+  virtual void executed(goto_programt::const_targett)
+  {
+  }
+
   /// \brief Is this storage empty?
   bool empty() const
   {
@@ -115,6 +151,190 @@ private:
   void private_pop() override;
 };
 
+/// \brief LIFO save queue that merges the paths through small regions
+///
+/// The paths through a conditional goto are merged where they join, as they
+/// are without path exploration, if the region between the two is small and
+/// contains no loops, function calls, threads or exceptions. The paths through
+/// other branches are saved and resumed in last-in, first-out order. Such
+/// branches are cheap to execute symbolically in one go, while exploring
+/// their paths separately multiplies the number of paths to resume.
+class path_merging_lifot : public path_lifot
+{
+public:
+  explicit path_merging_lifot(std::size_t max_region_size = 32)
+    : max_region_size(max_region_size)
+  {
+  }
+
+  bool merge_paths(
+    goto_programt::const_targett branch,
+    goto_programt::const_targett &join) override;
+
+protected:
+  /// The largest number of instructions between a branch and the join of its
+  /// paths for them to be merged
+  const std::size_t max_region_size;
+};
+
+/// \brief Random restarts: depth-first search, but every so often resume a
+/// randomly chosen path other than the one depth-first search would resume
+///
+/// The random choice is seeded identically on each run, so that results are
+/// reproducible.
+class path_random_restartt : public path_lifot
+{
+public:
+  explicit path_random_restartt(std::size_t restart_interval = 16)
+    : restart_interval(restart_interval), resumptions(0)
+  {
+  }
+
+protected:
+  /// Every this many resumptions, the path is chosen at random
+  const std::size_t restart_interval;
+  std::size_t resumptions;
+  std::minstd_rand generator;
+
+private:
+  patht &private_peek() override;
+};
+
+/// \brief Save queue that resumes the path with the lowest score first
+///
+/// The score of a path only depends on the instruction it resumes at. Scores
+/// are computed when paths are saved and kept in a queue ordered by them;
+/// derived classes call rescore() when what symbolic execution has seen since
+/// changes the score of an instruction. Among the paths with the lowest score,
+/// the one saved last is resumed.
+class path_priorityt : public path_storaget
+{
+public:
+  path_priorityt() : last_peeked(entries.end()), saved(0)
+  {
+  }
+
+  void push(const patht &, const patht &) override;
+  std::size_t size() const override;
+
+protected:
+  /// \return the score of paths resuming at \p target, the lower the earlier
+  ///   they are resumed
+  virtual std::size_t score(goto_programt::const_targett target) = 0;
+
+  /// Recompute the scores of the paths resuming at \p target
+  void rescore(goto_programt::const_targett target);
+
+  /// Recompute the scores of all paths
+  void rescore();
+
+private:
+  struct entryt
+  {
+    entryt(const patht &path, std::size_t order)
+      : path(path), target(path.state.saved_target), score(0), order(order)
+    {
+    }
+
+    patht path;
+    /// The instruction the path resumes at; symbolic execution changes the
+    /// state of the path while it is being resumed
+    goto_programt::const_targett target;
+    std::size_t score;
+    /// Paths saved later have higher numbers
+    std::size_t order;
+  };
+
+  typedef std::list<entryt>::iterator entry_itt;
+
+  struct entry_ordert
+  {
+    bool operator()(const entry_itt &a, const entry_itt &b) const
+    {
+      if(a->score != b->score)
+        return a->score < b->score;
+      return a->order > b->order;
+    }
+  };
+
+  std::list<entryt> entries;
+  /// The entries, the one to resume next first
+  std::set<entry_itt, entry_ordert> queue;
+  /// The entries resuming at each instruction
+  std::unordered_multimap<const goto_programt::instructiont *, entry_itt>
+    targets;
+  entry_itt last_peeked;
+  std::size_t saved;
+
+  void save(const patht &);
+
+  patht &private_peek() override;
+  void private_pop() override;
+};
+
+/// \brief Coverage-guided search: resume the path whose next instruction has
+/// been executed least often, preferring instructions not covered yet
+class path_coveraget : public path_priorityt
+{
+public:
+  void executed(goto_programt::const_targett) override;
+
+protected:
+  /// How often each instruction has been executed, on any path
+  std::unordered_map<const goto_programt::instructiont *, std::size_t>
+    execution_counts;
+
+  std::size_t score(goto_programt::const_targett) override;
+};
+
+/// \brief Resume the path closest to an assertion that symbolic execution
+/// has not reached yet
+///
+/// Distances are numbers of instructions in the control-flow graph of the
+/// program, which includes the edges into and out of called functions. They
+/// are computed once for all instructions, and again whenever an assertion is
+/// reached for the first time. The program is frozen, which numbers its
+/// instructions, so that the graph is stored in a vector.
+///
+/// The graph only contains the functions passed to set_program. When these
+/// are loaded lazily, as for Java, the functions loaded later are missing:
+/// their assertions are not targets, calls to them are treated as ordinary
+/// instructions, and paths resuming in them get the highest score.
+class path_distancet : public path_priorityt
+{
+public:
+  void set_program(const goto_functionst &) override;
+  void executed(goto_programt::const_targett) override;
+
+protected:
+  struct nodet
+  {
+    nodet() : assertion(false), reached(false), distance(0)
+    {
+    }
+
+    std::vector<std::size_t> predecessors;
+    bool assertion;
+    /// An assertion that symbolic execution has reached
+    bool reached;
+    /// Distance to the closest assertion not reached yet
+    std::size_t distance;
+  };
+
+  std::unique_ptr<frozen_goto_functionst> program;
+  /// The node of the first instruction of each function; the instructions
+  /// of a function have consecutive nodes
+  std::unordered_map<irep_idt, std::size_t> first_nodes;
+  std::vector<nodet> nodes;
+
+  /// \return the node of \p pc, or the number of nodes if \p pc is not part
+  ///   of the program
+  std::size_t node(goto_programt::const_targett pc) const;
+
+  void update_distances();
+  std::size_t score(goto_programt::const_targett) override;
+};
+
 /// \brief Factory and information for path_storaget
 class path_strategy_choosert
 {
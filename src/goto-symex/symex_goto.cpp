@@ -111,7 +111,7 @@ void goto_symext::symex_goto(statet &state)
     (simpl_state_guard.is_true() ||
      // or there is another block, but we're doing path exploration so
      // we're going to skip over it for now and return to it later.
-     options.get_bool_option("paths")))
+     (options.get_bool_option("paths") && !state.merging_paths)))
   {
     DATA_INVARIANT(
       instruction.targets.size() > 0,
@@ -178,7 +178,17 @@ void goto_symext::symex_goto(statet &state)
     log.debug() << "Resuming from next instruction '"
                 << state_pc->source_location << "'" << log.eom;
   }
-  else if(options.get_bool_option("paths"))
+  else if(
+    options.get_bool_option("paths") && !state.merging_paths &&
+    path_storage.merge_paths(state.source.pc, state.merge_join))
+  {
+    // Execute the paths up to where they join as without path exploration.
+    // The states queued at earlier branches are never merged, their paths
+    // having been saved instead.
+    frame.goto_state_map.clear();
+    state.merging_paths = true;
+  }
+  else if(options.get_bool_option("paths") && !state.merging_paths)
   {
     // We should save both the instruction after this goto, and the target of
     // the goto.
@@ -309,6 +319,10 @@ void goto_symext::merge_gotos(statet &state)
 {
   statet::framet &frame=state.top();
 
+  // all paths through a region merged during path exploration join here
+  if(state.merging_paths && state.source.pc==state.merge_join)
+    state.merging_paths=false;
+
   // first, see if this is a target at all
   statet::goto_state_mapt::iterator state_map_it=
     frame.goto_state_map.find(state.source.pc);
@@ -401,12 +415,11 @@ void goto_symext::phi_function(
 
     // shared variables are renamed on every access anyway, we don't need to
     // merge anything
-    const symbolt &symbol=ns.lookup(obj_identifier);
 
     // shared?
     if(
       dest_state.atomic_section_id == 0 && dest_state.threads.size() >= 2 &&
-      (symbol.is_shared() || (dest_state.dirty)(symbol.name)))
+      dest_state.is_shared_object(obj_identifier, ns))
       continue; // no phi nodes for shared stuff
 
     // don't merge (thread-)locals across different threads, which
@@ -136,6 +136,7 @@ void goto_symext::initialize_entry_point(
   state.top().end_of_function=limit;
   state.top().calling_location.pc=state.top().end_of_function;
   state.symex_target=&target;
+  state.thread_independent_objects=&thread_independent_objects;
 
   INVARIANT(
     !pc->function.empty(), "all symexed instructions should have a function");
@@ -196,6 +197,9 @@ void goto_symext::symex_with_state(
   // goto-program.
   ns = namespacet(outer_symbol_table, state.symbol_table);
 
+  // a saved state may point to those of a previous goto_symext
+  state.thread_independent_objects=&thread_independent_objects;
+
   PRECONDITION(state.top().end_of_function->is_end_function());
 
   symex_threaded_step(state, get_goto_function);
@@ -315,9 +319,12 @@ void goto_symext::symex_step(
 
   const goto_programt::instructiont &instruction=*state.source.pc;
 
-  if(!options.get_bool_option("paths"))
+  if(!options.get_bool_option("paths") || state.merging_paths)
     merge_gotos(state);
 
+  if(options.get_bool_option("paths") && !state.guard.is_false())
+    path_storage.executed(state.source.pc);
+
   // depth exceeded?
   {
     unsigned max_depth=options.get_unsigned_int_option("depth");
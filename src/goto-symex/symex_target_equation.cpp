@@ -394,6 +394,97 @@ void symex_target_equationt::convert(
   }
 }
 
+/// Converts the steps from \p first to \p last, so that the steps of an
+/// equation can be passed to an incremental solver as they are generated.
+/// Assignments and constraints are only enforced if \p activation holds,
+/// which allows retracting them later on. Assertions are converted to
+/// literals that hold if their condition does, or if \p assumption or one of
+/// the assumptions since \p first does not; \p assumption is updated to
+/// include the latter.
+void symex_target_equationt::convert_incrementally(
+  prop_convt &prop_conv,
+  SSA_stepst::iterator first,
+  SSA_stepst::iterator last,
+  literalt activation,
+  literalt &assumption)
+{
+  for(SSA_stepst::iterator it=first; it!=last; it++)
+  {
+    SSA_stept &step=*it;
+
+    if(step.ignore)
+    {
+      step.guard_literal=const_literal(false);
+      step.cond_literal=const_literal(true);
+      continue;
+    }
+
+    try
+    {
+      step.guard_literal=prop_conv.convert(step.guard);
+
+      if(step.is_assignment() || step.is_constraint())
+      {
+        if(activation.is_true())
+          prop_conv.set_to_true(step.cond_expr);
+        else
+          prop_conv.set_to_true(
+            implies_exprt(literal_exprt(activation), step.cond_expr));
+      }
+      else if(step.is_decl())
+        prop_conv.convert(step.cond_expr);
+      else if(step.is_goto())
+        step.cond_literal=prop_conv.convert(step.cond_expr);
+      else if(step.is_assume())
+      {
+        step.cond_literal=prop_conv.convert(step.cond_expr);
+        assumption=prop_conv.convert(
+          and_exprt(
+            literal_exprt(assumption), literal_exprt(step.cond_literal)));
+      }
+      else if(step.is_assert())
+      {
+        step.cond_literal=prop_conv.convert(
+          implies_exprt(literal_exprt(assumption), step.cond_expr));
+      }
+
+      for(const auto &arg : step.io_args)
+      {
+        if(arg.is_constant() ||
+           arg.id()==ID_string_constant)
+          step.converted_io_args.push_back(arg);
+        else
+        {
+          symbol_exprt symbol(
+            "symex::io::incremental::"+std::to_string(incremental_io_count++),
+            arg.type());
+
+          exprt eq=equal_exprt(arg, symbol);
+          if(!activation.is_true())
+            eq=implies_exprt(literal_exprt(activation), eq);
+          merge_irep(eq);
+
+          prop_conv.set_to_true(eq);
+          step.converted_io_args.push_back(symbol);
+        }
+      }
+    }
+    catch(const bitvector_conversion_exceptiont &conversion_exception)
+    {
+      // unwrap the exception and throw like convert() does
+      try
+      {
+        util_throw_with_nested(
+          equation_conversion_exceptiont("Error converting step", step));
+      }
+      catch(const equation_conversion_exceptiont &e)
+      {
+        throw unwrap_exception(e);
+      }
+    }
+  }
+}
+
 /// converts assignments
 /// \par parameters: decision procedure
 /// \return -
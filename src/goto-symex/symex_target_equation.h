@@ -289,6 +289,13 @@ public:
   typedef std::list<SSA_stept> SSA_stepst;
   SSA_stepst SSA_steps;
 
+  void convert_incrementally(
+    prop_convt &prop_conv,
+    SSA_stepst::iterator first,
+    SSA_stepst::iterator last,
+    literalt activation,
+    literalt &assumption);
+
   SSA_stepst::iterator get_SSA_step(std::size_t s)
   {
     SSA_stepst::iterator it=SSA_steps.begin();
@@ -322,6 +329,9 @@ protected:
   // for enforcing sharing in the expressions stored
   merge_irept merge_irep;
   void merge_ireps(SSA_stept &SSA_step);
+
+  // the number of symbols introduced by convert_incrementally for I/O
+  std::size_t incremental_io_count=0;
 };
 
 inline bool operator<(
@@ -1318,6 +1318,9 @@ void linkingt::copy_symbols()
       duplicate_non_type_symbol(old_symbol, new_symbol);
   }
 
+  if(defer_object_type_updates || object_type_updates.expr_map.empty())
+    return;
+
   // Apply type updates to initializers
   for(const auto &named_symbol : main_symbol_table.symbols)
   {
@@ -26,6 +26,7 @@ public:
     symbol_tablet &_src_symbol_table,
     message_handlert &_message_handler):
     typecheckt(_message_handler),
+    defer_object_type_updates(false),
     main_symbol_table(_main_symbol_table),
     src_symbol_table(_src_symbol_table),
     ns(_main_symbol_table)
@@ -37,6 +38,11 @@ public:
   rename_symbolt rename_symbol;
   replace_symbolt object_type_updates;
 
+  /// If set, object_type_updates are not applied to the initializers in the
+  /// main symbol table, which is then left to the caller, e.g., once after
+  /// linking several symbol tables
+  bool defer_object_type_updates;
+
 protected:
   bool needs_renaming_type(
     const symbolt &old_symbol,
@@ -0,0 +1,569 @@
+/*******************************************************************\
+
+Module: Demand-Driven Points-To Analysis
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Demand-Driven Points-To Analysis
+
+#include "demand_driven_value_sets.h"
+
+#include <algorithm>
+
+#include <util/c_types.h>
+#include <util/arith_tools.h>
+
+demand_driven_value_setst::demand_driven_value_setst(const namespacet &_ns):
+  ns(_ns),
+  unknown_object(object_numbering.number(exprt(ID_unknown))),
+  null_object(object_numbering.number(exprt(ID_null_object))),
+  integer_address_object(
+    object_numbering.number(
+      exprt(ID_integer_address, unsigned_char_type()))),
+  stores_indexed(false)
+{
+}
+
+/// All references to the same identifier denote the same object, whatever
+/// type the symbol expression at hand has
+demand_driven_value_setst::objectt demand_driven_value_setst::symbol_object(
+  const symbol_exprt &symbol_expr)
+{
+  const irep_idt &identifier=symbol_expr.get_identifier();
+
+  std::unordered_map<irep_idt, objectt>::const_iterator entry=
+    symbol_objects.find(identifier);
+  if(entry!=symbol_objects.end())
+    return entry->second;
+
+  const symbolt *symbol;
+  const objectt o=
+    object_numbering.number(
+      ns.lookup(identifier, symbol) ? symbol_expr : symbol->symbol_expr());
+
+  symbol_objects.insert(std::make_pair(identifier, o));
+
+  return o;
+}
+
+demand_driven_value_setst::objectt demand_driven_value_setst::object(
+  const exprt &expr)
+{
+  if(expr.id()==ID_symbol)
+    return symbol_object(to_symbol_expr(expr));
+  else
+    return object_numbering.number(expr);
+}
+
+/// Replace each allocation in \p expr by the address of a dynamic object
+/// identified by \p location_number, as value_sett does
+static void replace_allocations(exprt &expr, unsigned location_number)
+{
+  if(expr.id()==ID_side_effect)
+  {
+    const irep_idt &statement=expr.get(ID_statement);
+
+    if(statement==ID_allocate ||
+       statement==ID_cpp_new ||
+       statement==ID_cpp_new_array)
+    {
+      const typet &dynamic_type=
+        statement==ID_allocate ?
+          static_cast<const typet &>(expr.find(ID_C_cxx_alloc_type)) :
+          expr.type().subtype();
+
+      dynamic_object_exprt dynamic_object(dynamic_type);
+      dynamic_object.set_instance(location_number);
+      dynamic_object.valid()=true_exprt();
+
+      expr=address_of_exprt(dynamic_object);
+      return;
+    }
+  }
+
+  Forall_operands(it, expr)
+    replace_allocations(*it, location_number);
+}
+
+/// Record the objects whose address is taken in \p expr
+void demand_driven_value_setst::add_address_taken(const exprt &expr)
+{
+  if(expr.id()==ID_address_of)
+    add_address_taken_object(to_address_of_expr(expr).object());
+
+  forall_operands(it, expr)
+    add_address_taken(*it);
+}
+
+/// Record the objects \p expr may denote, where `&expr` occurs in the
+/// program
+void demand_driven_value_setst::add_address_taken_object(const exprt &expr)
+{
+  if(expr.id()==ID_symbol)
+    address_taken.insert(symbol_object(to_symbol_expr(expr)));
+  else if(expr.id()==ID_member ||
+          expr.id()==ID_index ||
+          expr.id()==ID_typecast ||
+          expr.id()==ID_byte_extract_little_endian ||
+          expr.id()==ID_byte_extract_big_endian)
+  {
+    add_address_taken_object(expr.op0());
+  }
+  else if(expr.id()==ID_if)
+  {
+    add_address_taken_object(to_if_expr(expr).true_case());
+    add_address_taken_object(to_if_expr(expr).false_case());
+  }
+  else if(expr.id()==ID_dynamic_object ||
+          expr.id()==ID_string_constant ||
+          expr.id()==ID_label)
+  {
+    address_taken.insert(object(expr));
+  }
+
+  // the pointees of dereferenced pointers have their addresses taken
+  // elsewhere already
+}
+
+void demand_driven_value_setst::add_assignment(
+  const exprt &lhs,
+  const exprt &rhs)
+{
+  if(lhs.id()==ID_symbol)
+    copies[symbol_object(to_symbol_expr(lhs))].push_back(rhs);
+  else if(lhs.id()==ID_dynamic_object)
+    copies[object(lhs)].push_back(rhs);
+  else if(lhs.id()==ID_member ||
+          lhs.id()==ID_index ||
+          lhs.id()==ID_typecast ||
+          lhs.id()==ID_byte_extract_little_endian ||
+          lhs.id()==ID_byte_extract_big_endian)
+  {
+    // field insensitive: assigning to a part assigns to the whole object
+    add_assignment(lhs.op0(), rhs);
+  }
+  else if(lhs.id()==ID_dereference)
+  {
+    storet store;
+    store.pointer=to_dereference_expr(lhs).pointer();
+    store.value=rhs;
+    stores.push_back(store);
+  }
+  else if(lhs.id()==ID_if)
+  {
+    add_assignment(to_if_expr(lhs).true_case(), rhs);
+    add_assignment(to_if_expr(lhs).false_case(), rhs);
+  }
+}
+
+void demand_driven_value_setst::operator()(
+  const goto_functionst &goto_functions)
+{
+  // parameters and returned values first, as calls refer to them
+  forall_goto_functions(f_it, goto_functions)
+  {
+    if(!f_it->second.body_available())
+      continue;
+
+    const objectt function=
+      symbol_object(symbol_exprt(f_it->first, f_it->second.type));
+    defined_functions.insert(function);
+
+    const code_typet::parameterst &function_parameters=
+      f_it->second.type.parameters();
+    for(std::size_t i=0; i<function_parameters.size(); ++i)
+    {
+      const irep_idt &identifier=function_parameters[i].get_identifier();
+      if(!identifier.empty())
+      {
+        const objectt parameter=
+          symbol_object(
+            symbol_exprt(identifier, function_parameters[i].type()));
+        parameters[parameter]=std::make_pair(function, i);
+      }
+    }
+
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      if(!i_it->is_return())
+        continue;
+
+      const code_returnt &code_return=to_code_return(i_it->code);
+      if(code_return.has_return_value())
+      {
+        exprt value=code_return.return_value();
+        replace_allocations(value, i_it->location_number);
+        add_address_taken(value);
+        returns[function].push_back(value);
+      }
+    }
+  }
+
+  forall_goto_functions(f_it, goto_functions)
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      if(i_it->is_assign())
+      {
+        const code_assignt &code_assign=to_code_assign(i_it->code);
+        exprt rhs=code_assign.rhs();
+        replace_allocations(rhs, i_it->location_number);
+        add_address_taken(code_assign.lhs());
+        add_address_taken(rhs);
+        add_assignment(code_assign.lhs(), rhs);
+      }
+      else if(i_it->is_function_call())
+      {
+        const code_function_callt &call=to_code_function_call(i_it->code);
+
+        exprt::operandst arguments=call.arguments();
+        for(auto &argument : arguments)
+        {
+          replace_allocations(argument, i_it->location_number);
+          add_address_taken(argument);
+        }
+        add_address_taken(call.lhs());
+
+        if(call.function().id()!=ID_symbol)
+        {
+          indirect_callt indirect_call;
+          indirect_call.function=call.function();
+          indirect_call.arguments=arguments;
+          indirect_calls.push_back(indirect_call);
+
+          if(call.lhs().is_not_nil())
+          {
+            exprt result("indirect_call_result", call.lhs().type());
+            result.set(ID_value, indirect_calls.size()-1);
+            add_assignment(call.lhs(), result);
+          }
+
+          continue;
+        }
+
+        const irep_idt &identifier=
+          to_symbol_expr(call.function()).get_identifier();
+        goto_functionst::function_mapt::const_iterator callee=
+          goto_functions.function_map.find(identifier);
+
+        if(callee==goto_functions.function_map.end() ||
+           !callee->second.body_available())
+        {
+          // no body, the result is arbitrary
+          if(call.lhs().is_not_nil())
+            add_assignment(
+              call.lhs(),
+              side_effect_expr_nondett(call.lhs().type()));
+
+          continue;
+        }
+
+        const code_typet::parameterst &callee_parameters=
+          callee->second.type.parameters();
+        const std::size_t n=
+          std::min(callee_parameters.size(), arguments.size());
+        for(std::size_t i=0; i<n; ++i)
+        {
+          const irep_idt &parameter=callee_parameters[i].get_identifier();
+          if(!parameter.empty())
+            add_assignment(
+              symbol_exprt(parameter, callee_parameters[i].type()),
+              arguments[i]);
+        }
+
+        if(call.lhs().is_not_nil())
+        {
+          const objectt function=
+            symbol_object(to_symbol_expr(call.function()));
+          for(const auto &value : returns[function])
+            add_assignment(call.lhs(), value);
+        }
+      }
+    }
+}
+
+/// The points-to set of \p o as computed so far; marks \p o as demanded if
+/// it is not solved yet
+const demand_driven_value_setst::objectst &demand_driven_value_setst::current(
+  objectt o)
+{
+  if(solved.find(o)==solved.end() &&
+     demanded_set.insert(o).second)
+    demanded.push_back(o);
+
+  return points_to_map[o];
+}
+
+/// The objects \p expr may point to
+demand_driven_value_setst::objectst demand_driven_value_setst::evaluate(
+  const exprt &expr)
+{
+  objectst result;
+
+  if(expr.id()==ID_symbol)
+    result=current(symbol_object(to_symbol_expr(expr)));
+  else if(expr.id()==ID_member ||
+          expr.id()==ID_index ||
+          expr.id()==ID_byte_extract_little_endian ||
+          expr.id()==ID_byte_extract_big_endian)
+  {
+    result=evaluate(expr.op0());
+  }
+  else if(expr.id()==ID_dereference)
+  {
+    const objectst pointees=evaluate(to_dereference_expr(expr).pointer());
+
+    for(const auto &o : pointees)
+    {
+      if(o==unknown_object)
+        result.insert(unknown_object);
+      else if(o!=null_object && o!=integer_address_object)
+        result.make_union(current(o));
+    }
+  }
+  else if(expr.id()==ID_address_of)
+    result=evaluate_reference(to_address_of_expr(expr).object());
+  else if(expr.id()==ID_if)
+  {
+    result=evaluate(to_if_expr(expr).true_case());
+    result.make_union(evaluate(to_if_expr(expr).false_case()));
+  }
+  else if(expr.id()==ID_typecast)
+  {
+    const exprt &op=to_typecast_expr(expr).op();
+
+    if(op.type().id()==ID_pointer)
+      result=evaluate(op);
+    else if(expr.type().id()==ID_pointer && op.is_zero())
+      result.insert(null_object);
+    else
+    {
+      result=evaluate(op);
+
+      // an integer got turned into a pointer
+      if(result.empty() && expr.type().id()==ID_pointer)
+        result.insert(integer_address_object);
+    }
+  }
+  else if(expr.is_constant())
+  {
+    if(expr.type().id()==ID_pointer)
+    {
+      if(expr.get(ID_value)==ID_NULL || expr.is_zero())
+        result.insert(null_object);
+      else
+        result.insert(integer_address_object);
+    }
+  }
+  else if(expr.id()=="indirect_call_result")
+  {
+    const indirect_callt &call=indirect_calls[expr.get_size_t(ID_value)];
+
+    for(const auto &callee : evaluate_reference(call.function))
+    {
+      std::unordered_map<objectt, std::vector<exprt>>::const_iterator entry=
+        returns.find(callee);
+
+      if(entry!=returns.end())
+      {
+        for(const auto &value : entry->second)
+          result.make_union(evaluate(value));
+      }
+      else if(defined_functions.find(callee)==defined_functions.end())
+        result.insert(unknown_object);
+    }
+  }
+  else if(expr.id()==ID_unknown ||
+          expr.id()==ID_invalid ||
+          (!expr.has_operands() && expr.type().id()==ID_pointer))
+  {
+    // includes non-deterministic pointers
+    result.insert(unknown_object);
+  }
+  else
+  {
+    // arithmetic, struct and array constructors, ...
+    forall_operands(it, expr)
+      result.make_union(evaluate(*it));
+  }
+
+  return result;
+}
+
+/// The objects \p expr may denote, i.e., the objects `&expr` may point to
+demand_driven_value_setst::objectst
+demand_driven_value_setst::evaluate_reference(const exprt &expr)
+{
+  objectst result;
+
+  if(expr.id()==ID_symbol)
+    result.insert(symbol_object(to_symbol_expr(expr)));
+  else if(expr.id()==ID_member ||
+          expr.id()==ID_index ||
+          expr.id()==ID_typecast ||
+          expr.id()==ID_byte_extract_little_endian ||
+          expr.id()==ID_byte_extract_big_endian)
+  {
+    result=evaluate_reference(expr.op0());
+  }
+  else if(expr.id()==ID_dereference)
+    result=evaluate(to_dereference_expr(expr).pointer());
+  else if(expr.id()==ID_if)
+  {
+    result=evaluate_reference(to_if_expr(expr).true_case());
+    result.make_union(evaluate_reference(to_if_expr(expr).false_case()));
+  }
+  else if(expr.id()==ID_dynamic_object ||
+          expr.id()==ID_string_constant ||
+          expr.id()==ID_label)
+  {
+    result.insert(object(expr));
+  }
+  else
+    result.insert(unknown_object);
+
+  return result;
+}
+
+/// Evaluate everything that may flow into \p o
+demand_driven_value_setst::objectst
+demand_driven_value_setst::evaluate_sources(objectt o)
+{
+  objectst result;
+
+  std::unordered_map<objectt, std::vector<exprt>>::const_iterator c_entry=
+    copies.find(o);
+  if(c_entry!=copies.end())
+  {
+    for(const auto &value : c_entry->second)
+      result.make_union(evaluate(value));
+  }
+
+  // stores can only write to objects whose address is taken
+  if(address_taken.find(o)!=address_taken.end())
+  {
+    if(!stores_indexed)
+      index_stores();
+
+    for(const objectt target : {o, unknown_object})
+    {
+      const auto s_entry=stores_by_target.find(target);
+      if(s_entry!=stores_by_target.end())
+      {
+        for(const std::size_t i : s_entry->second)
+          result.make_union(evaluate(stores[i].value));
+      }
+    }
+  }
+
+  std::unordered_map<objectt, std::pair<objectt, std::size_t>>::const_iterator
+    p_entry=parameters.find(o);
+  if(p_entry!=parameters.end())
+  {
+    const objectt function=p_entry->second.first;
+    const std::size_t index=p_entry->second.second;
+
+    for(const auto &call : indirect_calls)
+    {
+      if(index>=call.arguments.size())
+        continue;
+
+      const objectst callees=evaluate_reference(call.function);
+      if(callees.contains(function) || callees.contains(unknown_object))
+        result.make_union(evaluate(call.arguments[index]));
+    }
+  }
+
+  return result;
+}
+
+/// Look up the objects each store may write to with the current points-to
+/// sets
+void demand_driven_value_setst::index_stores()
+{
+  stores_by_target.clear();
+
+  for(std::size_t i=0; i<stores.size(); ++i)
+  {
+    for(const auto &target : evaluate(stores[i].pointer))
+      stores_by_target[target].push_back(i);
+  }
+
+  stores_indexed=true;
+}
+
+/// Compute the points-to sets of all demanded objects (and of those they
+/// depend on) by fixed-point iteration, and memoise them
+/// \return false iff there were no demanded objects
+bool demand_driven_value_setst::solve()
+{
+  if(demanded.empty())
+    return false;
+
+  bool changed=true;
+
+  while(changed)
+  {
+    changed=false;
+
+    // the points-to sets of the pointers stored through may have grown
+    stores_indexed=false;
+
+    // objects may be demanded while iterating
+    for(std::size_t i=0; i<demanded.size(); ++i)
+    {
+      const objectt o=demanded[i];
+      const objectst sources=evaluate_sources(o);
+
+      if(points_to_map[o].make_union(sources))
+        changed=true;
+    }
+  }
+
+  solved.insert(demanded.begin(), demanded.end());
+  demanded.clear();
+  demanded_set.clear();
+
+  return true;
+}
+
+void demand_driven_value_setst::get_values(
+  goto_programt::const_targett l,
+  const exprt &expr,
+  valuest &dest)
+{
+  objectst result=evaluate(expr);
+
+  // evaluating again after solving may demand further objects
+  while(solve())
+    result=evaluate(expr);
+
+  for(const auto &o : result)
+  {
+    if(o==unknown_object)
+    {
+      dest.push_back(exprt(ID_unknown, expr.type()));
+      continue;
+    }
+
+    object_descriptor_exprt od;
+
+    if(o==null_object)
+    {
+      const typet &type=ns.follow(expr.type());
+      od.object()=
+        exprt(
+          ID_null_object,
+          type.id()==ID_pointer ? type.subtype() : empty_typet());
+      od.offset()=from_integer(0, index_type());
+    }
+    else
+      od.object()=object_numbering[o];
+
+    od.type()=od.object().type();
+
+    dest.push_back(od);
+  }
+}
@@ -0,0 +1,140 @@
+/*******************************************************************\
+
+Module: Demand-Driven Points-To Analysis
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Demand-Driven Points-To Analysis
+
+#ifndef CPROVER_POINTER_ANALYSIS_DEMAND_DRIVEN_VALUE_SETS_H
+#define CPROVER_POINTER_ANALYSIS_DEMAND_DRIVEN_VALUE_SETS_H
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <util/sparse_bitset.h>
+#include <util/std_code.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include "object_numbering.h"
+#include "value_sets.h"
+
+/// A flow- and field-insensitive, inclusion-based points-to analysis that
+/// only solves the part of the constraint system a query depends on.
+///
+/// operator() merely indexes the assignments (including parameter passing,
+/// returns and stores through pointers) of all goto functions. A query
+/// `get_values(l, p)` then computes the points-to sets of just those objects
+/// that the value of `p` transitively depends on, by a fixed-point
+/// iteration over these objects. Stores through pointers are only
+/// considered for objects whose address is taken somewhere in the program,
+/// and are then looked up by the objects they write to. Solved objects are
+/// memoised, so later
+/// queries only pay for objects not seen before. This makes the analysis
+/// cheap when only few dereference sites are of interest, at the price of
+/// ignoring the location `l` and the fields of structs and arrays.
+class demand_driven_value_setst:public value_setst
+{
+public:
+  explicit demand_driven_value_setst(const namespacet &_ns);
+
+  /// Index the assignments of \p goto_functions; must be called before any
+  /// query
+  void operator()(const goto_functionst &goto_functions);
+
+  void get_values(
+    goto_programt::const_targett l,
+    const exprt &expr,
+    valuest &dest) override;
+
+  /// Number of objects whose points-to sets have been computed so far
+  std::size_t get_number_of_solved_objects() const
+  {
+    return solved.size();
+  }
+
+protected:
+  const namespacet &ns;
+
+  typedef std::size_t objectt;
+  typedef sparse_bitsett objectst;
+
+  object_numberingt object_numbering;
+  std::unordered_map<irep_idt, objectt> symbol_objects;
+
+  const objectt unknown_object;
+  const objectt null_object;
+  const objectt integer_address_object;
+
+  objectt symbol_object(const symbol_exprt &symbol_expr);
+  objectt object(const exprt &expr);
+
+  // the constraints
+
+  /// values assigned to (a part of) an object
+  std::unordered_map<objectt, std::vector<exprt>> copies;
+
+  struct storet
+  {
+    exprt pointer;
+    exprt value;
+  };
+
+  /// assignments through pointers
+  std::vector<storet> stores;
+
+  /// objects whose address is taken, the only ones stores can write to
+  std::unordered_set<objectt> address_taken;
+
+  void add_address_taken(const exprt &expr);
+  void add_address_taken_object(const exprt &expr);
+
+  struct indirect_callt
+  {
+    exprt function;
+    exprt::operandst arguments;
+  };
+
+  /// calls via function pointers; their results are represented by
+  /// expressions with id \c indirect_call_result referring to this vector
+  std::vector<indirect_callt> indirect_calls;
+
+  /// functions that have a body
+  std::unordered_set<objectt> defined_functions;
+
+  /// for each parameter object: the function and the parameter's position
+  std::unordered_map<objectt, std::pair<objectt, std::size_t>> parameters;
+
+  /// for each function object: the values returned by it
+  std::unordered_map<objectt, std::vector<exprt>> returns;
+
+  void add_assignment(const exprt &lhs, const exprt &rhs);
+
+  // the solver
+
+  std::unordered_map<objectt, objectst> points_to_map;
+  std::unordered_set<objectt> solved;
+  std::vector<objectt> demanded;
+  std::unordered_set<objectt> demanded_set;
+
+  /// the stores by the objects they may write to, computed at most once
+  /// during each iteration of solve(); stores through unknown pointers are
+  /// found under `unknown_object`
+  std::unordered_map<objectt, std::vector<std::size_t>> stores_by_target;
+  bool stores_indexed;
+
+  void index_stores();
+
+  const objectst &current(objectt o);
+  objectst evaluate(const exprt &expr);
+  objectst evaluate_reference(const exprt &expr);
+  objectst evaluate_sources(objectt o);
+  bool solve();
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_DEMAND_DRIVEN_VALUE_SETS_H
@@ -0,0 +1,586 @@
+/*******************************************************************\
+
+Module: Unification-Based Points-To Analysis
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unification-Based Points-To Analysis
+
+#include "unification_value_sets.h"
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+
+const unification_value_setst::nodet unification_value_setst::no_node;
+
+unification_value_setst::unification_value_setst(const namespacet &_ns):
+  ns(_ns),
+  location_number(0)
+{
+}
+
+unification_value_setst::nodet unification_value_setst::new_node()
+{
+  const nodet n=attributes.size();
+  attributes.push_back(attributest());
+  classes.check_index(n);
+  return n;
+}
+
+/// Merge the classes of \p a and \p b, and, recursively, the classes they
+/// point to and the classes in their signatures
+void unification_value_setst::join(nodet a, nodet b)
+{
+  std::vector<std::pair<nodet, nodet>> work;
+  work.push_back(std::make_pair(a, b));
+
+  while(!work.empty())
+  {
+    a=find(work.back().first);
+    b=find(work.back().second);
+    work.pop_back();
+
+    if(a==b)
+      continue;
+
+    classes.make_union(a, b);
+
+    const nodet root=find(a);
+    attributest &r=attributes[root];
+    attributest &o=attributes[root==a ? b : a];
+
+    if(r.pointee==no_node)
+      r.pointee=o.pointee;
+    else if(o.pointee!=no_node)
+      work.push_back(std::make_pair(r.pointee, o.pointee));
+
+    if(r.signature.size()<o.signature.size())
+      r.signature.swap(o.signature);
+    for(std::size_t i=0; i<o.signature.size(); ++i)
+      work.push_back(std::make_pair(r.signature[i], o.signature[i]));
+
+    r.may_be_null=r.may_be_null || o.may_be_null;
+    r.may_be_unknown=r.may_be_unknown || o.may_be_unknown;
+
+    // append the smaller list to the larger one
+    if(r.objects.size()<o.objects.size())
+      r.objects.swap(o.objects);
+    r.objects.insert(r.objects.end(), o.objects.begin(), o.objects.end());
+
+    o=attributest();
+  }
+}
+
+/// The class the objects in the class of \p n point to
+unification_value_setst::nodet unification_value_setst::pointee(nodet n)
+{
+  const nodet root=find(n);
+
+  if(attributes[root].pointee==no_node)
+  {
+    const nodet p=new_node();
+    attributes[root].pointee=p;
+  }
+
+  return attributes[root].pointee;
+}
+
+/// The signature of the functions in the class of \p n, extended such that it
+/// covers at least \p arity parameters
+std::vector<unification_value_setst::nodet>
+unification_value_setst::signature(nodet n, std::size_t arity)
+{
+  const nodet root=find(n);
+
+  while(attributes[root].signature.size()<arity+1)
+  {
+    const nodet s=new_node();
+    attributes[root].signature.push_back(s);
+  }
+
+  return attributes[root].signature;
+}
+
+unification_value_setst::nodet unification_value_setst::object_node(
+  const exprt &object)
+{
+  const object_numberingt::number_type number=
+    object_numbering.number(object);
+
+  std::unordered_map<object_numberingt::number_type, nodet>::const_iterator
+    entry=object_nodes.find(number);
+  if(entry!=object_nodes.end())
+    return entry->second;
+
+  const nodet n=new_node();
+  attributes[n].objects.push_back(number);
+  object_nodes.insert(std::make_pair(number, n));
+
+  return n;
+}
+
+/// All references to the same identifier denote the same object, whatever
+/// type the symbol expression at hand has
+unification_value_setst::nodet unification_value_setst::symbol_node(
+  const symbol_exprt &symbol_expr)
+{
+  const irep_idt &identifier=symbol_expr.get_identifier();
+
+  std::unordered_map<irep_idt, nodet>::const_iterator entry=
+    symbol_nodes.find(identifier);
+  if(entry!=symbol_nodes.end())
+    return entry->second;
+
+  const symbolt *symbol;
+  const bool not_found=ns.lookup(identifier, symbol);
+  const nodet n=object_node(not_found ? symbol_expr : symbol->symbol_expr());
+  symbol_nodes.insert(std::make_pair(identifier, n));
+
+  // what functions without body return is arbitrary
+  if(symbol_expr.type().id()==ID_code &&
+     defined_functions.find(identifier)==defined_functions.end())
+    attributes[find(signature(n, 0).front())].may_be_unknown=true;
+
+  return n;
+}
+
+/// Returns true if \p expr denotes an object, as opposed to a value
+static bool is_object(const exprt &expr)
+{
+  if(expr.id()==ID_symbol ||
+     expr.id()==ID_dynamic_object ||
+     expr.id()==ID_string_constant ||
+     expr.id()==ID_dereference)
+    return true;
+  else if(expr.id()==ID_member ||
+          expr.id()==ID_index ||
+          expr.id()==ID_typecast ||
+          expr.id()==ID_byte_extract_little_endian ||
+          expr.id()==ID_byte_extract_big_endian)
+    return is_object(expr.op0());
+  else
+    return false;
+}
+
+/// Returns false if the value of \p expr cannot be an address derived from
+/// those its operands point to
+static bool carries_pointers(const exprt &expr)
+{
+  if(expr.type().id()==ID_bool ||
+     expr.id()==ID_mult ||
+     expr.id()==ID_div ||
+     expr.id()==ID_mod)
+    return false;
+
+  // the difference of two pointers is an offset
+  if(expr.id()==ID_minus &&
+     expr.operands().size()==2 &&
+     expr.op0().type().id()==ID_pointer &&
+     expr.op1().type().id()==ID_pointer)
+    return false;
+
+  return true;
+}
+
+/// The class of the objects \p expr may denote, i.e., the class `&expr`
+/// points to
+unification_value_setst::nodet unification_value_setst::location(
+  const exprt &expr)
+{
+  if(expr.id()==ID_symbol)
+    return symbol_node(to_symbol_expr(expr));
+  else if(expr.id()==ID_dynamic_object ||
+          expr.id()==ID_string_constant ||
+          expr.id()==ID_label)
+    return object_node(expr);
+  else if(expr.id()==ID_member ||
+          expr.id()==ID_index ||
+          expr.id()==ID_typecast ||
+          expr.id()==ID_byte_extract_little_endian ||
+          expr.id()==ID_byte_extract_big_endian)
+  {
+    // field insensitive
+    return location(expr.op0());
+  }
+  else if(expr.id()==ID_dereference)
+    return value(to_dereference_expr(expr).pointer());
+  else if(expr.id()==ID_if)
+  {
+    const nodet n=location(to_if_expr(expr).true_case());
+    join(n, location(to_if_expr(expr).false_case()));
+    return n;
+  }
+
+  const nodet n=new_node();
+  attributes[n].may_be_unknown=true;
+  return n;
+}
+
+/// The class of the objects \p expr may point to
+unification_value_setst::nodet unification_value_setst::value(
+  const exprt &expr)
+{
+  if(expr.id()==ID_address_of)
+    return location(to_address_of_expr(expr).object());
+  else if(expr.id()==ID_typecast)
+  {
+    const exprt &op=to_typecast_expr(expr).op();
+
+    if(expr.type().id()==ID_pointer &&
+       op.type().id()!=ID_pointer &&
+       op.is_zero())
+    {
+      const nodet n=new_node();
+      attributes[n].may_be_null=true;
+      return n;
+    }
+
+    return value(op);
+  }
+  else if(is_object(expr))
+    return pointee(location(expr));
+  else if(expr.id()==ID_if)
+  {
+    const nodet n=value(to_if_expr(expr).true_case());
+    join(n, value(to_if_expr(expr).false_case()));
+    return n;
+  }
+  else if(expr.id()==ID_side_effect &&
+          (expr.get(ID_statement)==ID_allocate ||
+           expr.get(ID_statement)==ID_cpp_new ||
+           expr.get(ID_statement)==ID_cpp_new_array))
+  {
+    // one dynamic object per allocation site, as value_sett does
+    const typet &dynamic_type=
+      expr.get(ID_statement)==ID_allocate ?
+        static_cast<const typet &>(expr.find(ID_C_cxx_alloc_type)) :
+        expr.type().subtype();
+
+    dynamic_object_exprt dynamic_object(dynamic_type);
+    dynamic_object.set_instance(location_number);
+    dynamic_object.valid()=true_exprt();
+
+    return object_node(dynamic_object);
+  }
+
+  const nodet n=new_node();
+
+  if(expr.is_constant() && expr.type().id()==ID_pointer)
+  {
+    if(expr.get(ID_value)==ID_NULL || expr.is_zero())
+      attributes[n].may_be_null=true;
+    else
+      attributes[n].may_be_unknown=true;
+  }
+  else if(expr.id()==ID_unknown ||
+          expr.id()==ID_invalid ||
+          (!expr.has_operands() && expr.type().id()==ID_pointer))
+  {
+    // includes non-deterministic pointers
+    attributes[n].may_be_unknown=true;
+  }
+  else if(carries_pointers(expr))
+  {
+    // pointer arithmetic, struct and array constructors, ...
+    forall_operands(it, expr)
+      join(n, value(*it));
+  }
+
+  return n;
+}
+
+void unification_value_setst::assign(const exprt &lhs, const exprt &rhs)
+{
+  if(lhs.id()==ID_if)
+  {
+    assign(to_if_expr(lhs).true_case(), rhs);
+    assign(to_if_expr(lhs).false_case(), rhs);
+  }
+  else if(is_object(lhs))
+    join(pointee(location(lhs)), value(rhs));
+}
+
+void unification_value_setst::assign(const exprt &lhs, nodet rhs)
+{
+  if(lhs.id()==ID_if)
+  {
+    assign(to_if_expr(lhs).true_case(), rhs);
+    assign(to_if_expr(lhs).false_case(), rhs);
+  }
+  else if(is_object(lhs))
+    join(pointee(location(lhs)), rhs);
+}
+
+void unification_value_setst::operator()(
+  const goto_functionst &goto_functions)
+{
+  forall_goto_functions(f_it, goto_functions)
+    if(f_it->second.body_available())
+      defined_functions.insert(f_it->first);
+
+  forall_goto_functions(f_it, goto_functions)
+  {
+    if(!f_it->second.body_available())
+      continue;
+
+    const nodet function=
+      symbol_node(symbol_exprt(f_it->first, f_it->second.type));
+
+    const code_typet::parameterst &parameters=
+      f_it->second.type.parameters();
+    const std::vector<nodet> function_signature=
+      signature(function, parameters.size());
+
+    for(std::size_t i=0; i<parameters.size(); ++i)
+    {
+      const irep_idt &identifier=parameters[i].get_identifier();
+      if(!identifier.empty())
+        join(
+          function_signature[i+1],
+          pointee(symbol_node(symbol_exprt(identifier, parameters[i].type()))));
+    }
+
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      location_number=i_it->location_number;
+
+      if(i_it->is_assign())
+      {
+        const code_assignt &code_assign=to_code_assign(i_it->code);
+        assign(code_assign.lhs(), code_assign.rhs());
+      }
+      else if(i_it->is_return())
+      {
+        const code_returnt &code_return=to_code_return(i_it->code);
+        if(code_return.has_return_value())
+          join(
+            signature(function, 0).front(),
+            value(code_return.return_value()));
+      }
+      else if(i_it->is_function_call())
+      {
+        const code_function_callt &call=to_code_function_call(i_it->code);
+
+        // direct and indirect calls alike: unify with the signature of
+        // the class of the callees
+        const nodet callees=location(call.function());
+        const std::vector<nodet> callee_signature=
+          signature(callees, call.arguments().size());
+
+        for(std::size_t i=0; i<call.arguments().size(); ++i)
+          join(callee_signature[i+1], value(call.arguments()[i]));
+
+        if(call.lhs().is_not_nil())
+          assign(call.lhs(), callee_signature.front());
+      }
+    }
+  }
+}
+
+/// Like location(), but only looks up the classes, rather than creating or
+/// joining them
+void unification_value_setst::query_location(
+  const exprt &expr,
+  queryt &dest) const
+{
+  if(expr.id()==ID_symbol)
+  {
+    const auto entry=
+      symbol_nodes.find(to_symbol_expr(expr).get_identifier());
+    if(entry!=symbol_nodes.end())
+      dest.classes.insert(find(entry->second));
+    else
+      dest.objects.push_back(expr);
+  }
+  else if(expr.id()==ID_dynamic_object ||
+          expr.id()==ID_string_constant ||
+          expr.id()==ID_label)
+  {
+    const auto number=object_numbering.get_number(expr);
+    if(number.has_value())
+      dest.classes.insert(find(object_nodes.at(*number)));
+    else
+      dest.objects.push_back(expr);
+  }
+  else if(expr.id()==ID_member ||
+          expr.id()==ID_index ||
+          expr.id()==ID_typecast ||
+          expr.id()==ID_byte_extract_little_endian ||
+          expr.id()==ID_byte_extract_big_endian)
+  {
+    query_location(expr.op0(), dest);
+  }
+  else if(expr.id()==ID_dereference)
+    query_value(to_dereference_expr(expr).pointer(), dest);
+  else if(expr.id()==ID_if)
+  {
+    query_location(to_if_expr(expr).true_case(), dest);
+    query_location(to_if_expr(expr).false_case(), dest);
+  }
+  else
+    dest.may_be_unknown=true;
+}
+
+/// Like value(), but only looks up the classes, rather than creating or
+/// joining them
+void unification_value_setst::query_value(
+  const exprt &expr,
+  queryt &dest) const
+{
+  if(expr.id()==ID_address_of)
+    query_location(to_address_of_expr(expr).object(), dest);
+  else if(expr.id()==ID_typecast)
+  {
+    const exprt &op=to_typecast_expr(expr).op();
+
+    if(expr.type().id()==ID_pointer &&
+       op.type().id()!=ID_pointer &&
+       op.is_zero())
+      dest.may_be_null=true;
+    else
+      query_value(op, dest);
+  }
+  else if(is_object(expr))
+  {
+    queryt locations;
+    query_location(expr, locations);
+
+    for(const auto &c : locations.classes)
+    {
+      const nodet p=attributes[c].pointee;
+      if(p!=no_node)
+        dest.classes.insert(find(p));
+    }
+
+    // objects that do not occur in the program have never been assigned
+    dest.may_be_unknown=dest.may_be_unknown || locations.may_be_unknown;
+  }
+  else if(expr.id()==ID_if)
+  {
+    query_value(to_if_expr(expr).true_case(), dest);
+    query_value(to_if_expr(expr).false_case(), dest);
+  }
+  else if(expr.is_constant() && expr.type().id()==ID_pointer)
+  {
+    if(expr.get(ID_value)==ID_NULL || expr.is_zero())
+      dest.may_be_null=true;
+    else
+      dest.may_be_unknown=true;
+  }
+  else if(expr.id()==ID_unknown ||
+          expr.id()==ID_invalid ||
+          expr.id()==ID_side_effect ||
+          (!expr.has_operands() && expr.type().id()==ID_pointer))
+  {
+    // includes non-deterministic pointers and allocations, which are only
+    // identified by the location of the assignment
+    dest.may_be_unknown=true;
+  }
+  else if(carries_pointers(expr))
+  {
+    forall_operands(it, expr)
+      query_value(*it, dest);
+  }
+}
+
+/// The classes \p expr may point to, with the attributes of the classes
+/// folded into the result
+unification_value_setst::queryt unification_value_setst::query(
+  const exprt &expr) const
+{
+  queryt result;
+  query_value(expr, result);
+
+  for(const auto &c : result.classes)
+  {
+    result.may_be_null=result.may_be_null || attributes[c].may_be_null;
+    result.may_be_unknown=
+      result.may_be_unknown || attributes[c].may_be_unknown;
+  }
+
+  return result;
+}
+
+void unification_value_setst::get_values(
+  goto_programt::const_targett l,
+  const exprt &expr,
+  valuest &dest)
+{
+  const queryt result=query(expr);
+
+  for(const auto &c : result.classes)
+  {
+    for(const auto &o : attributes[c].objects)
+    {
+      object_descriptor_exprt od;
+      od.object()=object_numbering[o];
+      od.type()=od.object().type();
+      dest.push_back(od);
+    }
+  }
+
+  for(const auto &object : result.objects)
+  {
+    object_descriptor_exprt od;
+    od.object()=object;
+    od.type()=od.object().type();
+    dest.push_back(od);
+  }
+
+  if(result.may_be_null)
+  {
+    const typet &type=ns.follow(expr.type());
+
+    object_descriptor_exprt od;
+    od.object()=
+      exprt(
+        ID_null_object,
+        type.id()==ID_pointer ? type.subtype() : empty_typet());
+    od.offset()=from_integer(0, index_type());
+    od.type()=od.object().type();
+    dest.push_back(od);
+  }
+
+  if(result.may_be_unknown)
+    dest.push_back(exprt(ID_unknown, expr.type()));
+}
+
+bool unification_value_setst::may_alias(const exprt &a, const exprt &b) const
+{
+  const queryt result_a=query(a);
+  const queryt result_b=query(b);
+
+  if(result_a.may_be_unknown || result_b.may_be_unknown)
+    return true;
+
+  for(const auto &c : result_a.classes)
+  {
+    if(result_b.classes.find(c)!=result_b.classes.end() &&
+       !attributes[c].objects.empty())
+      return true;
+  }
+
+  for(const auto &object : result_a.objects)
+  {
+    for(const auto &other : result_b.objects)
+    {
+      if(object==other)
+        return true;
+    }
+  }
+
+  return false;
+}
+
+std::size_t unification_value_setst::get_number_of_classes() const
+{
+  std::unordered_set<nodet> roots;
+
+  for(const auto &entry : object_nodes)
+    roots.insert(find(entry.second));
+
+  return roots.size();
+}
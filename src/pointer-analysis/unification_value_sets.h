@@ -0,0 +1,146 @@
+/*******************************************************************\
+
+Module: Unification-Based Points-To Analysis
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unification-Based Points-To Analysis
+
+#ifndef CPROVER_POINTER_ANALYSIS_UNIFICATION_VALUE_SETS_H
+#define CPROVER_POINTER_ANALYSIS_UNIFICATION_VALUE_SETS_H
+
+#include <limits>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <util/union_find.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include "object_numbering.h"
+#include "value_sets.h"
+
+/// A flow- and field-insensitive points-to analysis in the style of
+/// Steensgaard: the objects are partitioned into alias classes, and each
+/// class points to at most one other class. An assignment `p=q` unifies the
+/// classes `p` and `q` point to, rather than including one into the other,
+/// hence operator() is a single pass over the goto functions that runs in
+/// almost linear time, at the price of precision.
+///
+/// The result over-approximates the result of any of the inclusion-based or
+/// flow-sensitive analyses, and thus can serve as a cheap bound on the
+/// targets of a pointer, e.g., to rule out aliasing before running a more
+/// expensive analysis.
+class unification_value_setst:public value_setst
+{
+public:
+  explicit unification_value_setst(const namespacet &_ns);
+
+  /// Unify along all assignments, parameter passing and returns in
+  /// \p goto_functions; must be called before any query
+  void operator()(const goto_functionst &goto_functions);
+
+  /// The objects \p expr may point to; the location \p l is ignored. Queries
+  /// do not change the alias classes.
+  void get_values(
+    goto_programt::const_targett l,
+    const exprt &expr,
+    valuest &dest) override;
+
+  /// Returns false if the pointers \p a and \p b never point to the same
+  /// object
+  bool may_alias(const exprt &a, const exprt &b) const;
+
+  /// Number of alias classes of the objects seen so far
+  std::size_t get_number_of_classes() const;
+
+protected:
+  const namespacet &ns;
+
+  typedef unsigned_union_find::size_type nodet;
+  static const nodet no_node=std::numeric_limits<nodet>::max();
+
+  unsigned_union_find classes;
+
+  /// The attributes of each class, valid for its root only
+  struct attributest
+  {
+    nodet pointee;
+
+    /// for classes of functions: the return value, followed by the
+    /// parameters, as classes of the objects they point to
+    std::vector<nodet> signature;
+
+    bool may_be_null;
+    bool may_be_unknown;
+
+    /// the objects in this class
+    std::vector<object_numberingt::number_type> objects;
+
+    attributest():
+      pointee(no_node),
+      may_be_null(false),
+      may_be_unknown(false)
+    {
+    }
+  };
+
+  std::vector<attributest> attributes;
+
+  object_numberingt object_numbering;
+  std::unordered_map<irep_idt, nodet> symbol_nodes;
+  std::unordered_map<object_numberingt::number_type, nodet> object_nodes;
+
+  /// functions that have a body
+  std::unordered_set<irep_idt> defined_functions;
+
+  /// the instruction being processed, which identifies allocations
+  unsigned location_number;
+
+  nodet new_node();
+  nodet find(nodet n) const
+  {
+    return classes.find(n);
+  }
+  void join(nodet a, nodet b);
+  nodet pointee(nodet n);
+  std::vector<nodet> signature(nodet n, std::size_t arity);
+
+  nodet object_node(const exprt &object);
+  nodet symbol_node(const symbol_exprt &symbol_expr);
+
+  nodet location(const exprt &expr);
+  nodet value(const exprt &expr);
+
+  void assign(const exprt &lhs, const exprt &rhs);
+  void assign(const exprt &lhs, nodet rhs);
+
+  /// What an expression denotes or points to according to the classes
+  /// computed by operator()
+  struct queryt
+  {
+    /// the roots of the classes
+    std::set<nodet> classes;
+    /// objects that do not occur in the program, and hence have no class
+    std::vector<exprt> objects;
+    bool may_be_null;
+    bool may_be_unknown;
+
+    queryt():
+      may_be_null(false),
+      may_be_unknown(false)
+    {
+    }
+  };
+
+  queryt query(const exprt &expr) const;
+  void query_location(const exprt &expr, queryt &dest) const;
+  void query_value(const exprt &expr, queryt &dest) const;
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_UNIFICATION_VALUE_SETS_H
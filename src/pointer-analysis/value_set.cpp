@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <cassert>
 #include <ostream>
+#include <vector>
 
 #include <util/arith_tools.h>
 #include <util/base_type.h>
@@ -63,10 +64,13 @@ value_sett::entryt &value_sett::get_entry(
   else
     index=e.identifier;
 
-  std::pair<valuest::iterator, bool> r=
-    values.insert(std::pair<idt, entryt>(index, e));
+  return values.place(index, e).first;
+}
 
-  return r.first->second;
+const value_sett::entryt *value_sett::find_entry(const idt &id) const
+{
+  valuest::const_find_type found=values.find(id);
+  return found.second ? &found.first : nullptr;
 }
 
 bool value_sett::insert(
@@ -97,14 +101,14 @@ void value_sett::output(
   const namespacet &ns,
   std::ostream &out) const
 {
-  for(valuest::const_iterator
-      v_it=values.begin();
-      v_it!=values.end();
-      v_it++)
+  valuest::viewt view;
+  values.get_view(view);
+
+  for(const auto &value : view)
   {
     irep_idt identifier, display_name;
 
-    const entryt &e=v_it->second;
+    const entryt &e=value.second;
 
     if(has_prefix(id2string(e.identifier), "value_set::dynamic_object"))
     {
@@ -207,36 +211,28 @@ bool value_sett::make_union(const value_sett::valuest &new_values)
 {
   bool result=false;
 
-  valuest::iterator v_it=values.begin();
+  // entries in subtrees shared with our map are unchanged and are skipped
+  valuest::delta_viewt delta_view;
+  new_values.get_delta_view(values, delta_view, false);
 
-  for(valuest::const_iterator
-      it=new_values.begin();
-      it!=new_values.end();
-      ) // no it++
+  for(const auto &delta_item : delta_view)
   {
-    if(v_it==values.end() || it->first<v_it->first)
+    if(!delta_item.in_both)
     {
-      values.insert(v_it, *it);
+      values.insert(delta_item.k, delta_item.m, tvt(false));
       result=true;
-      it++;
       continue;
     }
-    else if(v_it->first<it->first)
-    {
-      v_it++;
-      continue;
-    }
-
-    assert(v_it->first==it->first);
 
-    entryt &e=v_it->second;
-    const entryt &new_e=it->second;
+    // union into a copy first, such that the path to the entry is only
+    // un-shared when something actually changes
+    object_mapt object_map=delta_item.other_m.object_map;
 
-    if(make_union(e.object_map, new_e.object_map))
+    if(make_union(object_map, delta_item.m.object_map))
+    {
+      values.find(delta_item.k, tvt(true)).first.object_map=object_map;
       result=true;
-
-    v_it++;
-    it++;
+    }
   }
 
   return result;
@@ -405,11 +401,10 @@ void value_sett::get_value_set_rec(
        expr_type.id()==ID_array)
     {
       // look it up
-      valuest::const_iterator v_it=
-        values.find(id2string(identifier)+suffix);
+      const entryt *entry=find_entry(id2string(identifier)+suffix);
 
       // try first component name as suffix if not yet found
-      if(v_it==values.end() &&
+      if(entry==nullptr &&
           (expr_type.id()==ID_struct ||
            expr_type.id()==ID_union))
       {
@@ -419,16 +414,16 @@ void value_sett::get_value_set_rec(
         const std::string first_component_name=
           struct_union_type.components().front().get_string(ID_name);
 
-        v_it=values.find(
+        entry=find_entry(
             id2string(identifier)+"."+first_component_name+suffix);
       }
 
       // not found? try without suffix
-      if(v_it==values.end())
-        v_it=values.find(identifier);
+      if(entry==nullptr)
+        entry=find_entry(identifier);
 
-      if(v_it!=values.end())
-        make_union(dest, v_it->second.object_map);
+      if(entry!=nullptr)
+        make_union(dest, entry->object_map);
       else
         insert(dest, exprt(ID_unknown, original_type));
     }
@@ -791,16 +786,16 @@ void value_sett::get_value_set_rec(
     const std::string full_name=prefix+suffix;
 
     // look it up
-    valuest::const_iterator v_it=values.find(full_name);
+    const entryt *entry=find_entry(full_name);
 
     // not found? try without suffix
-    if(v_it==values.end())
-      v_it=values.find(prefix);
+    if(entry==nullptr)
+      entry=find_entry(prefix);
 
-    if(v_it==values.end())
+    if(entry==nullptr)
       insert(dest, exprt(ID_unknown, original_type));
     else
-      make_union(dest, v_it->second.object_map);
+      make_union(dest, entry->object_map);
   }
   else if(expr.id()==ID_byte_extract_little_endian ||
           expr.id()==ID_byte_extract_big_endian)
@@ -1249,14 +1244,18 @@ void value_sett::do_free(
 
   // mark these as 'may be invalid'
   // this, unfortunately, destroys the sharing
-  for(valuest::iterator v_it=values.begin();
-      v_it!=values.end();
-      v_it++)
+  valuest::viewt view;
+  values.get_view(view);
+
+  // the view refers into the map, collect the updates before applying them
+  std::vector<std::pair<idt, object_mapt>> updates;
+
+  for(const auto &value : view)
   {
     object_mapt new_object_map;
 
     const object_map_dt &old_object_map=
-      v_it->second.object_map.read();
+      value.second.object_map.read();
 
     bool changed=false;
 
@@ -1289,8 +1288,11 @@ void value_sett::do_free(
     }
 
     if(changed)
-      v_it->second.object_map=new_object_map;
+      updates.emplace_back(value.first, new_object_map);
   }
+
+  for(const auto &update : updates)
+    values.find(update.first, tvt(true)).first.object_map=update.second;
 }
 
 void value_sett::assign_rec(
@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/mp_arith.h>
 #include <util/reference_counting.h>
+#include <util/sharing_map.h>
 
 #include "object_numbering.h"
 #include "value_sets.h"
@@ -283,11 +284,11 @@ public:
   ///
   /// The components of the ID are thus duplicated in the `valuest` key and in
   /// `entryt` fields.
-  #ifdef USE_DSTRING
-  typedef std::map<idt, entryt> valuest;
-  #else
-  typedef std::unordered_map<idt, entryt, string_hash> valuest;
-  #endif
+  ///
+  /// The map shares unmodified subtrees between copies, hence copying a value
+  /// set (as goto-symex does at every branch) is cheap, and merging two value
+  /// sets derived from a common ancestor only visits the entries that differ.
+  typedef sharing_mapt<idt, entryt, irep_id_hash> valuest;
 
   /// Gets values pointed to by `expr`, including following dereference
   /// operators (i.e. this is not a simple lookup in `valuest`).
@@ -329,6 +330,12 @@ public:
     const entryt &e, const typet &type,
     const namespacet &ns);
 
+  /// Finds an entry in this value-set. The interpretation of \p id is as for
+  /// the keys of `valuest`.
+  /// \param id: identifier and suffix of the entry to find
+  /// \return a pointer to the entry, or nullptr if there is no such entry
+  const entryt *find_entry(const idt &id) const;
+
   /// Pretty-print this value-set
   /// \param ns: global namespace
   /// \param [out] out: stream to write to
@@ -42,18 +42,18 @@ void value_sets_to_xml(
     xmlt &i=dest.new_element("instruction");
     i.new_element()=::xml(location);
 
-    for(value_sett::valuest::const_iterator
-        v_it=value_set.values.begin();
-        v_it!=value_set.values.end();
-        v_it++)
+    value_sett::valuest::viewt view;
+    value_set.values.get_view(view);
+
+    for(const auto &value : view)
     {
       xmlt &var=i.new_element("variable");
       var.new_element("identifier").data=
-        id2string(v_it->first);
+        id2string(value.first);
 
       #if 0
       const value_sett::expr_sett &expr_set=
-        v_it->second.expr_set();
+        value.second.expr_set();
 
       for(value_sett::expr_sett::const_iterator
           e_it=expr_set.begin();
@@ -69,6 +69,20 @@ void cover_goalst::freeze_goal_variables()
       prop_conv.set_frozen(g_it->condition);
 }
 
+/// Let the observers refine the formula
+/// \return true if any of them has, in which case the formula needs to be
+///   solved again
+bool cover_goalst::refine_assignment()
+{
+  bool refined=false;
+
+  for(const auto &o : observers)
+    if(o->refine_assignment())
+      refined=true;
+
+  return refined;
+}
+
 /// Try to cover all goals
 decision_proceduret::resultt cover_goalst::operator()()
 {
@@ -88,6 +102,12 @@ decision_proceduret::resultt cover_goalst::operator()()
     constraint();
     dec_result=prop_conv.dec_solve();
 
+    while(dec_result==decision_proceduret::resultt::D_SATISFIABLE &&
+          refine_assignment())
+    {
+      dec_result=prop_conv.dec_solve();
+    }
+
     switch(dec_result)
     {
     case decision_proceduret::resultt::D_UNSATISFIABLE: // DONE
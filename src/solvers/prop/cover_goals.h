@@ -81,6 +81,11 @@ public:
   public:
     virtual void goal_covered(const goalt &) { }
     virtual void satisfying_assignment() { }
+
+    /// Called with each satisfying assignment before it is used: an
+    /// observer that strengthens the formula such that the assignment may
+    /// no longer satisfy it returns true, and the formula is solved again
+    virtual bool refine_assignment() { return false; }
   };
 
   void register_observer(observert &o)
@@ -100,6 +105,7 @@ private:
   void mark();
   void constraint();
   void freeze_goal_variables();
+  bool refine_assignment();
 };
 
 #endif // CPROVER_SOLVERS_PROP_COVER_GOALS_H
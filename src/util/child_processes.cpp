@@ -0,0 +1,171 @@
+/*******************************************************************\
+
+Module: Running Jobs in Child Processes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Running Jobs in Child Processes
+
+#include "child_processes.h"
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "message.h"
+
+static std::string child_output_file(
+  const std::string &directory,
+  std::size_t job,
+  const char *suffix)
+{
+  return directory+"/"+std::to_string(job)+suffix;
+}
+
+#ifndef _WIN32
+/// Run \p job in this process, a child, with its output redirected, and exit
+static void run_child(
+  std::size_t job_number,
+  const std::string &directory,
+  message_handlert &message_handler,
+  const std::function<int(std::size_t)> &job)
+{
+  const int out=open(
+    child_output_file(directory, job_number, ".out").c_str(),
+    O_WRONLY|O_CREAT|O_TRUNC,
+    0600);
+  const int err=open(
+    child_output_file(directory, job_number, ".err").c_str(),
+    O_WRONLY|O_CREAT|O_TRUNC,
+    0600);
+  if(out>=0)
+    dup2(out, STDOUT_FILENO);
+  if(err>=0)
+    dup2(err, STDERR_FILENO);
+
+  messaget message(message_handler);
+  int status=1;
+
+  try
+  {
+    status=job(job_number);
+  }
+
+  catch(int)
+  {
+    // reported already
+  }
+
+  catch(const char *e)
+  {
+    message.error() << e << messaget::eom;
+  }
+
+  catch(const std::string &e)
+  {
+    message.error() << e << messaget::eom;
+  }
+
+  catch(const std::bad_alloc &)
+  {
+    message.error() << "Out of memory" << messaget::eom;
+  }
+
+  std::cout.flush();
+  std::cerr.flush();
+
+  // skip destructors, which would remove the parent's temporary files
+  _exit(status);
+}
+#endif
+
+std::vector<int> run_in_child_processes(
+  std::size_t count,
+  std::size_t max_processes,
+  const std::string &directory,
+  message_handlert &message_handler,
+  std::function<int(std::size_t)> job)
+{
+  std::vector<int> status(count, -1);
+
+#ifndef _WIN32
+  // the children inherit any buffered output
+  std::cout.flush();
+  std::cerr.flush();
+
+  std::map<pid_t, std::size_t> running;
+  std::size_t next=0;
+
+  while(next<count || !running.empty())
+  {
+    while(next<count && running.size()<max_processes)
+    {
+      const pid_t pid=fork();
+
+      if(pid==0)
+        run_child(next, directory, message_handler, job);
+      else if(pid<0)
+      {
+        // leave the remaining jobs to the caller
+        next=count;
+        break;
+      }
+
+      running[pid]=next;
+      ++next;
+    }
+
+    if(running.empty())
+      break;
+
+    int wstatus;
+    const pid_t pid=waitpid(-1, &wstatus, 0);
+
+    if(pid<0)
+      break;
+
+    std::map<pid_t, std::size_t>::iterator entry=running.find(pid);
+    if(entry==running.end())
+      continue;
+
+    status[entry->second]=WIFEXITED(wstatus) ? WEXITSTATUS(wstatus) : 1;
+    running.erase(entry);
+  }
+
+  // children we failed to wait for
+  for(const auto &entry : running)
+    status[entry.second]=1;
+#else
+  (void)max_processes;
+  (void)directory;
+  (void)message_handler;
+  (void)job;
+#endif
+
+  return status;
+}
+
+void replay_child_output(const std::string &directory, std::size_t job)
+{
+  std::ifstream out(
+    child_output_file(directory, job, ".out"), std::ios::binary);
+  if(out && out.peek()!=std::ifstream::traits_type::eof())
+    std::cout << out.rdbuf();
+  std::cout.flush();
+
+  std::ifstream err(
+    child_output_file(directory, job, ".err"), std::ios::binary);
+  if(err && err.peek()!=std::ifstream::traits_type::eof())
+    std::cerr << err.rdbuf();
+  std::cerr.flush();
+}
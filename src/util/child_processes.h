@@ -0,0 +1,41 @@
+/*******************************************************************\
+
+Module: Running Jobs in Child Processes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Running Jobs in Child Processes
+
+#ifndef CPROVER_UTIL_CHILD_PROCESSES_H
+#define CPROVER_UTIL_CHILD_PROCESSES_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+class message_handlert;
+
+/// Run each of the jobs 0 to `count-1` in a child process of its own, with up
+/// to \p max_processes children at a time. The standard output and error of
+/// job `i` are buffered in the files `i.out` and `i.err` in \p directory, see
+/// replay_child_output. The children are forks of the calling process: they
+/// can access its state, but their changes to it are lost. An exception that
+/// \p job throws is reported to \p message_handler and fails the child.
+/// \param job: runs the given job in the child, and returns its exit status
+/// \return the exit status of each job, or -1 for the jobs whose process
+///   could not be created, including all of them on platforms without fork
+std::vector<int> run_in_child_processes(
+  std::size_t count,
+  std::size_t max_processes,
+  const std::string &directory,
+  message_handlert &message_handler,
+  std::function<int(std::size_t)> job);
+
+/// Copy the buffered standard output and error of job \p job of
+/// run_in_child_processes to ours
+void replay_child_output(const std::string &directory, std::size_t job);
+
+#endif // CPROVER_UTIL_CHILD_PROCESSES_H
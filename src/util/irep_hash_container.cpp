@@ -18,16 +18,20 @@ size_t irep_hash_container_baset::number(const irept &irep)
 {
   // the ptr-hash provides a speedup of up to 3x
 
-  ptr_hasht::const_iterator it=ptr_hash.find(&irep.read());
+  // a single lookup for both the test and the insertion
+  std::pair<ptr_hasht::iterator, bool> entry=
+    ptr_hash.insert(std::make_pair(&irep.read(), 0));
 
-  if(it!=ptr_hash.end())
-    return it->second;
+  if(!entry.second)
+    return entry.first->second;
+
+  // pack() inserts further entries, which may invalidate the iterator but
+  // not references to the element
+  size_t &id=entry.first->second;
 
   packedt packed;
   pack(irep, packed);
-  size_t id=numbering.number(packed);
-
-  ptr_hash[&irep.read()]=id;
+  id=numbering.number(packed);
 
   return id;
 }
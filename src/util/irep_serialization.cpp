@@ -13,38 +13,73 @@ Date: May 2007
 
 #include "irep_serialization.h"
 
+#include <algorithm>
 #include <sstream>
 #include <iostream>
+#include <streambuf>
 
+#include "irep_hash.h"
 #include "string_hash.h"
 
-void irep_serializationt::write_irep(
-  std::ostream &out,
-  const irept &irep)
+/// appends the variable-length encoding of \p u to \p out, see
+/// write_gb_word
+static void append_gb_word(std::string &out, std::size_t u)
+{
+  while(true)
+  {
+    unsigned char value=u&0x7f;
+    u>>=7;
+
+    if(u==0)
+    {
+      out+=static_cast<char>(value);
+      break;
+    }
+
+    out+=static_cast<char>(value | 0x80);
+  }
+}
+
+/// appends \p s to \p out, see write_gb_string
+static void append_gb_string(std::string &out, const std::string &s)
+{
+  for(std::string::const_iterator it=s.begin();
+      it!=s.end();
+      ++it)
+  {
+    if(*it==0 || *it=='\\')
+      out+='\\'; // escape specials
+    out+=*it;
+  }
+
+  out+='\0';
+}
+
+void irep_serializationt::write_irep(const irept &irep)
 {
-  write_string_ref(out, irep.id());
+  write_string(irep.id());
 
   forall_irep(it, irep.get_sub())
   {
-    out.put('S');
-    reference_convert(*it, out);
+    write_buffer+='S';
+    write_irep_ref(*it);
   }
 
   forall_named_irep(it, irep.get_named_sub())
   {
-    out.put('N');
-    write_string_ref(out, it->first);
-    reference_convert(it->second, out);
+    write_buffer+='N';
+    write_string(it->first);
+    write_irep_ref(it->second);
   }
 
   forall_named_irep(it, irep.get_comments())
   {
-    out.put('C');
-    write_string_ref(out, it->first);
-    reference_convert(it->second, out);
+    write_buffer+='C';
+    write_string(it->first);
+    write_irep_ref(it->second);
   }
 
-  out.put(0); // terminator
+  write_buffer+='\0'; // terminator
 }
 
 void irep_serializationt::reference_convert(
@@ -53,6 +88,22 @@ void irep_serializationt::reference_convert(
 {
   std::size_t id=read_gb_word(in);
 
+  if(shared!=nullptr)
+  {
+    // the least significant bit tells references to the shared ireps apart
+    const bool local=(id&1)!=0;
+    id>>=1;
+
+    if(!local)
+    {
+      if(id<shared->ireps_on_read.size() && shared->ireps_on_read[id].first)
+        irep=shared->ireps_on_read[id].second;
+      else
+        in.setstate(std::ios::failbit);
+      return;
+    }
+  }
+
   if(id<ireps_container.ireps_on_read.size() &&
      ireps_container.ireps_on_read[id].first)
   {
@@ -72,28 +123,60 @@ void irep_serializationt::read_irep(
   irep.clear();
   irep.id(read_string_ref(in));
 
-  while(in.peek()=='S')
+  if(string_table!=nullptr)
+  {
+    // the counts are read from the input, hence the operands are added one
+    // by one, which consumes input for each, rather than allocated upfront
+    std::size_t count=read_gb_word(in);
+
+    irept::subt &sub=irep.get_sub();
+    for(std::size_t j=0; j<count && in; j++)
+    {
+      sub.push_back(irept());
+      reference_convert(in, sub.back());
+    }
+
+    for(unsigned i=0; i<2; i++) // named operands, then comments
+    {
+      count=read_gb_word(in);
+
+      for(std::size_t j=0; j<count && in; j++)
+      {
+        irept &r=irep.add(read_string_ref(in));
+        reference_convert(in, r);
+      }
+    }
+
+    // a truncated or corrupt irep is reported through the state of in,
+    // which the readers of goto binary sections check
+    return;
+  }
+
+  // access the buffer directly, which is much faster than the stream
+  std::streambuf &buf=*in.rdbuf();
+
+  while(buf.sgetc()=='S')
   {
-    in.get();
+    buf.sbumpc();
     irep.get_sub().push_back(irept());
     reference_convert(in, irep.get_sub().back());
   }
 
-  while(in.peek()=='N')
+  while(buf.sgetc()=='N')
   {
-    in.get();
+    buf.sbumpc();
     irept &r=irep.add(read_string_ref(in));
     reference_convert(in, r);
   }
 
-  while(in.peek()=='C')
+  while(buf.sgetc()=='C')
   {
-    in.get();
+    buf.sbumpc();
     irept &r=irep.add(read_string_ref(in));
     reference_convert(in, r);
   }
 
-  if(in.get()!=0)
+  if(buf.sbumpc()!=0)
   {
     std::cerr << "irep not terminated\n";
     throw 0;
@@ -104,6 +187,20 @@ void irep_serializationt::reference_convert(
   const irept &irep,
   std::ostream &out)
 {
+  // the irep is encoded into a buffer, which is written as a block
+  write_buffer.clear();
+  write_irep_ref(irep);
+  out.write(write_buffer.data(), write_buffer.size());
+}
+
+void irep_serializationt::write_irep_ref(const irept &irep)
+{
+  if(string_table!=nullptr)
+  {
+    write_packed_ref(numbering().number(irep));
+    return;
+  }
+
   std::size_t h=ireps_container.irep_full_hash_container.number(irep);
 
   // should be merged with insert
@@ -113,13 +210,221 @@ void irep_serializationt::reference_convert(
   if(fi==ireps_container.ireps_on_write.end())
   {
     size_t id=insert_on_write(h);
-    write_gb_word(out, id);
-    write_irep(out, irep);
+    append_gb_word(write_buffer, id);
+    write_irep(irep);
   }
   else
   {
-    write_gb_word(out, fi->second);
+    append_gb_word(write_buffer, fi->second);
+  }
+}
+
+void irep_serializationt::reference_convert(
+  std::size_t n,
+  std::ostream &out)
+{
+  write_buffer.clear();
+  write_packed_ref(n);
+  out.write(write_buffer.data(), write_buffer.size());
+}
+
+void irep_serializationt::write_packed_ref(std::size_t n)
+{
+  packed_numberingt &packed_numbering=numbering();
+  if(n>=packed_numbering.written.size())
+    packed_numbering.written.resize(packed_numbering.size(), {0, 0});
+
+  std::pair<std::size_t, std::size_t> &written=packed_numbering.written[n];
+
+  // the least significant bit tells references to the shared ireps apart
+  if(shared!=nullptr && written.first==shared->section)
+  {
+    append_gb_word(write_buffer, 2*written.second);
+    return;
+  }
+
+  if(written.first==ireps_container.section)
+  {
+    append_gb_word(
+      write_buffer, shared!=nullptr ? 2*written.second+1 : written.second);
+    return;
+  }
+
+  written.first=ireps_container.section;
+  written.second=ireps_container.ireps_written++;
+
+  append_gb_word(
+    write_buffer, shared!=nullptr ? 2*written.second+1 : written.second);
+  write_packed(n);
+}
+
+void irep_serializationt::write_packed(std::size_t n)
+{
+  const std::size_t *node=numbering().node(n);
+
+  append_gb_word(
+    write_buffer,
+    string_table->number(irep_idt::make_from_table_index(*node++)));
+
+  const std::size_t sub_count=*node++;
+  append_gb_word(write_buffer, sub_count);
+  for(std::size_t i=0; i<sub_count; i++)
+    write_packed_ref(*node++);
+
+  for(unsigned i=0; i<2; i++) // named operands, then comments
+  {
+    const std::size_t count=*node++;
+    append_gb_word(write_buffer, count);
+    for(std::size_t j=0; j<count; j++)
+    {
+      append_gb_word(
+        write_buffer,
+        string_table->number(irep_idt::make_from_table_index(*node++)));
+      write_packed_ref(*node++);
+    }
+  }
+}
+
+/// spreads the bits of \p h, as the tables of packed_numberingt only use
+/// its least significant bits
+static std::size_t spread_hash(std::size_t h)
+{
+  h*=static_cast<std::size_t>(0x9e3779b97f4a7c15ULL);
+  return h^(h>>(sizeof(std::size_t)*4));
+}
+
+std::size_t irep_serializationt::packed_numberingt::number(const irept &irep)
+{
+  const void *address=&irep.read();
+
+  if(!address_table.empty())
+  {
+    const std::size_t mask=address_table.size()-1;
+    for(std::size_t i=spread_hash(reinterpret_cast<std::size_t>(address))&mask;
+        address_table[i].first!=nullptr;
+        i=(i+1)&mask)
+    {
+      if(address_table[i].first==address)
+        return address_table[i].second;
+    }
+  }
+
+  // the operands push their nodes after this one, and pop them when done
+  const std::size_t begin=stack.size();
+
+  stack.push_back(irep.id().get_no());
+
+  const irept::subt &sub=irep.get_sub();
+  stack.push_back(sub.size());
+  forall_irep(it, sub)
+    stack.push_back(number(*it));
+
+  const irept::named_subt &named_sub=irep.get_named_sub();
+  stack.push_back(named_sub.size());
+  forall_named_irep(it, named_sub)
+  {
+    stack.push_back(it->first.get_no());
+    stack.push_back(number(it->second));
+  }
+
+  const irept::named_subt &comments=irep.get_comments();
+  stack.push_back(comments.size());
+  forall_named_irep(it, comments)
+  {
+    stack.push_back(it->first.get_no());
+    stack.push_back(number(it->second));
+  }
+
+  const std::size_t length=stack.size()-begin;
+  std::size_t h=length;
+  for(std::size_t i=begin; i<stack.size(); i++)
+    h=hash_combine(h, stack[i]);
+  h=spread_hash(h);
+
+  if(2*(size()+1)>node_table.size())
+  {
+    // grow, keeping the load at most one half
+    node_table.assign(node_table.empty() ? 1024 : 2*node_table.size(), 0);
+    const std::size_t mask=node_table.size()-1;
+    for(std::size_t n=0; n<size(); n++)
+    {
+      std::size_t i=hashes[n]&mask;
+      while(node_table[i]!=0)
+        i=(i+1)&mask;
+      node_table[i]=n+1;
+    }
   }
+
+  const std::size_t mask=node_table.size()-1;
+  std::size_t i=h&mask;
+  for(; node_table[i]!=0; i=(i+1)&mask)
+  {
+    const std::size_t n=node_table[i]-1;
+    if(hashes[n]==h &&
+       offsets[n+1]-offsets[n]==length &&
+       std::equal(
+         stack.begin()+begin, stack.end(), nodes.begin()+offsets[n]))
+    {
+      stack.resize(begin);
+      insert_address(address, n);
+      return n;
+    }
+  }
+
+  const std::size_t n=size();
+  nodes.insert(nodes.end(), stack.begin()+begin, stack.end());
+  offsets.push_back(nodes.size());
+  hashes.push_back(h);
+  node_table[i]=n+1;
+
+  stack.resize(begin);
+  insert_address(address, n);
+  return n;
+}
+
+void irep_serializationt::packed_numberingt::insert_address(
+  const void *address,
+  std::size_t n)
+{
+  if(2*(addresses+1)>address_table.size())
+  {
+    // grow, keeping the load at most one half
+    std::vector<std::pair<const void *, std::size_t>> old_table(
+      address_table.empty() ? 1024 : 2*address_table.size(),
+      std::pair<const void *, std::size_t>(nullptr, 0));
+    old_table.swap(address_table);
+
+    const std::size_t mask=address_table.size()-1;
+    for(const auto &entry : old_table)
+    {
+      if(entry.first==nullptr)
+        continue;
+      std::size_t i=
+        spread_hash(reinterpret_cast<std::size_t>(entry.first))&mask;
+      while(address_table[i].first!=nullptr)
+        i=(i+1)&mask;
+      address_table[i]=entry;
+    }
+  }
+
+  const std::size_t mask=address_table.size()-1;
+  std::size_t i=spread_hash(reinterpret_cast<std::size_t>(address))&mask;
+  while(address_table[i].first!=nullptr)
+    i=(i+1)&mask;
+  address_table[i]=std::make_pair(address, n);
+  addresses++;
+}
+
+void irep_serializationt::packed_numberingt::clear()
+{
+  written.clear();
+  nodes.clear();
+  offsets.assign(1, 0);
+  hashes.clear();
+  node_table.clear();
+  address_table.clear();
+  addresses=0;
+  stack.clear();
 }
 
 /// inserts an irep into the hashtable
@@ -166,20 +471,9 @@ std::size_t irep_serializationt::insert_on_read(
 void write_gb_word(std::ostream &out, std::size_t u)
 {
   // we write 7 bits each time, until we have zero
-
-  while(true)
-  {
-    unsigned char value=u&0x7f;
-    u>>=7;
-
-    if(u==0)
-    {
-      out.put(value);
-      break;
-    }
-
-    out.put(value | 0x80);
-  }
+  std::string buffer;
+  append_gb_word(buffer, u);
+  out.write(buffer.data(), buffer.size());
 }
 
 /// reads 4 characters and builds a long int from them
@@ -191,9 +485,22 @@ std::size_t irep_serializationt::read_gb_word(std::istream &in)
 
   unsigned shift_distance=0;
 
-  while(in.good())
+  if(!in.good())
+    return res;
+
+  // access the buffer directly, which is much faster than the stream
+  std::streambuf &buf=*in.rdbuf();
+
+  while(true)
   {
-    unsigned char ch=static_cast<unsigned char>(in.get());
+    const int c=buf.sbumpc();
+    if(c==std::char_traits<char>::eof())
+    {
+      in.setstate(std::ios::eofbit | std::ios::failbit);
+      break;
+    }
+
+    unsigned char ch=static_cast<unsigned char>(c);
     res|=(size_t(ch&0x7f))<<shift_distance;
     shift_distance+=7;
     if((ch&0x80)==0)
@@ -208,16 +515,10 @@ std::size_t irep_serializationt::read_gb_word(std::istream &in)
 /// \return nothing
 void write_gb_string(std::ostream &out, const std::string &s)
 {
-  for(std::string::const_iterator it=s.begin();
-      it!=s.end();
-      ++it)
-  {
-    if(*it==0 || *it=='\\')
-      out.put('\\'); // escape specials
-    out << *it;
-  }
-
-  out.put(0);
+  std::string buffer;
+  buffer.reserve(s.size()+1);
+  append_gb_string(buffer, s);
+  out.write(buffer.data(), buffer.size());
 }
 
 /// reads a string from the stream
@@ -225,19 +526,30 @@ void write_gb_string(std::ostream &out, const std::string &s)
 /// \return a string
 irep_idt irep_serializationt::read_gb_string(std::istream &in)
 {
-  char c;
+  // access the buffer directly, which is much faster than the stream
+  std::streambuf &buf=*in.rdbuf();
+  const int eof=std::char_traits<char>::eof();
   size_t length=0;
 
-  while((c=static_cast<char>(in.get()))!=0)
+  while(true)
   {
-    if(length>=read_buffer.size())
-      read_buffer.resize(read_buffer.size()*2, 0);
+    int c=buf.sbumpc();
 
     if(c=='\\') // escaped chars
-      read_buffer[length]=static_cast<char>(in.get());
-    else
-      read_buffer[length]=c;
+      c=buf.sbumpc();
+    else if(c==0)
+      break;
+
+    if(c==eof)
+    {
+      in.setstate(std::ios::eofbit | std::ios::failbit);
+      break;
+    }
 
+    if(length>=read_buffer.size())
+      read_buffer.resize(read_buffer.size()*2, 0);
+
+    read_buffer[length]=static_cast<char>(c);
     length++;
   }
 
@@ -251,17 +563,30 @@ void irep_serializationt::write_string_ref(
   std::ostream &out,
   const irep_idt &s)
 {
+  write_buffer.clear();
+  write_string(s);
+  out.write(write_buffer.data(), write_buffer.size());
+}
+
+void irep_serializationt::write_string(const irep_idt &s)
+{
+  if(string_table!=nullptr)
+  {
+    append_gb_word(write_buffer, string_table->number(s));
+    return;
+  }
+
   size_t id=irep_id_hash()(s);
   if(id>=ireps_container.string_map.size())
     ireps_container.string_map.resize(id+1, false);
 
-  if(ireps_container.string_map[id])
-    write_gb_word(out, id);
-  else
+  append_gb_word(write_buffer, id);
+
+  if(!ireps_container.string_map[id])
   {
     ireps_container.string_map[id]=true;
-    write_gb_word(out, id);
-    write_gb_string(out, id2string(s));
+
+    append_gb_string(write_buffer, id2string(s));
   }
 }
 
@@ -272,6 +597,15 @@ irep_idt irep_serializationt::read_string_ref(std::istream &in)
 {
   std::size_t id=read_gb_word(in);
 
+  if(string_table!=nullptr)
+  {
+    if(id<string_table->strings.size())
+      return string_table->strings[id];
+
+    in.setstate(std::ios::failbit);
+    return irep_idt();
+  }
+
   if(id>=ireps_container.string_rev_map.size())
     ireps_container.string_rev_map.resize(1+id*2,
       std::pair<bool, irep_idt>(false, irep_idt()));
@@ -283,8 +617,68 @@ irep_idt irep_serializationt::read_string_ref(std::istream &in)
   else
   {
     irep_idt s=read_gb_string(in);
+
     ireps_container.string_rev_map[id]=
       std::pair<bool, irep_idt>(true, s);
     return ireps_container.string_rev_map[id].second;
   }
 }
+
+std::size_t irep_serializationt::string_tablet::number(const irep_idt &s)
+{
+  const std::size_t id=irep_id_hash()(s);
+  if(id>=numbers.size())
+    numbers.resize(2*id+1, 0);
+
+  if(numbers[id]==0)
+  {
+    strings.push_back(s);
+    numbers[id]=strings.size();
+  }
+
+  return numbers[id]-1;
+}
+
+/// outputs the number of strings, and then each string, prefixed by its
+/// length
+void irep_serializationt::string_tablet::write(std::ostream &out) const
+{
+  write_gb_word(out, strings.size());
+
+  for(const auto &s : strings)
+  {
+    const std::string &str=id2string(s);
+    write_gb_word(out, str.size());
+    out.write(str.data(), str.size());
+  }
+}
+
+bool irep_serializationt::string_tablet::read(std::istream &in)
+{
+  numbers.clear();
+  strings.clear();
+
+  // the counts and lengths are read from the input, hence nothing is
+  // allocated before the corresponding input has been read
+  const std::size_t count=read_gb_word(in);
+
+  std::string str;
+  for(std::size_t i=0; i<count && in; i++)
+  {
+    const std::size_t length=read_gb_word(in);
+
+    str.clear();
+    while(in && str.size()<length)
+    {
+      const std::size_t chunk=std::min<std::size_t>(length-str.size(), 4096);
+      const std::size_t old_size=str.size();
+      str.resize(old_size+chunk);
+      in.read(&str[old_size], chunk);
+      str.resize(old_size+in.gcount());
+    }
+
+    strings.push_back(str);
+  }
+
+  return !in;
+}
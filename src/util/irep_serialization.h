@@ -14,9 +14,9 @@ Date: May 2007
 #ifndef CPROVER_UTIL_IREP_SERIALIZATION_H
 #define CPROVER_UTIL_IREP_SERIALIZATION_H
 
-#include <map>
 #include <iosfwd>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "irep_hash_container.h"
@@ -28,6 +28,60 @@ void write_gb_string(std::ostream &, const std::string &);
 class irep_serializationt
 {
 public:
+  /// Numbers ireps by their structure when writing the packed encoding. The
+  /// operands of an irep are numbered before the irep, and their numbers
+  /// make up its node, see node(), from which it is then encoded. Unlike
+  /// irep_full_hash_containert, this uses flat tables with open addressing
+  /// rather than node-based maps, as numbering dominates the time it takes
+  /// to write a goto binary.
+  class packed_numberingt
+  {
+  public:
+    /// the number of \p irep, which is numbered if needed
+    std::size_t number(const irept &irep);
+
+    /// The node of the irep with number \p n: the number of its id in
+    /// string_container, the number of its operands followed by their
+    /// numbers, and the number of its named operands followed by the
+    /// number of the name and the number of the operand of each; likewise
+    /// for its comments.
+    const std::size_t *node(std::size_t n) const
+    {
+      return nodes.data()+offsets[n];
+    }
+
+    std::size_t size() const
+    {
+      return offsets.size()-1;
+    }
+
+    void clear();
+
+    /// by number: the section the irep was last written to, and its number
+    /// in that section
+    std::vector<std::pair<std::size_t, std::size_t>> written;
+    /// the number of sections written so far, which are numbered from one
+    std::size_t sections=0;
+
+  protected:
+    /// the nodes of all ireps, one after the other
+    std::vector<std::size_t> nodes;
+    /// by number: the offset of the node in nodes, followed by the size of
+    /// nodes
+    std::vector<std::size_t> offsets={ 0 };
+    /// by number: the hash of the node
+    std::vector<std::size_t> hashes;
+    /// by hash of the node: one plus the number, or zero if empty
+    std::vector<std::size_t> node_table;
+    /// by address of the data of an irep: the address and the number
+    std::vector<std::pair<const void *, std::size_t>> address_table;
+    std::size_t addresses=0;
+    /// the nodes being built, those of operands following their irep's
+    std::vector<std::size_t> stack;
+
+    void insert_address(const void *address, std::size_t n);
+  };
+
   class ireps_containert
   {
   public:
@@ -35,9 +89,16 @@ public:
     ireps_on_readt ireps_on_read;
 
     irep_full_hash_containert irep_full_hash_container;
-    typedef std::map<unsigned, size_t> ireps_on_writet;
+    typedef std::unordered_map<std::size_t, std::size_t> ireps_on_writet;
     ireps_on_writet ireps_on_write;
 
+    /// numbers the ireps when writing the packed encoding
+    packed_numberingt packed_numbering;
+    /// when writing the packed encoding: the number of the section, and the
+    /// number of ireps written to it
+    std::size_t section=0;
+    std::size_t ireps_written=0;
+
     typedef std::vector<bool> string_mapt;
     string_mapt string_map;
 
@@ -48,17 +109,64 @@ public:
     {
       irep_full_hash_container.clear();
       ireps_on_write.clear();
+      packed_numbering.clear();
+      section=0;
+      ireps_written=0;
       ireps_on_read.clear();
       string_map.clear();
       string_rev_map.clear();
     }
   };
 
+  /// The strings of all sections of a goto binary of version 4 or later,
+  /// which are stored once, in a section of their own; the sections refer to
+  /// a string by its number in this table
+  class string_tablet
+  {
+  public:
+    /// by the number of a string in string_container: one plus its number in
+    /// this table, or zero if it has none yet
+    std::vector<std::size_t> numbers;
+    std::vector<irep_idt> strings;
+
+    /// the number of \p s, which is added if needed
+    std::size_t number(const irep_idt &s);
+
+    void write(std::ostream &) const;
+    /// \return true on error, false otherwise
+    bool read(std::istream &);
+  };
+
+  /// \param ic: the ireps and strings seen so far
   explicit irep_serializationt(ireps_containert &ic):
-    ireps_container(ic)
+    ireps_container(ic),
+    string_table(nullptr),
+    shared(nullptr)
+  {
+    read_buffer.resize(1, 0);
+    clear();
+  };
+
+  /// Use the encoding of goto binaries of version 4 and later, in which
+  /// strings are referred to by their number in \p _string_table, and the
+  /// number of operands and named operands of an irep precedes them, rather
+  /// than tagging each one of them
+  /// \param ic: the ireps seen so far
+  /// \param _string_table: the strings, shared by all sections
+  /// \param _shared: if not null, the ireps of another section, which this
+  ///   one may refer to, as function sections do to the symbol table
+  ///   section; when writing, its packed_numbering numbers the ireps of both
+  irep_serializationt(
+    ireps_containert &ic,
+    string_tablet &_string_table,
+    ireps_containert *_shared=nullptr):
+    ireps_container(ic),
+    string_table(&_string_table),
+    shared(_shared)
   {
     read_buffer.resize(1, 0);
     clear();
+    ireps_container.section=++numbering().sections;
   };
 
   std::size_t insert_on_write(std::size_t h);
@@ -66,6 +174,15 @@ public:
 
   void reference_convert(std::istream &, irept &irep);
   void reference_convert(const irept &irep, std::ostream &);
+  /// writes the irep with number \p n in numbering(), using the packed
+  /// encoding
+  void reference_convert(std::size_t n, std::ostream &);
+
+  /// the numbering of ireps when writing the packed encoding
+  packed_numberingt &numbering()
+  {
+    return (shared!=nullptr ? *shared : ireps_container).packed_numbering;
+  }
 
   irep_idt read_string_ref(std::istream &);
   void write_string_ref(std::ostream &, const irep_idt &);
@@ -78,8 +195,18 @@ public:
 private:
   ireps_containert &ireps_container;
   std::vector<char> read_buffer;
-
-  void write_irep(std::ostream &, const irept &irep);
+  /// the strings when using the packed encoding, null otherwise
+  string_tablet *const string_table;
+  ireps_containert *const shared;
+
+  /// the encoding of the irep or string being written
+  std::string write_buffer;
+
+  void write_irep_ref(const irept &irep);
+  void write_irep(const irept &irep);
+  void write_packed_ref(std::size_t n);
+  void write_packed(std::size_t n);
+  void write_string(const irep_idt &);
   void read_irep(std::istream &, irept &irep);
 };
 
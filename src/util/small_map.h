@@ -14,7 +14,7 @@ Author: Daniel Poetzl
 
 #include <bitset>
 #include <cstdint>
-#include <cstring>
+#include <cstdlib>
 #include <limits>
 #include <memory>
 #include <new>
@@ -23,8 +23,6 @@ Author: Daniel Poetzl
 
 #include "invariant.h"
 
-//#define _SMALL_MAP_REALLOC_STATS
-
 // The following templates are used by the class below to compute parameters at
 // compilation time. When having a compiler that supports constexpr, the
 // parameters are computed via static methods defined within the class.
@@ -141,26 +139,23 @@ private:
     return mem;
   }
 
-  T *allocate(T *ptr, std::size_t n) const
+  /// Move the first \p n elements of the block \p ptr of \p old_n elements
+  /// to a new block of \p n elements; the elements of \p ptr beyond \p n
+  /// must have been destroyed already. Elements are moved by their
+  /// constructors rather than by `realloc`, as \p T need not be trivially
+  /// copyable.
+  T *reallocate(T *ptr, std::size_t old_n, std::size_t n) const
   {
-    if(n == 0)
-      return nullptr;
-
-    T *mem = (T *)realloc(ptr, sizeof(T) * n);
+    T *mem = allocate(n);
 
-    if(!mem)
-      throw std::bad_alloc();
-
-#ifdef _SMALL_MAP_REALLOC_STATS
-    if(ptr == mem)
-    {
-      realloc_success++;
-    }
-    else if(ptr != nullptr)
+    const std::size_t moved = n < old_n ? n : old_n;
+    for(std::size_t i = 0; i < moved; i++)
     {
-      realloc_failure++;
+      new(mem + i) T(std::move(*(ptr + i)));
+      (ptr + i)->~T();
     }
-#endif
+
+    free(ptr);
 
     return mem;
   }
@@ -449,7 +444,7 @@ public:
     }
 
     std::size_t ii = size();
-    p = allocate(p, ii + 1);
+    p = reallocate(p, ii, ii + 1);
     new(p + ii) T();
 
     v = (ii << 1) | 1;
@@ -484,17 +479,13 @@ public:
 
       (p + ii)->~T();
       std::size_t n = size();
-      if(ii < n - 1)
+      for(std::size_t i = ii; i + 1 < n; i++)
       {
-        memmove(p + ii, p + ii + 1, sizeof(T) * (n - ii - 1));
+        new(p + i) T(std::move(*(p + i + 1)));
+        (p + i + 1)->~T();
       }
 
-      p = allocate(p, n - 1);
-
-      if(n == 1)
-      {
-        p = nullptr;
-      }
+      p = reallocate(p, n - 1, n - 1);
 
       set_field(idx, 0);
       shift_indices(ii);
@@ -577,11 +568,6 @@ public:
     return !ind;
   }
 
-#ifdef _SMALL_MAP_REALLOC_STATS
-  mutable std::size_t realloc_failure = 0;
-  mutable std::size_t realloc_success = 0;
-#endif
-
 private:
   index_fieldt ind;
   T *p;
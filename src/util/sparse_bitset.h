@@ -0,0 +1,370 @@
+/*******************************************************************\
+
+Module: Sparse Bit Sets
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Sparse, copy-on-write sets of small non-negative integers
+
+#ifndef CPROVER_UTIL_SPARSE_BITSET_H
+#define CPROVER_UTIL_SPARSE_BITSET_H
+
+#include "cow.h"
+#include "invariant.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/// A set of `std::size_t` stored as a sorted sequence of 64-bit chunks, each
+/// chunk holding the bits of one aligned block of 64 consecutive values.
+/// Only non-empty chunks are stored. The chunk sequence is shared between
+/// copies of a set and only duplicated on modification, which makes copying a
+/// set (e.g., when an abstract state is propagated to a successor location)
+/// a constant-time operation. Set union is performed chunk-wise and returns
+/// immediately when both operands share the same storage.
+class sparse_bitsett
+{
+public:
+  typedef std::size_t value_type;
+  typedef uint64_t wordt;
+
+  static const std::size_t bits_per_chunk = 64;
+
+protected:
+  struct chunkt
+  {
+    std::size_t index;
+    wordt bits;
+
+    chunkt(std::size_t _index, wordt _bits) : index(_index), bits(_bits)
+    {
+    }
+
+    bool operator==(const chunkt &other) const
+    {
+      return index == other.index && bits == other.bits;
+    }
+  };
+
+  typedef std::vector<chunkt> chunk_vectort;
+
+  struct chunkst : public copy_on_write_pointeet<unsigned>
+  {
+    chunk_vectort chunks;
+  };
+
+  copy_on_writet<chunkst> data;
+
+  const chunk_vectort &read() const
+  {
+    return data.read().chunks;
+  }
+
+  chunk_vectort &write()
+  {
+    return data.write(true).chunks;
+  }
+
+  static std::size_t chunk_index(std::size_t value)
+  {
+    return value / bits_per_chunk;
+  }
+
+  static wordt chunk_bit(std::size_t value)
+  {
+    return wordt(1) << (value % bits_per_chunk);
+  }
+
+  static chunk_vectort::const_iterator
+  find_chunk(const chunk_vectort &chunks, std::size_t index)
+  {
+    return std::lower_bound(
+      chunks.begin(),
+      chunks.end(),
+      index,
+      [](const chunkt &c, std::size_t i) { return c.index < i; });
+  }
+
+  static std::size_t count_bits(wordt w)
+  {
+    std::size_t result = 0;
+    for(; w != 0; w &= w - 1)
+      ++result;
+    return result;
+  }
+
+  static std::size_t lowest_bit(wordt w)
+  {
+    PRECONDITION(w != 0);
+    std::size_t result = 0;
+    while((w & 1) == 0)
+    {
+      w >>= 1;
+      ++result;
+    }
+    return result;
+  }
+
+public:
+  sparse_bitsett() = default;
+
+  // Copies only share the chunk storage. There are deliberately no move
+  // operations: a moved-from copy_on_writet holds no storage at all, whereas
+  // a set must remain usable (and empty or not) after being moved from.
+  sparse_bitsett(const sparse_bitsett &other) : data(other.data)
+  {
+  }
+
+  sparse_bitsett &operator=(const sparse_bitsett &other)
+  {
+    data = other.data;
+    return *this;
+  }
+
+  /// Iterates over the elements of the set in ascending order
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef std::size_t value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const std::size_t *pointer;
+    typedef const std::size_t &reference;
+
+    const_iterator() : chunks(nullptr), chunk(0), remaining(0), current(0)
+    {
+    }
+
+    reference operator*() const
+    {
+      return current;
+    }
+
+    pointer operator->() const
+    {
+      return &current;
+    }
+
+    const_iterator &operator++()
+    {
+      remaining &= remaining - 1;
+      advance();
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const
+    {
+      return chunk == other.chunk && remaining == other.remaining;
+    }
+
+    bool operator!=(const const_iterator &other) const
+    {
+      return !(*this == other);
+    }
+
+  private:
+    friend class sparse_bitsett;
+
+    const chunk_vectort *chunks;
+    std::size_t chunk;
+    wordt remaining;
+    std::size_t current;
+
+    const_iterator(const chunk_vectort &_chunks, std::size_t _chunk)
+      : chunks(&_chunks), chunk(_chunk), remaining(0), current(0)
+    {
+      if(chunk < chunks->size())
+        remaining = (*chunks)[chunk].bits;
+      advance();
+    }
+
+    /// Move to the lowest remaining bit, skipping to the next chunk when the
+    /// current one is exhausted
+    void advance()
+    {
+      while(remaining == 0)
+      {
+        if(chunk >= chunks->size())
+          return;
+        ++chunk;
+        if(chunk == chunks->size())
+          return;
+        remaining = (*chunks)[chunk].bits;
+      }
+
+      current = (*chunks)[chunk].index * bits_per_chunk + lowest_bit(remaining);
+    }
+  };
+
+  typedef const_iterator iterator;
+
+  const_iterator begin() const
+  {
+    return const_iterator(read(), 0);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(read(), read().size());
+  }
+
+  bool empty() const
+  {
+    return read().empty();
+  }
+
+  std::size_t size() const
+  {
+    std::size_t result = 0;
+    for(const auto &c : read())
+      result += count_bits(c.bits);
+    return result;
+  }
+
+  bool contains(std::size_t value) const
+  {
+    const chunk_vectort &chunks = read();
+    const std::size_t index = chunk_index(value);
+    chunk_vectort::const_iterator it = find_chunk(chunks, index);
+    return it != chunks.end() && it->index == index &&
+           (it->bits & chunk_bit(value)) != 0;
+  }
+
+  std::size_t count(std::size_t value) const
+  {
+    return contains(value) ? 1 : 0;
+  }
+
+  /// Add \p value to the set
+  /// \return true iff \p value was not yet contained in the set
+  bool insert(std::size_t value)
+  {
+    if(contains(value))
+      return false;
+
+    chunk_vectort &chunks = write();
+    const std::size_t index = chunk_index(value);
+
+    // common case: values are generated in ascending order
+    if(chunks.empty() || chunks.back().index < index)
+    {
+      chunks.emplace_back(index, chunk_bit(value));
+      return true;
+    }
+
+    const std::size_t offset = find_chunk(chunks, index) - chunks.begin();
+    if(offset < chunks.size() && chunks[offset].index == index)
+      chunks[offset].bits |= chunk_bit(value);
+    else
+      chunks.insert(chunks.begin() + offset, chunkt(index, chunk_bit(value)));
+
+    return true;
+  }
+
+  /// Remove \p value from the set
+  /// \return the number of elements removed (0 or 1)
+  std::size_t erase(std::size_t value)
+  {
+    if(!contains(value))
+      return 0;
+
+    chunk_vectort &chunks = write();
+    const std::size_t offset =
+      find_chunk(chunks, chunk_index(value)) - chunks.begin();
+    chunks[offset].bits &= ~chunk_bit(value);
+    if(chunks[offset].bits == 0)
+      chunks.erase(chunks.begin() + offset);
+
+    return 1;
+  }
+
+  void clear()
+  {
+    if(!empty())
+      write().clear();
+  }
+
+  /// Add all elements of \p other to this set
+  /// \return true iff this set changed
+  bool make_union(const sparse_bitsett &other)
+  {
+    if(data == other.data || other.empty())
+      return false;
+
+    if(empty())
+    {
+      data = other.data;
+      return true;
+    }
+
+    const chunk_vectort &a = read();
+    const chunk_vectort &b = other.read();
+
+    // check for inclusion first to avoid detaching shared storage
+    bool changed = false;
+    {
+      chunk_vectort::const_iterator it_a = a.begin();
+      for(const auto &c : b)
+      {
+        while(it_a != a.end() && it_a->index < c.index)
+          ++it_a;
+        if(it_a == a.end() || it_a->index != c.index ||
+           (c.bits & ~it_a->bits) != 0)
+        {
+          changed = true;
+          break;
+        }
+      }
+    }
+
+    if(!changed)
+      return false;
+
+    chunk_vectort result;
+    result.reserve(std::max(a.size(), b.size()));
+    chunk_vectort::const_iterator it_a = a.begin();
+    chunk_vectort::const_iterator it_b = b.begin();
+    while(it_a != a.end() || it_b != b.end())
+    {
+      if(it_b == b.end() || (it_a != a.end() && it_a->index < it_b->index))
+        result.push_back(*it_a++);
+      else if(it_a == a.end() || it_b->index < it_a->index)
+        result.push_back(*it_b++);
+      else
+      {
+        result.emplace_back(it_a->index, it_a->bits | it_b->bits);
+        ++it_a;
+        ++it_b;
+      }
+    }
+
+    write().swap(result);
+    return true;
+  }
+
+  bool operator==(const sparse_bitsett &other) const
+  {
+    return data == other.data || read() == other.read();
+  }
+
+  bool operator!=(const sparse_bitsett &other) const
+  {
+    return !(*this == other);
+  }
+};
+
+#endif // CPROVER_UTIL_SPARSE_BITSET_H
@@ -0,0 +1,133 @@
+/*******************************************************************\
+
+Module: Binary Symbol Conversions
+
+Author: CM Wintersteiger
+
+\*******************************************************************/
+
+/// \file
+/// Binary Symbol Conversions
+
+#include "symbol_serialization.h"
+
+#include <istream>
+#include <ostream>
+
+#include "irep_serialization.h"
+#include "symbol_table.h"
+
+void write_bin_symbol(
+  std::ostream &out,
+  const symbolt &sym,
+  irep_serializationt &irepconverter)
+{
+  // Since version 2, symbols are not converted to ireps,
+  // instead they are saved in a custom binary format
+
+  irepconverter.reference_convert(sym.type, out);
+  irepconverter.reference_convert(sym.value, out);
+  irepconverter.reference_convert(sym.location, out);
+
+  irepconverter.write_string_ref(out, sym.name);
+  irepconverter.write_string_ref(out, sym.module);
+  irepconverter.write_string_ref(out, sym.base_name);
+  irepconverter.write_string_ref(out, sym.mode);
+  irepconverter.write_string_ref(out, sym.pretty_name);
+
+  write_gb_word(out, 0); // old: sym.ordering
+
+  unsigned flags=0;
+  flags = (flags << 1) | static_cast<int>(sym.is_weak);
+  flags = (flags << 1) | static_cast<int>(sym.is_type);
+  flags = (flags << 1) | static_cast<int>(sym.is_property);
+  flags = (flags << 1) | static_cast<int>(sym.is_macro);
+  flags = (flags << 1) | static_cast<int>(sym.is_exported);
+  flags = (flags << 1) | static_cast<int>(sym.is_input);
+  flags = (flags << 1) | static_cast<int>(sym.is_output);
+  flags = (flags << 1) | static_cast<int>(sym.is_state_var);
+  flags = (flags << 1) | static_cast<int>(sym.is_parameter);
+  flags = (flags << 1) | static_cast<int>(sym.is_auxiliary);
+  flags = (flags << 1) | static_cast<int>(false); // sym.binding;
+  flags = (flags << 1) | static_cast<int>(sym.is_lvalue);
+  flags = (flags << 1) | static_cast<int>(sym.is_static_lifetime);
+  flags = (flags << 1) | static_cast<int>(sym.is_thread_local);
+  flags = (flags << 1) | static_cast<int>(sym.is_file_local);
+  flags = (flags << 1) | static_cast<int>(sym.is_extern);
+  flags = (flags << 1) | static_cast<int>(sym.is_volatile);
+
+  write_gb_word(out, flags);
+}
+
+void read_bin_symbol(
+  std::istream &in,
+  symbolt &sym,
+  irep_serializationt &irepconverter)
+{
+  irepconverter.reference_convert(in, sym.type);
+  irepconverter.reference_convert(in, sym.value);
+  irepconverter.reference_convert(in, sym.location);
+
+  sym.name = irepconverter.read_string_ref(in);
+  sym.module = irepconverter.read_string_ref(in);
+  sym.base_name = irepconverter.read_string_ref(in);
+  sym.mode = irepconverter.read_string_ref(in);
+  sym.pretty_name = irepconverter.read_string_ref(in);
+
+  // obsolete: symordering
+  irepconverter.read_gb_word(in);
+
+  std::size_t flags=irepconverter.read_gb_word(in);
+
+  sym.is_weak = (flags &(1 << 16))!=0;
+  sym.is_type = (flags &(1 << 15))!=0;
+  sym.is_property = (flags &(1 << 14))!=0;
+  sym.is_macro = (flags &(1 << 13))!=0;
+  sym.is_exported = (flags &(1 << 12))!=0;
+  sym.is_input = (flags &(1 << 11))!=0;
+  sym.is_output = (flags &(1 << 10))!=0;
+  sym.is_state_var = (flags &(1 << 9))!=0;
+  sym.is_parameter = (flags &(1 << 8))!=0;
+  sym.is_auxiliary = (flags &(1 << 7))!=0;
+  // sym.binding = (flags &(1 << 6))!=0;
+  sym.is_lvalue = (flags &(1 << 5))!=0;
+  sym.is_static_lifetime = (flags &(1 << 4))!=0;
+  sym.is_thread_local = (flags &(1 << 3))!=0;
+  sym.is_file_local = (flags &(1 << 2))!=0;
+  sym.is_extern = (flags &(1 << 1))!=0;
+  sym.is_volatile = (flags &1)!=0;
+}
+
+void write_bin_symbol_table(
+  std::ostream &out,
+  const symbol_tablet &symbol_table)
+{
+  irep_serializationt::ireps_containert irepc;
+  irep_serializationt irepconverter(irepc);
+
+  write_gb_word(out, symbol_table.symbols.size());
+
+  for(const auto &symbol_pair : symbol_table.symbols)
+    write_bin_symbol(out, symbol_pair.second, irepconverter);
+}
+
+bool read_bin_symbol_table(
+  std::istream &in,
+  symbol_tablet &symbol_table)
+{
+  irep_serializationt::ireps_containert irepc;
+  irep_serializationt irepconverter(irepc);
+
+  const std::size_t count=irepconverter.read_gb_word(in);
+
+  for(std::size_t i=0; i<count && in; i++)
+  {
+    symbolt symbol;
+    read_bin_symbol(in, symbol, irepconverter);
+
+    if(in)
+      symbol_table.add(symbol);
+  }
+
+  return !in;
+}
@@ -0,0 +1,44 @@
+/*******************************************************************\
+
+Module: Binary Symbol Conversions
+
+Author: CM Wintersteiger
+
+\*******************************************************************/
+
+/// \file
+/// Binary Symbol Conversions
+
+#ifndef CPROVER_UTIL_SYMBOL_SERIALIZATION_H
+#define CPROVER_UTIL_SYMBOL_SERIALIZATION_H
+
+#include <iosfwd>
+
+class irep_serializationt;
+class symbolt;
+class symbol_tablet;
+
+/// Write \p symbol in the format of the symbols of goto binaries
+void write_bin_symbol(
+  std::ostream &out,
+  const symbolt &symbol,
+  irep_serializationt &irepconverter);
+
+void read_bin_symbol(
+  std::istream &in,
+  symbolt &symbol,
+  irep_serializationt &irepconverter);
+
+/// Write the number of symbols of \p symbol_table, followed by the symbols
+void write_bin_symbol_table(
+  std::ostream &out,
+  const symbol_tablet &symbol_table);
+
+/// Add the symbols written by \ref write_bin_symbol_table to
+/// \p symbol_table
+/// \return true on error, false otherwise
+bool read_bin_symbol_table(
+  std::istream &in,
+  symbol_tablet &symbol_table);
+
+#endif // CPROVER_UTIL_SYMBOL_SERIALIZATION_H
@@ -0,0 +1,118 @@
+/*******************************************************************\
+
+Module: Unit tests for post_dominators_cachet
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <iostream>
+
+#include <testing-utils/catch.hpp>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+
+#include <goto-programs/goto_convert_functions.h>
+
+#include <analyses/dependence_graph.h>
+#include <analyses/post_dominators_cache.h>
+
+#include <ansi-c/ansi_c_language.h>
+
+#include <langapi/mode.h>
+
+static symbolt create_void_function_symbol(
+  const irep_idt &name,
+  const codet &code)
+{
+  symbolt function;
+  function.name=name;
+  function.type=code_typet();
+  function.mode=ID_C;
+  function.value=code;
+  return function;
+}
+
+SCENARIO(
+  "post_dominators_cache",
+  "[core][analyses][post_dominators_cache]")
+{
+  GIVEN("A program with a branch")
+  {
+    // void __CPROVER__start() {
+    //   if(NONDET(int)==0)
+    //     b();
+    // }
+    // void b() { }
+
+    register_language(new_ansi_c_language);
+
+    goto_modelt goto_model;
+    const namespacet ns(goto_model.symbol_table);
+
+    code_ifthenelset if_block;
+    if_block.cond()=
+      equal_exprt(
+        side_effect_expr_nondett(signed_int_type()),
+        from_integer(0, signed_int_type()));
+    code_function_callt call;
+    call.function()=symbol_exprt("b", code_typet());
+    if_block.then_case()=call;
+
+    code_blockt body;
+    body.move_to_operands(if_block);
+
+    goto_model.symbol_table.add(
+      create_void_function_symbol(goto_functionst::entry_point(), body));
+    goto_model.symbol_table.add(
+      create_void_function_symbol("b", code_skipt()));
+
+    stream_message_handlert message_handler(std::cerr);
+    goto_convert(goto_model, message_handler);
+
+    post_dominators_cachet cache;
+    {
+      dependence_grapht dep_graph(ns, cache);
+      dep_graph(goto_model.goto_functions, ns);
+    }
+
+    const std::size_t functions=cache.get_misses();
+    REQUIRE(functions==2);
+    REQUIRE(cache.get_hits()==0);
+
+    WHEN("Another dependence graph is built for the same functions")
+    {
+      dependence_grapht dep_graph(ns, cache);
+      dep_graph(goto_model.goto_functions, ns);
+
+      THEN("The post-dominators of all functions are reused")
+      {
+        REQUIRE(cache.get_misses()==functions);
+        REQUIRE(cache.get_hits()==functions);
+        REQUIRE(dep_graph.cfg_post_dominators().size()==functions);
+      }
+    }
+
+    WHEN("The control flow of one function changes")
+    {
+      goto_programt &start=
+        goto_model.goto_functions.function_map.at(
+          goto_functionst::entry_point()).body;
+      for(auto &instruction : start.instructions)
+        if(instruction.is_goto())
+          instruction.make_skip();
+
+      dependence_grapht dep_graph(ns, cache);
+      dep_graph(goto_model.goto_functions, ns);
+
+      THEN("Only the post-dominators of that function are recomputed")
+      {
+        REQUIRE(cache.get_misses()==functions+1);
+        REQUIRE(cache.get_hits()==functions-1);
+      }
+    }
+  }
+}
@@ -0,0 +1,370 @@
+/*******************************************************************\
+
+Module: Unit tests for accelerator_cachet
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <fstream>
+
+#ifndef _WIN32
+#include <dirent.h>
+#endif
+
+#include <testing-utils/catch.hpp>
+
+#include <util/arith_tools.h>
+#include <util/std_code.h>
+#include <util/std_expr.h>
+#include <util/std_types.h>
+#include <util/symbol_table.h>
+#include <util/tempdir.h>
+
+#include <goto-instrument/accelerate/accelerator_cache.h>
+
+static symbol_exprt add_symbol(
+  symbol_tablet &symbol_table,
+  const irep_idt &name,
+  const irep_idt &module)
+{
+  symbolt symbol;
+  symbol.name=name;
+  symbol.base_name=name;
+  symbol.module=module;
+  symbol.type=signedbv_typet(32);
+  symbol_table.add(symbol);
+  return symbol.symbol_expr();
+}
+
+/// while(x<bound) x=x+overflow;
+/// where overflow is an auxiliary symbol of the acceleration
+static accelerator_cachet::loopt add_loop(
+  goto_programt &body,
+  const symbol_exprt &x,
+  const symbol_exprt &overflow,
+  int bound)
+{
+  goto_programt::targett head=body.add_instruction(ASSIGN);
+  head->code=code_assignt(x, plus_exprt(x, overflow));
+  goto_programt::targett jump=body.add_instruction(GOTO);
+  jump->guard=binary_relation_exprt(x, ID_lt, from_integer(bound, x.type()));
+  jump->targets.push_back(head);
+  body.add_instruction(END_FUNCTION);
+  body.update();
+
+  return accelerator_cachet::loopt{head, jump};
+}
+
+/// while(x<10) { g(); x=x+overflow; }
+static accelerator_cachet::loopt add_loop_with_call(
+  goto_programt &body,
+  const symbol_exprt &x,
+  const symbol_exprt &overflow)
+{
+  goto_programt::targett call=body.add_instruction(FUNCTION_CALL);
+  code_function_callt code;
+  code.function()=symbol_exprt("g", code_typet());
+  call->code=code;
+  goto_programt::targett assign=body.add_instruction(ASSIGN);
+  assign->code=code_assignt(x, plus_exprt(x, overflow));
+  goto_programt::targett jump=body.add_instruction(GOTO);
+  jump->guard=binary_relation_exprt(x, ID_lt, from_integer(10, x.type()));
+  jump->targets.push_back(call);
+  body.add_instruction(END_FUNCTION);
+  body.update();
+
+  return accelerator_cachet::loopt{call, assign, jump};
+}
+
+/// void g() { y=value; }
+static void add_g(
+  goto_functionst &goto_functions,
+  const symbol_exprt &y,
+  int value)
+{
+  goto_programt &body=goto_functions.function_map["g"].body;
+  body.add_instruction(ASSIGN)->code=
+    code_assignt(y, from_integer(value, y.type()));
+  body.add_instruction(END_FUNCTION);
+  body.update();
+}
+
+/// A symbol of type struct s, where struct s has a single component of
+/// type \p component_type
+static symbol_exprt add_struct_symbol(
+  symbol_tablet &symbol_table,
+  const typet &component_type)
+{
+  struct_typet s;
+  s.components().push_back(struct_typet::componentt("c", component_type));
+
+  symbolt tag;
+  tag.name="tag-s";
+  tag.base_name="s";
+  tag.is_type=true;
+  tag.type=s;
+  symbol_table.add(tag);
+
+  symbolt symbol;
+  symbol.name="v";
+  symbol.base_name="v";
+  symbol.module="main";
+  symbol.type=symbol_typet("tag-s");
+  symbol_table.add(symbol);
+  return symbol.symbol_expr();
+}
+
+/// A path accelerator for the loop \p loop that assigns \p x
+static path_acceleratort make_accelerator(
+  const accelerator_cachet::loopt &loop,
+  const symbol_exprt &x)
+{
+  path_acceleratort accelerator;
+  for(const auto &t : loop)
+    accelerator.path.push_back(path_nodet(t));
+  accelerator.pure_accelerator.add_instruction(ASSIGN)->code=
+    code_assignt(x, from_integer(10, x.type()));
+  accelerator.changed_vars.insert(x);
+  return accelerator;
+}
+
+SCENARIO(
+  "accelerator_cache",
+  "[core][goto-instrument][accelerator_cache]")
+{
+  temp_dirt directory("accelerator-cache-XXXXXX");
+
+  GIVEN("The accelerator of a loop in the cache")
+  {
+    symbol_tablet symbol_table;
+    const symbol_exprt x=add_symbol(symbol_table, "x", "main");
+    const symbol_exprt overflow=
+      add_symbol(symbol_table, "accelerate::overflow_3", "scratch");
+    const symbol_exprt stash=
+      add_symbol(symbol_table, "polynomial::stash_7", "scratch");
+
+    goto_programt body;
+    const accelerator_cachet::loopt loop=add_loop(body, x, overflow, 10);
+
+    path_acceleratort accelerator;
+    accelerator.path.push_back(path_nodet(loop[0]));
+    accelerator.path.push_back(path_nodet(loop[1], true_exprt()));
+    accelerator.pure_accelerator.add_instruction(ASSIGN)->code=
+      code_assignt(x, plus_exprt(stash, overflow));
+    accelerator.pure_accelerator.add_instruction(SKIP);
+    goto_programt::targett back=
+      accelerator.pure_accelerator.add_instruction(GOTO);
+    back->targets.push_back(
+      accelerator.pure_accelerator.instructions.begin());
+    accelerator.changed_vars.insert(x);
+
+    goto_functionst goto_functions;
+    accelerator_cachet cache(
+      directory.path, goto_functions, symbol_table, false, -1);
+    REQUIRE(!cache.store(loop, {accelerator}));
+
+    WHEN("The same loop is accelerated in another run")
+    {
+      symbol_tablet new_symbol_table;
+      const symbol_exprt new_x=add_symbol(new_symbol_table, "x", "main");
+      const symbol_exprt new_overflow=
+        add_symbol(new_symbol_table, "accelerate::overflow_0", "scratch");
+
+      goto_programt new_body;
+      const accelerator_cachet::loopt new_loop=
+        add_loop(new_body, new_x, new_overflow, 10);
+
+      accelerator_cachet new_cache(
+        directory.path, goto_functions, new_symbol_table, false, -1);
+      std::list<path_acceleratort> accelerators;
+
+      THEN("The accelerator is found for the new loop")
+      {
+        REQUIRE(!new_cache.lookup(new_loop, accelerators));
+        REQUIRE(accelerators.size()==1);
+
+        const path_acceleratort &found=accelerators.front();
+        REQUIRE(found.path.size()==2);
+        REQUIRE(found.path.front().loc==new_loop[0]);
+        REQUIRE(found.path.back().loc==new_loop[1]);
+        REQUIRE(found.path.back().guard==true_exprt());
+        REQUIRE(found.changed_vars.size()==1);
+        REQUIRE(*found.changed_vars.begin()==new_x);
+
+        // the auxiliary symbols of the loop are renamed, and the others are
+        // made afresh
+        const symbol_exprt new_stash(
+          "polynomial::stash_cached_0", signedbv_typet(32));
+        REQUIRE(new_symbol_table.has_symbol(new_stash.get_identifier()));
+
+        const goto_programt &pure=found.pure_accelerator;
+        REQUIRE(pure.instructions.size()==3);
+        REQUIRE(
+          pure.instructions.front().code==
+          code_assignt(new_x, plus_exprt(new_stash, new_overflow)));
+        REQUIRE(
+          pure.instructions.back().get_target()==pure.instructions.begin());
+      }
+    }
+
+    WHEN("A different loop is accelerated")
+    {
+      goto_programt other_body;
+      const accelerator_cachet::loopt other_loop=
+        add_loop(other_body, x, overflow, 11);
+
+      std::list<path_acceleratort> accelerators;
+
+      THEN("It is not in the cache")
+      {
+        REQUIRE(cache.lookup(other_loop, accelerators));
+        REQUIRE(accelerators.empty());
+      }
+    }
+
+    WHEN("The same loop is accelerated with other options")
+    {
+      accelerator_cachet z3_cache(
+        directory.path, goto_functions, symbol_table, true, -1);
+      accelerator_cachet limited_cache(
+        directory.path, goto_functions, symbol_table, false, 1);
+      std::list<path_acceleratort> accelerators;
+
+      THEN("It is not in the cache")
+      {
+        REQUIRE(z3_cache.lookup(loop, accelerators));
+        REQUIRE(limited_cache.lookup(loop, accelerators));
+        REQUIRE(accelerators.empty());
+      }
+    }
+
+#ifndef _WIN32
+    WHEN("The cache file is corrupt")
+    {
+      DIR *dir=opendir(directory.path.c_str());
+      REQUIRE(dir!=nullptr);
+      while(dirent *entry=readdir(dir))
+      {
+        const std::string name=entry->d_name;
+        if(name.size()>4 && name.substr(name.size()-4)==".acc")
+          std::ofstream(directory(name), std::ios::binary) << "garbage";
+      }
+      closedir(dir);
+
+      std::list<path_acceleratort> accelerators;
+
+      THEN("The loop is not in the cache")
+      {
+        REQUIRE(cache.lookup(loop, accelerators));
+        REQUIRE(accelerators.empty());
+      }
+    }
+#endif
+  }
+
+  GIVEN("The accelerator of a loop that calls a function in the cache")
+  {
+    symbol_tablet symbol_table;
+    const symbol_exprt x=add_symbol(symbol_table, "x", "main");
+    const symbol_exprt y=add_symbol(symbol_table, "y", "main");
+    const symbol_exprt overflow=
+      add_symbol(symbol_table, "accelerate::overflow_3", "scratch");
+
+    goto_functionst goto_functions;
+    add_g(goto_functions, y, 1);
+
+    goto_programt body;
+    const accelerator_cachet::loopt loop=
+      add_loop_with_call(body, x, overflow);
+
+    accelerator_cachet cache(
+      directory.path, goto_functions, symbol_table, false, -1);
+    REQUIRE(!cache.store(loop, {make_accelerator(loop, x)}));
+
+    std::list<path_acceleratort> accelerators;
+
+    WHEN("The function is unchanged")
+    {
+      THEN("The loop is in the cache")
+      {
+        REQUIRE(!cache.lookup(loop, accelerators));
+        REQUIRE(accelerators.size()==1);
+      }
+    }
+
+    WHEN("The body of the function changes")
+    {
+      goto_functions.function_map["g"].body.clear();
+      add_g(goto_functions, y, 2);
+
+      THEN("The loop is not in the cache")
+      {
+        REQUIRE(cache.lookup(loop, accelerators));
+        REQUIRE(accelerators.empty());
+      }
+    }
+  }
+
+  GIVEN("The accelerator of a loop over a struct in the cache")
+  {
+    symbol_tablet symbol_table;
+    const symbol_exprt x=add_symbol(symbol_table, "x", "main");
+    const symbol_exprt overflow=
+      add_symbol(symbol_table, "accelerate::overflow_3", "scratch");
+    const symbol_exprt v=add_struct_symbol(symbol_table, signedbv_typet(32));
+
+    goto_functionst goto_functions;
+    goto_programt body;
+    accelerator_cachet::loopt loop=add_loop(body, x, overflow, 10);
+    goto_programt::targett clear=body.insert_before(loop.front());
+    clear->make_assignment();
+    clear->code=code_assignt(v, side_effect_expr_nondett(v.type()));
+    loop.insert(loop.begin(), clear);
+
+    accelerator_cachet cache(
+      directory.path, goto_functions, symbol_table, false, -1);
+    REQUIRE(!cache.store(loop, {make_accelerator(loop, x)}));
+
+    WHEN("The struct is unchanged")
+    {
+      std::list<path_acceleratort> accelerators;
+
+      THEN("The loop is in the cache")
+      {
+        REQUIRE(!cache.lookup(loop, accelerators));
+        REQUIRE(accelerators.size()==1);
+      }
+    }
+
+    WHEN("The definition of the struct changes in another run")
+    {
+      symbol_tablet new_symbol_table;
+      const symbol_exprt new_x=add_symbol(new_symbol_table, "x", "main");
+      const symbol_exprt new_overflow=
+        add_symbol(new_symbol_table, "accelerate::overflow_3", "scratch");
+      const symbol_exprt new_v=
+        add_struct_symbol(new_symbol_table, signedbv_typet(8));
+
+      goto_programt new_body;
+      accelerator_cachet::loopt new_loop=
+        add_loop(new_body, new_x, new_overflow, 10);
+      goto_programt::targett new_clear=
+        new_body.insert_before(new_loop.front());
+      new_clear->make_assignment();
+      new_clear->code=
+        code_assignt(new_v, side_effect_expr_nondett(new_v.type()));
+      new_loop.insert(new_loop.begin(), new_clear);
+
+      accelerator_cachet new_cache(
+        directory.path, goto_functions, new_symbol_table, false, -1);
+      std::list<path_acceleratort> accelerators;
+
+      THEN("The loop is not in the cache")
+      {
+        REQUIRE(new_cache.lookup(new_loop, accelerators));
+        REQUIRE(accelerators.empty());
+      }
+    }
+  }
+}
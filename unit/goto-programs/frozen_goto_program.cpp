@@ -0,0 +1,137 @@
+/*******************************************************************\
+
+Module: Unit tests for frozen_goto_programt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+
+#include <goto-programs/frozen_goto_program.h>
+
+/// while(x) skip; assert(x==0); as the body of \p function
+static void add_loop(goto_programt &body, const irep_idt &function)
+{
+  const symbol_exprt x(id2string(function)+"::x", signed_int_type());
+  const exprt zero=from_integer(0, x.type());
+
+  goto_programt::targett loop=body.add_instruction(SKIP);
+  goto_programt::targett jump=body.add_instruction(GOTO);
+  jump->guard=notequal_exprt(x, zero);
+  jump->targets.push_back(loop);
+  body.add_instruction(ASSERT)->guard=equal_exprt(x, zero);
+  body.add_instruction(END_FUNCTION);
+
+  for(auto &instruction : body.instructions)
+    instruction.function=function;
+}
+
+SCENARIO(
+  "frozen_goto_program",
+  "[core][goto-programs][frozen_goto_program]")
+{
+  GIVEN("A goto function with a loop")
+  {
+    goto_functionst goto_functions;
+    add_loop(goto_functions.function_map["g"].body, "g");
+    add_loop(goto_functions.function_map["f"].body, "f");
+    goto_functions.update();
+
+    const goto_programt &body=goto_functions.function_map.at("f").body;
+
+    WHEN("It is frozen")
+    {
+      const frozen_goto_programt frozen(body);
+
+      THEN("Targets are indices")
+      {
+        REQUIRE(frozen.size()==4);
+        REQUIRE(frozen[1].is_goto());
+        REQUIRE(frozen[1].get_target()==0);
+        REQUIRE(frozen[0].is_target());
+        REQUIRE(frozen.is_backwards_goto(1));
+        REQUIRE(!frozen.is_backwards_goto(2));
+
+        const frozen_goto_programt::targetst successors{0, 2};
+        REQUIRE(frozen.get_successors(1)==successors);
+        REQUIRE(frozen.get_successors(3).empty());
+
+        const frozen_goto_programt::targetst incoming_edges{1};
+        REQUIRE(frozen[0].incoming_edges==incoming_edges);
+      }
+
+      THEN("Locations can be found")
+      {
+        const unsigned first=body.instructions.front().location_number;
+        REQUIRE(frozen.find_location(first+2)==2);
+        REQUIRE(frozen.find_location(first+4)==frozen.size());
+      }
+
+      THEN("It can be thawed")
+      {
+        goto_programt thawed;
+        frozen.thaw(thawed);
+
+        REQUIRE(thawed.instructions.size()==body.instructions.size());
+
+        auto it=body.instructions.begin();
+        for(const auto &instruction : thawed.instructions)
+        {
+          REQUIRE(instruction.type==it->type);
+          REQUIRE(instruction.guard==it->guard);
+          REQUIRE(instruction.location_number==it->location_number);
+          ++it;
+        }
+
+        goto_programt::const_targett jump=
+          std::next(thawed.instructions.begin());
+        REQUIRE(jump->get_target()==thawed.instructions.begin());
+        REQUIRE(jump->is_backwards_goto());
+      }
+    }
+
+    WHEN("All functions are frozen")
+    {
+      const frozen_goto_functionst frozen(goto_functions);
+
+      THEN("Locations are found across functions")
+      {
+        for(const auto &f : goto_functions.function_map)
+        {
+          const unsigned location_number=
+            f.second.body.instructions.back().location_number;
+
+          frozen_goto_programt::targett target;
+          const auto function=frozen.find_location(location_number, target);
+          REQUIRE(function!=nullptr);
+          REQUIRE(function->first==f.first);
+          REQUIRE(target==3);
+          REQUIRE(function->second[target].function==f.first);
+        }
+
+        frozen_goto_programt::targett target;
+        REQUIRE(frozen.find_location(1000, target)==nullptr);
+      }
+
+      THEN("Copies find locations in their own bodies")
+      {
+        frozen_goto_functionst copy(frozen);
+        const frozen_goto_functionst::function_mapt &copied_functions=
+          copy.get_function_map();
+
+        const unsigned location_number=
+          goto_functions.function_map.at("g").body.instructions.front()
+            .location_number;
+
+        frozen_goto_programt::targett target;
+        const auto function=copy.find_location(location_number, target);
+        REQUIRE(function==&*copied_functions.find("g"));
+        REQUIRE(target==0);
+      }
+    }
+  }
+}
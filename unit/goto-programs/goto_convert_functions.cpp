@@ -0,0 +1,93 @@
+/*******************************************************************\
+
+Module: Unit tests for converting functions in parallel
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <iostream>
+#include <sstream>
+
+#include <testing-utils/catch.hpp>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+
+#include <goto-programs/goto_convert_functions.h>
+
+#include <ansi-c/ansi_c_language.h>
+
+#include <langapi/mode.h>
+
+/// A model of \p count functions, each of which calls the next one if a
+/// nondeterministic value is zero
+static goto_modelt make_model(std::size_t count)
+{
+  goto_modelt goto_model;
+
+  for(std::size_t i=0; i<count; i++)
+  {
+    code_ifthenelset if_block;
+    if_block.cond()=
+      equal_exprt(
+        side_effect_expr_nondett(signed_int_type()),
+        from_integer(0, signed_int_type()));
+    code_function_callt call;
+    call.function()=
+      symbol_exprt("f"+std::to_string((i+1)%count), code_typet());
+    if_block.then_case()=call;
+
+    code_blockt body;
+    body.move_to_operands(if_block);
+
+    symbolt function;
+    function.name="f"+std::to_string(i);
+    function.type=code_typet();
+    function.mode=ID_C;
+    function.value=body;
+    goto_model.symbol_table.add(function);
+  }
+
+  return goto_model;
+}
+
+SCENARIO("goto_convert_in_parallel", "[core][goto-programs][goto_convert]")
+{
+  register_language(new_ansi_c_language);
+  stream_message_handlert message_handler(std::cerr);
+
+  GIVEN("A model with more functions than processes")
+  {
+    goto_modelt serial=make_model(7);
+    goto_convert(serial, 1, message_handler);
+
+    goto_modelt parallel=make_model(7);
+    goto_convert(parallel, 3, message_handler);
+
+    THEN("The functions are converted as they are serially")
+    {
+      REQUIRE(
+        parallel.goto_functions.function_map.size()==
+        serial.goto_functions.function_map.size());
+
+      const namespacet serial_ns(serial.symbol_table);
+      const namespacet parallel_ns(parallel.symbol_table);
+
+      for(const auto &f : serial.goto_functions.function_map)
+      {
+        std::ostringstream expected, actual;
+        f.second.body.output(serial_ns, f.first, expected);
+        parallel.goto_functions.function_map.at(f.first).body.output(
+          parallel_ns, f.first, actual);
+        REQUIRE(actual.str()==expected.str());
+      }
+
+      REQUIRE(
+        parallel.symbol_table.symbols.size()==
+        serial.symbol_table.symbols.size());
+    }
+  }
+}
@@ -0,0 +1,133 @@
+/*******************************************************************\
+
+Module: Unit tests for goto binaries of version 4
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <fstream>
+#include <sstream>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/message.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+#include <util/tempfile.h>
+
+#include <goto-programs/lazy_goto_binary.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+
+static void add_function(
+  symbol_tablet &symbol_table,
+  goto_functionst &goto_functions,
+  const irep_idt &name)
+{
+  code_typet type;
+  type.return_type()=empty_typet();
+
+  symbolt symbol;
+  symbol.name=name;
+  symbol.base_name=name;
+  symbol.type=type;
+  symbol.mode=ID_C;
+  symbol_table.add(symbol);
+
+  // while(x) skip;
+  symbol_exprt x(id2string(name)+"::x", signed_int_type());
+
+  goto_functionst::goto_functiont &f=goto_functions.function_map[name];
+  f.type=type;
+
+  goto_programt::targett loop=f.body.add_instruction(SKIP);
+  goto_programt::targett jump=f.body.add_instruction(GOTO);
+  jump->guard=notequal_exprt(x, from_integer(0, x.type()));
+  jump->targets.push_back(loop);
+  f.body.add_instruction(END_FUNCTION);
+}
+
+static void require_loop(const goto_programt &body)
+{
+  REQUIRE(body.instructions.size()==3);
+
+  goto_programt::const_targett jump=std::next(body.instructions.begin());
+  REQUIRE(jump->is_goto());
+  REQUIRE(jump->targets.size()==1);
+  REQUIRE(jump->get_target()==body.instructions.begin());
+  REQUIRE(jump->guard.id()==ID_notequal);
+}
+
+SCENARIO(
+  "goto_binary_v4",
+  "[core][goto-programs][lazy_goto_binary]")
+{
+  null_message_handlert message_handler;
+
+  // version 5 is compressed
+  for(int version : {4, GOTO_BINARY_COMPRESSED_VERSION})
+  {
+    GIVEN(
+      "A goto binary of version "+std::to_string(version)+
+      " with two functions")
+    {
+      symbol_tablet symbol_table;
+      goto_functionst goto_functions;
+      add_function(symbol_table, goto_functions, "f");
+      add_function(symbol_table, goto_functions, "g");
+      goto_functions.update();
+
+      std::ostringstream out;
+      REQUIRE(!write_goto_binary(out, symbol_table, goto_functions, version));
+
+      WHEN("It is read eagerly")
+      {
+        std::istringstream in(out.str());
+        symbol_tablet new_symbol_table;
+        goto_functionst new_goto_functions;
+
+        REQUIRE(
+          !read_bin_goto_object(
+            in, "", new_symbol_table, new_goto_functions, message_handler));
+
+        THEN("Symbols and bodies are restored")
+        {
+          REQUIRE(new_symbol_table.has_symbol("f"));
+          REQUIRE(new_symbol_table.has_symbol("g"));
+          require_loop(new_goto_functions.function_map.at("f").body);
+          require_loop(new_goto_functions.function_map.at("g").body);
+        }
+      }
+
+      WHEN("It is opened lazily")
+      {
+        temporary_filet file("goto_binary", ".gb");
+        {
+          std::ofstream stream(file(), std::ios::binary);
+          stream << out.str();
+        }
+
+        REQUIRE(lazy_goto_binaryt::is_lazy_goto_binary(file()));
+
+        lazy_goto_binaryt goto_binary;
+        symbol_tablet new_symbol_table;
+        REQUIRE(!goto_binary.open(file(), new_symbol_table, message_handler));
+
+        THEN("The symbols are available, and bodies can be decoded")
+        {
+          REQUIRE(new_symbol_table.has_symbol("f"));
+          REQUIRE(new_symbol_table.has_symbol("g"));
+          REQUIRE(goto_binary.has_function("g"));
+          REQUIRE(!goto_binary.has_function("h"));
+
+          goto_functiont g;
+          goto_binary.read_function("g", g);
+          require_loop(g.body);
+        }
+      }
+    }
+  }
+}
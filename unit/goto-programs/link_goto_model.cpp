@@ -0,0 +1,97 @@
+/*******************************************************************\
+
+Module: Unit tests for goto_model_linkert
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <util/arith_tools.h>
+#include <util/message.h>
+#include <util/std_code.h>
+#include <util/std_types.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/link_goto_model.h>
+
+/// A model with a function \p name returning \p value, and a global `x`
+static void add_function(
+  goto_modelt &goto_model,
+  const irep_idt &name,
+  int value,
+  bool is_weak)
+{
+  code_typet type;
+  type.return_type()=signedbv_typet(32);
+
+  symbolt symbol;
+  symbol.name=name;
+  symbol.base_name=name;
+  symbol.type=type;
+  symbol.mode=ID_C;
+  symbol.is_weak=is_weak;
+  symbol.value=code_blockt();
+  goto_model.symbol_table.add(symbol);
+
+  symbolt x;
+  x.name="x";
+  x.base_name="x";
+  x.type=signedbv_typet(32);
+  x.mode=ID_C;
+  x.is_lvalue=true;
+  x.is_static_lifetime=true;
+  goto_model.symbol_table.add(x);
+
+  goto_functionst::goto_functiont &f=
+    goto_model.goto_functions.function_map[name];
+  f.type=type;
+
+  goto_programt::targett assign=f.body.add_instruction(ASSIGN);
+  assign->code=
+    code_assignt(x.symbol_expr(), from_integer(value, x.type));
+  f.body.add_instruction(END_FUNCTION);
+}
+
+static int assigned_value(const goto_modelt &goto_model, const irep_idt &name)
+{
+  const goto_programt &body=
+    goto_model.goto_functions.function_map.at(name).body;
+  REQUIRE(body.instructions.front().is_assign());
+
+  mp_integer value;
+  REQUIRE(
+    !to_integer(to_code_assign(body.instructions.front().code).rhs(), value));
+  return integer2unsigned(value);
+}
+
+SCENARIO(
+  "goto_model_linkert",
+  "[core][goto-programs][link_goto_model]")
+{
+  null_message_handlert message_handler;
+
+  GIVEN("Objects that define functions, one of them weak")
+  {
+    goto_modelt a, b, c;
+    add_function(a, "f", 1, true);
+    add_function(b, "f", 2, false);
+    add_function(c, "g", 3, false);
+
+    goto_modelt dest;
+    goto_model_linkert linker(dest, message_handler);
+    linker.link(a);
+    linker.link(b);
+    linker.link(c);
+    linker.finalize();
+
+    THEN("All functions are linked, and the strong definition wins")
+    {
+      REQUIRE(dest.symbol_table.has_symbol("x"));
+      REQUIRE(dest.goto_functions.function_map.size()==2);
+      REQUIRE(assigned_value(dest, "f")==2);
+      REQUIRE(assigned_value(dest, "g")==3);
+    }
+  }
+}
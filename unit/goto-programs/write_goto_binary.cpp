@@ -0,0 +1,291 @@
+/*******************************************************************\
+
+Module: Unit tests and benchmark for the goto binary versions
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include <util/arith_tools.h>
+#include <util/irep_serialization.h>
+#include <util/message.h>
+#include <util/std_code.h>
+#include <util/std_types.h>
+
+#include <goto-programs/goto_binary_compression.h>
+#include <goto-programs/goto_model.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+
+/// A model with \p functions functions of \p instructions assignments each
+static void build_model(
+  goto_modelt &goto_model,
+  std::size_t functions,
+  std::size_t instructions)
+{
+  const signedbv_typet int_type(32);
+
+  code_typet type;
+  type.return_type()=empty_typet();
+
+  for(std::size_t i=0; i<functions; i++)
+  {
+    const irep_idt name="f"+std::to_string(i);
+
+    symbolt symbol;
+    symbol.name=name;
+    symbol.base_name=name;
+    symbol.type=type;
+    symbol.mode=ID_C;
+    goto_model.symbol_table.add(symbol);
+
+    symbolt local;
+    local.name=id2string(name)+"::x";
+    local.base_name="x";
+    local.type=int_type;
+    local.mode=ID_C;
+    local.is_lvalue=true;
+    goto_model.symbol_table.add(local);
+
+    goto_functionst::goto_functiont &f=
+      goto_model.goto_functions.function_map[name];
+    f.type=type;
+
+    const symbol_exprt x=local.symbol_expr();
+
+    for(std::size_t j=0; j<instructions; j++)
+    {
+      source_locationt source_location;
+      source_location.set_file("main.c");
+      source_location.set_line(j);
+      source_location.set_function(name);
+
+      goto_programt::targett t=f.body.add_instruction(ASSIGN);
+      t->code=code_assignt(x, plus_exprt(x, from_integer(j, int_type)));
+      t->source_location=source_location;
+    }
+
+    f.body.add_instruction(END_FUNCTION);
+  }
+
+  goto_model.goto_functions.update();
+}
+
+static void read_model(const std::string &binary, goto_modelt &goto_model)
+{
+  null_message_handlert message_handler;
+  std::istringstream in(binary);
+
+  REQUIRE(
+    !read_bin_goto_object(
+      in,
+      "",
+      goto_model.symbol_table,
+      goto_model.goto_functions,
+      message_handler));
+}
+
+SCENARIO(
+  "write_goto_binary",
+  "[core][goto-programs][write_goto_binary]")
+{
+  GIVEN("A goto model")
+  {
+    goto_modelt goto_model;
+    build_model(goto_model, 3, 5);
+
+    for(int version=3; version<=GOTO_BINARY_COMPRESSED_VERSION; version++)
+    {
+      WHEN("It is written as version "+std::to_string(version))
+      {
+        std::ostringstream out;
+        REQUIRE(!write_goto_binary(out, goto_model, version));
+
+        THEN("Reading it back yields the same model")
+        {
+          goto_modelt new_goto_model;
+          read_model(out.str(), new_goto_model);
+
+          REQUIRE(
+            new_goto_model.symbol_table.symbols.size()==
+            goto_model.symbol_table.symbols.size());
+
+          for(const auto &f : goto_model.goto_functions.function_map)
+          {
+            const goto_programt &body=f.second.body;
+            const goto_programt &new_body=
+              new_goto_model.goto_functions.function_map.at(f.first).body;
+
+            REQUIRE(new_body.instructions.size()==body.instructions.size());
+
+            auto new_it=new_body.instructions.begin();
+            for(const auto &instruction : body.instructions)
+            {
+              REQUIRE(new_it->code==instruction.code);
+              REQUIRE(new_it->source_location==instruction.source_location);
+              ++new_it;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+SCENARIO(
+  "goto_binary_sizes",
+  "[core][goto-programs][write_goto_binary]")
+{
+  GIVEN("A goto model with many functions")
+  {
+    goto_modelt goto_model;
+    build_model(goto_model, 100, 20);
+
+    std::vector<std::size_t> sizes;
+
+    for(int version=3; version<=GOTO_BINARY_COMPRESSED_VERSION; version++)
+    {
+      std::ostringstream out;
+      REQUIRE(!write_goto_binary(out, goto_model, version));
+      sizes.push_back(out.str().size());
+    }
+
+    const std::size_t v3=sizes[0], v4=sizes[1], v5=sizes[2];
+
+    THEN("Version 4 shares strings and ireps across its sections")
+    {
+      REQUIRE(v4<=v3);
+    }
+
+    THEN("Version 5 is smaller than version 4")
+    {
+      REQUIRE(v5<v4);
+    }
+  }
+}
+
+SCENARIO(
+  "read_bin_goto_function",
+  "[core][goto-programs][write_goto_binary]")
+{
+  GIVEN("A function section that claims more instructions than it holds")
+  {
+    std::ostringstream out;
+    write_gb_word(out, std::numeric_limits<std::size_t>::max());
+    write_gb_word(out, 0);
+
+    THEN("It is reported as corrupt once the input is exhausted")
+    {
+      std::istringstream in(out.str());
+      irep_serializationt::string_tablet string_table;
+      irep_serializationt::ireps_containert ic;
+      irep_serializationt irepconverter(ic, string_table);
+      goto_functionst::goto_functiont goto_function;
+
+      read_bin_goto_function(in, goto_function, irepconverter);
+
+      REQUIRE(!in);
+      REQUIRE(goto_function.body.instructions.size()<=1);
+    }
+  }
+}
+
+// Not run by default; run as `unit_tests [benchmark]`
+TEST_CASE(
+  "goto_binary_benchmark",
+  "[.][benchmark][goto-programs][write_goto_binary]")
+{
+  typedef std::chrono::steady_clock clockt;
+
+  goto_modelt goto_model;
+  build_model(goto_model, 2000, 50);
+
+  for(int version=3; version<=GOTO_BINARY_COMPRESSED_VERSION; version++)
+  {
+    const clockt::time_point start=clockt::now();
+
+    std::ostringstream out;
+    REQUIRE(!write_goto_binary(out, goto_model, version));
+    const std::string binary=out.str();
+
+    const clockt::time_point written=clockt::now();
+
+    goto_modelt new_goto_model;
+    read_model(binary, new_goto_model);
+
+    const clockt::time_point read=clockt::now();
+
+    std::cout
+      << "goto binary version " << version << ": "
+      << binary.size() << " bytes, write "
+      << std::chrono::duration<double>(written-start).count() << "s, read "
+      << std::chrono::duration<double>(read-written).count() << "s\n";
+
+    REQUIRE(
+      new_goto_model.goto_functions.function_map.size()==
+      goto_model.goto_functions.function_map.size());
+  }
+}
+
+SCENARIO(
+  "goto_binary_compression",
+  "[core][goto-programs][write_goto_binary]")
+{
+  GIVEN("A compressed section")
+  {
+    const std::string data(1000, 'x');
+    const std::string compressed=compress_goto_binary_section(data);
+
+    THEN("It is decompressed given its size")
+    {
+      std::string dest;
+      REQUIRE(
+        !uncompress_goto_binary_section(
+          compressed.data(), compressed.size(), data.size(), dest));
+      REQUIRE(dest==data);
+    }
+
+    THEN("A size beyond what deflate can yield is rejected")
+    {
+      std::string dest;
+      REQUIRE(
+        uncompress_goto_binary_section(
+          compressed.data(),
+          compressed.size(),
+          std::numeric_limits<std::size_t>::max(),
+          dest));
+      REQUIRE(dest.empty());
+    }
+  }
+
+  GIVEN("A section compressed as it is written")
+  {
+    // more than the compressor buffers at a time
+    std::string data;
+    for(std::size_t i=0; i<100000; i++)
+      data+=std::to_string(i%997);
+
+    compressed_goto_binary_sectiont section;
+    section << data.substr(0, 10) << data.substr(10);
+    const std::string compressed=section.finish();
+
+    THEN("It decompresses to what was written")
+    {
+      REQUIRE(section.uncompressed_size()==data.size());
+
+      std::string dest;
+      REQUIRE(
+        !uncompress_goto_binary_section(
+          compressed.data(), compressed.size(), data.size(), dest));
+      REQUIRE(dest==data);
+    }
+  }
+}
@@ -93,6 +93,74 @@ SCENARIO("path strategies")
        symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
        symex_eventt::result(symex_eventt::enumt::SUCCESS)},
       unwind_limit);
+    // The paths through the branch are merged, leaving nothing to resume
+    check_with_strategy(
+      "merge",
+      c,
+      {symex_eventt::result(symex_eventt::enumt::SUCCESS)},
+      unwind_limit);
+  }
+
+  GIVEN("a conditional program with a function call in a branch")
+  {
+    c =
+      "/*  1 */  void f(int *x)  \n"
+      "/*  2 */  {               \n"
+      "/*  3 */    *x = 1;       \n"
+      "/*  4 */  }               \n"
+      "/*  5 */  int main()      \n"
+      "/*  6 */  {               \n"
+      "/*  7 */    int x;        \n"
+      "/*  8 */    if(x)         \n"
+      "/*  9 */      f(&x);      \n"
+      "/* 10 */    else          \n"
+      "/* 11 */      x = 0;      \n"
+      "/* 12 */  }               \n";
+
+    const unsigned unwind_limit = 0U;
+
+    // The call is not merged, so the paths are explored as with lifo
+    check_with_strategy(
+      "merge",
+      c,
+      {symex_eventt::resume(symex_eventt::enumt::JUMP, 11),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 9),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS)},
+      unwind_limit);
+  }
+
+  GIVEN("a conditional program with an assertion in a branch")
+  {
+    c =
+      "/*  1 */  int main()      \n"
+      "/*  2 */  {               \n"
+      "/*  3 */    int x;        \n"
+      "/*  4 */    if(x)         \n"
+      "/*  5 */      assert(0);  \n"
+      "/*  6 */    else          \n"
+      "/*  7 */      x = 0;      \n"
+      "/*  8 */  }               \n";
+
+    const unsigned unwind_limit = 0U;
+
+    check_with_strategy(
+      "lifo",
+      c,
+      {symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
+       symex_eventt::result(symex_eventt::enumt::FAILURE)},
+      unwind_limit);
+    // The assertion is only reachable from the next instruction
+    check_with_strategy(
+      "distance",
+      c,
+      {symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
+       symex_eventt::result(symex_eventt::enumt::FAILURE),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS)},
+      unwind_limit);
   }
 
   GIVEN("a program with nested conditionals")
@@ -157,6 +225,173 @@ SCENARIO("path strategies")
        symex_eventt::resume(symex_eventt::enumt::JUMP, 16),
        symex_eventt::result(symex_eventt::enumt::SUCCESS)},
       unwind_limit);
+
+    // All four paths are merged
+    check_with_strategy(
+      "merge",
+      c,
+      {symex_eventt::result(symex_eventt::enumt::SUCCESS)},
+      unwind_limit);
+  }
+
+  GIVEN("a program with a chain of conditionals followed by another")
+  {
+    c =
+      "/*  1 */  int main()            \n"
+      "/*  2 */  {                     \n"
+      "/*  3 */    int x, y, z;        \n"
+      "/*  4 */    if(x)               \n"
+      "/*  5 */      x = 1;            \n"
+      "/*  6 */    else if(y)          \n"
+      "/*  7 */      y = 1;            \n"
+      "/*  8 */    else                \n"
+      "/*  9 */      y = 0;            \n"
+      "/* 10 */    if(z)               \n"
+      "/* 11 */      z = 1;            \n"
+      "/* 12 */    else                \n"
+      "/* 13 */      z = 0;            \n"
+      "/* 14 */  }                     \n";
+
+    const unsigned unwind_limit = 0U;
+
+    check_with_strategy(
+      "lifo",
+      c,
+      {symex_eventt::resume(symex_eventt::enumt::JUMP, 6),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 9),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 13),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 11),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 7),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 13),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 11),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 13),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 11),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS)},
+      unwind_limit);
+    // The paths saved after resuming from line 7 resume at lines 11 and 13,
+    // which have been executed before, so the path to line 5, which has not,
+    // is resumed before them
+    check_with_strategy(
+      "coverage",
+      c,
+      {symex_eventt::resume(symex_eventt::enumt::JUMP, 6),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 9),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 13),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 11),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 7),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 13),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 11),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 13),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 11),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS)},
+      unwind_limit);
+  }
+
+  GIVEN("a program with enough paths for a random restart")
+  {
+    c =
+      "/*  1 */  int main()            \n"
+      "/*  2 */  {                     \n"
+      "/*  3 */    int w, x, y, z;     \n"
+      "/*  4 */    if(w)               \n"
+      "/*  5 */      w = 1;            \n"
+      "/*  6 */    else                \n"
+      "/*  7 */      w = 0;            \n"
+      "/*  8 */    if(x)               \n"
+      "/*  9 */      return 0;         \n"
+      "/* 10 */    else                \n"
+      "/* 11 */      x = 0;            \n"
+      "/* 12 */    if(y)               \n"
+      "/* 13 */      y = 1;            \n"
+      "/* 14 */    else                \n"
+      "/* 15 */      y = 0;            \n"
+      "/* 16 */    if(z)               \n"
+      "/* 17 */      z = 1;            \n"
+      "/* 18 */    else                \n"
+      "/* 19 */      z = 0;            \n"
+      "/* 20 */    return 0;           \n"
+      "/* 21 */  }                     \n";
+
+    const unsigned unwind_limit = 0U;
+
+    check_with_strategy(
+      "lifo",
+      c,
+      {symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 11),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 15),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 19),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 17),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 13),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 19),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 17),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 9),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 11),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 15),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 19),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 17),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 13),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 19),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 17),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 9),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS)},
+      unwind_limit);
+    // The 16th path is chosen among the two paths that lifo would resume
+    // later; the first output of the generator, 48271, picks the second one
+    check_with_strategy(
+      "random-restart",
+      c,
+      {symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 11),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 15),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 19),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 17),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 13),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 19),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 17),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 9),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 11),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 15),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 19),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 17),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 13),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 17),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 19),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 9),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS)},
+      unwind_limit);
   }
 
   GIVEN("a loop program to test functional correctness")
@@ -221,6 +456,22 @@ SCENARIO("path strategies")
         symex_eventt::result(symex_eventt::enumt::FAILURE),
       },
       unwind_limit);
+
+    // The paths through the loop are never merged, so they are explored as
+    // with lifo
+    check_with_strategy(
+      "merge",
+      c,
+      {
+        symex_eventt::resume(symex_eventt::enumt::JUMP, 9),
+        symex_eventt::result(symex_eventt::enumt::SUCCESS),
+        symex_eventt::resume(symex_eventt::enumt::NEXT, 7),
+        symex_eventt::resume(symex_eventt::enumt::JUMP, 9),
+        symex_eventt::result(symex_eventt::enumt::FAILURE),
+        symex_eventt::resume(symex_eventt::enumt::NEXT, 7),
+        symex_eventt::result(symex_eventt::enumt::SUCCESS),
+      },
+      unwind_limit);
   }
 }
 
@@ -324,6 +575,7 @@ void _check_with_strategy(
   int ret;
   ret = cbmc_parse_optionst::get_goto_program(gm, opts, cmdline, log, mh);
   REQUIRE(ret == -1);
+  worklist->set_program(gm.get_goto_functions());
 
   cbmc_solverst solvers(opts, gm.get_symbol_table(), mh);
   solvers.set_ui(mh.get_ui());
@@ -0,0 +1,124 @@
+/*******************************************************************\
+
+Module: Unit tests for demand_driven_value_setst
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+#include <testing-utils/points_to.h>
+
+#include <util/c_types.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+
+#include <pointer-analysis/demand_driven_value_sets.h>
+
+SCENARIO(
+  "demand_driven_value_sets",
+  "[core][pointer-analysis][demand_driven_value_sets]")
+{
+  GIVEN("A program with copies and stores through pointers")
+  {
+    // int x, y;
+    // int *p, *q, *r;
+    // int **pp;
+    // p=&x; q=p; pp=&r; *pp=&y; r=q;
+    symbol_tablet symbol_table;
+    namespacet ns(symbol_table);
+
+    const typet int_type=signed_int_type();
+    const pointer_typet int_ptr=pointer_type(int_type);
+
+    const symbol_exprt x=add_variable(symbol_table, "x", int_type);
+    const symbol_exprt y=add_variable(symbol_table, "y", int_type);
+    const symbol_exprt p=add_variable(symbol_table, "p", int_ptr);
+    const symbol_exprt q=add_variable(symbol_table, "q", int_ptr);
+    const symbol_exprt r=add_variable(symbol_table, "r", int_ptr);
+    const symbol_exprt pp=
+      add_variable(symbol_table, "pp", pointer_type(int_ptr));
+    const symbol_exprt s=add_variable(symbol_table, "s", int_ptr);
+
+    goto_functionst goto_functions;
+    goto_programt &body=
+      goto_functions.function_map[goto_functionst::entry_point()].body;
+
+    add_assignment(body, p, address_of_exprt(x));
+    add_assignment(body, q, p);
+    add_assignment(body, pp, address_of_exprt(r));
+    add_assignment(body, dereference_exprt(pp, int_ptr), address_of_exprt(y));
+    add_assignment(body, r, q);
+    add_assignment(body, s, null_pointer_exprt(int_ptr));
+    body.add_instruction(END_FUNCTION);
+    goto_functions.update();
+
+    demand_driven_value_setst value_sets(ns);
+    value_sets(goto_functions);
+
+    const goto_programt::const_targett l=body.instructions.begin();
+
+    WHEN("Querying a copied pointer")
+    {
+      value_setst::valuest values;
+      value_sets.get_values(l, q, values);
+
+      THEN("It points to what the original pointed to")
+      {
+        REQUIRE(values.size()==1);
+        REQUIRE(points_to(values, "x"));
+      }
+      THEN("Only the objects the query depends on have been solved")
+      {
+        // q and p; no store can write to them, as their addresses are
+        // never taken, so pp is not needed
+        REQUIRE(value_sets.get_number_of_solved_objects()==2);
+      }
+    }
+
+    WHEN("Querying a pointer assigned both directly and through a store")
+    {
+      value_setst::valuest values;
+      value_sets.get_values(l, r, values);
+
+      THEN("Both targets are included")
+      {
+        REQUIRE(values.size()==2);
+        REQUIRE(points_to(values, "x"));
+        REQUIRE(points_to(values, "y"));
+      }
+      THEN("The pointer stored through has been solved as well")
+      {
+        // r, q, p and pp
+        REQUIRE(value_sets.get_number_of_solved_objects()==4);
+      }
+    }
+
+    WHEN("Querying a load through a pointer to a pointer")
+    {
+      value_setst::valuest values;
+      value_sets.get_values(l, dereference_exprt(pp, int_ptr), values);
+
+      THEN("The result is what the pointee points to")
+      {
+        REQUIRE(values.size()==2);
+        REQUIRE(points_to(values, "x"));
+        REQUIRE(points_to(values, "y"));
+      }
+    }
+
+    WHEN("Querying a null pointer")
+    {
+      value_setst::valuest values;
+      value_sets.get_values(l, s, values);
+
+      THEN("It points to the null object")
+      {
+        REQUIRE(values.size()==1);
+        REQUIRE(
+          to_object_descriptor_expr(values.front()).object().id()==
+          ID_null_object);
+      }
+    }
+  }
+}
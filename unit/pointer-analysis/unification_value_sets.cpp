@@ -0,0 +1,164 @@
+/*******************************************************************\
+
+Module: Unit tests for unification_value_setst
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+#include <testing-utils/points_to.h>
+
+#include <util/c_types.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+
+#include <pointer-analysis/unification_value_sets.h>
+
+SCENARIO(
+  "unification_value_sets",
+  "[core][pointer-analysis][unification_value_sets]")
+{
+  GIVEN("A program with copies, stores and an indirect call")
+  {
+    // int x, y, z, b;
+    // int *p, *q, *r, *s, *u;
+    // int **pp;
+    // int *id(int *a) { return a; }
+    // int *(*fp)(int *);
+    // p=&x; q=p; pp=&r; *pp=&y; r=q; s=NULL; fp=&id; u=(*fp)(&z);
+    // b=(p==s);
+    symbol_tablet symbol_table;
+    namespacet ns(symbol_table);
+
+    const typet int_type=signed_int_type();
+    const pointer_typet int_ptr=pointer_type(int_type);
+
+    const symbol_exprt x=add_variable(symbol_table, "x", int_type);
+    const symbol_exprt y=add_variable(symbol_table, "y", int_type);
+    const symbol_exprt z=add_variable(symbol_table, "z", int_type);
+    const symbol_exprt b=add_variable(symbol_table, "b", int_type);
+    const symbol_exprt p=add_variable(symbol_table, "p", int_ptr);
+    const symbol_exprt q=add_variable(symbol_table, "q", int_ptr);
+    const symbol_exprt r=add_variable(symbol_table, "r", int_ptr);
+    const symbol_exprt s=add_variable(symbol_table, "s", int_ptr);
+    const symbol_exprt u=add_variable(symbol_table, "u", int_ptr);
+    const symbol_exprt pp=
+      add_variable(symbol_table, "pp", pointer_type(int_ptr));
+
+    code_typet id_type;
+    id_type.return_type()=int_ptr;
+    code_typet::parametert parameter(int_ptr);
+    parameter.set_identifier("id::a");
+    id_type.parameters().push_back(parameter);
+    const symbol_exprt a=add_variable(symbol_table, "id::a", int_ptr);
+    const symbol_exprt id=add_variable(symbol_table, "id", id_type);
+    const symbol_exprt fp=
+      add_variable(symbol_table, "fp", pointer_type(id_type));
+
+    goto_functionst goto_functions;
+
+    goto_functionst::goto_functiont &id_function=
+      goto_functions.function_map["id"];
+    id_function.type=id_type;
+    goto_programt::targett ret=id_function.body.add_instruction(RETURN);
+    ret->code=code_returnt(a);
+    id_function.body.add_instruction(END_FUNCTION);
+
+    goto_programt &body=
+      goto_functions.function_map[goto_functionst::entry_point()].body;
+
+    add_assignment(body, p, address_of_exprt(x));
+    add_assignment(body, q, p);
+    add_assignment(body, pp, address_of_exprt(r));
+    add_assignment(body, dereference_exprt(pp, int_ptr), address_of_exprt(y));
+    add_assignment(body, r, q);
+    add_assignment(body, s, null_pointer_exprt(int_ptr));
+    add_assignment(body, fp, address_of_exprt(id));
+
+    code_function_callt call;
+    call.lhs()=u;
+    call.function()=dereference_exprt(fp, id_type);
+    call.arguments().push_back(address_of_exprt(z));
+    goto_programt::targett c=body.add_instruction(FUNCTION_CALL);
+    c->code=call;
+
+    add_assignment(body, b, typecast_exprt(equal_exprt(p, s), int_type));
+
+    body.add_instruction(END_FUNCTION);
+    goto_functions.update();
+
+    unification_value_setst value_sets(ns);
+    value_sets(goto_functions);
+
+    const goto_programt::const_targett l=body.instructions.begin();
+
+    WHEN("Querying a pointer that is assigned to another one")
+    {
+      value_setst::valuest values;
+      value_sets.get_values(l, q, values);
+
+      THEN("The targets of both pointers are unified")
+      {
+        REQUIRE(values.size()==2);
+        REQUIRE(points_to(values, "x"));
+        REQUIRE(points_to(values, "y"));
+      }
+    }
+
+    WHEN("Querying a null pointer")
+    {
+      value_setst::valuest values;
+      value_sets.get_values(l, s, values);
+
+      THEN("It points to the null object only")
+      {
+        REQUIRE(values.size()==1);
+        REQUIRE(
+          to_object_descriptor_expr(values.front()).object().id()==
+          ID_null_object);
+      }
+    }
+
+    WHEN("Querying a choice between pointers of different classes")
+    {
+      const std::size_t classes=value_sets.get_number_of_classes();
+
+      value_setst::valuest values;
+      value_sets.get_values(
+        l, if_exprt(equal_exprt(b, b), p, s), values);
+
+      THEN("The targets of both pointers are included")
+      {
+        REQUIRE(values.size()==3);
+        REQUIRE(points_to(values, "x"));
+        REQUIRE(points_to(values, "y"));
+      }
+      THEN("The classes are not changed by the query")
+      {
+        REQUIRE(value_sets.get_number_of_classes()==classes);
+        REQUIRE(!value_sets.may_alias(p, s));
+      }
+    }
+
+    WHEN("Querying the result of a call via a function pointer")
+    {
+      value_setst::valuest values;
+      value_sets.get_values(l, u, values);
+
+      THEN("It points to the argument passed")
+      {
+        REQUIRE(values.size()==1);
+        REQUIRE(points_to(values, "z"));
+      }
+    }
+
+    THEN("Pointers are only aliased within their class")
+    {
+      REQUIRE(value_sets.may_alias(p, r));
+      REQUIRE(!value_sets.may_alias(p, s));
+      REQUIRE(!value_sets.may_alias(p, pp));
+      REQUIRE(!value_sets.may_alias(p, u));
+    }
+  }
+}
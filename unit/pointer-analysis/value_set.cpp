@@ -0,0 +1,80 @@
+/*******************************************************************\
+
+Module: Unit tests for value_sett
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+#include <testing-utils/points_to.h>
+
+#include <util/c_types.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+
+#include <pointer-analysis/value_set.h>
+
+static std::size_t number_of_targets(
+  const value_sett &value_set,
+  const exprt &pointer,
+  const namespacet &ns)
+{
+  value_setst::valuest values;
+  value_set.get_value_set(pointer, values, ns);
+  return values.size();
+}
+
+SCENARIO(
+  "value_set_make_union",
+  "[core][pointer-analysis][value_set]")
+{
+  GIVEN("A value set and a copy of it")
+  {
+    symbol_tablet symbol_table;
+    namespacet ns(symbol_table);
+
+    const typet int_type=signed_int_type();
+    const pointer_typet int_ptr=pointer_type(int_type);
+
+    const symbol_exprt x=add_variable(symbol_table, "x", int_type);
+    const symbol_exprt y=add_variable(symbol_table, "y", int_type);
+    const symbol_exprt p=add_variable(symbol_table, "p", int_ptr);
+    const symbol_exprt q=add_variable(symbol_table, "q", int_ptr);
+
+    value_sett value_set;
+    value_set.assign(p, address_of_exprt(x), ns, false, false);
+
+    value_sett copy=value_set;
+
+    WHEN("Merging the unmodified copy")
+    {
+      THEN("Nothing changes")
+      {
+        REQUIRE(!value_set.make_union(copy));
+        REQUIRE(value_set.values.size()==1);
+      }
+    }
+
+    WHEN("The copy is modified and merged back")
+    {
+      copy.assign(p, address_of_exprt(y), ns, false, false);
+      copy.assign(q, address_of_exprt(y), ns, false, false);
+
+      THEN("The original is unaffected by the modification")
+      {
+        REQUIRE(value_set.values.size()==1);
+        REQUIRE(number_of_targets(value_set, p, ns)==1);
+      }
+      THEN("Merging adds the new entries and targets")
+      {
+        REQUIRE(value_set.make_union(copy));
+        REQUIRE(value_set.values.size()==2);
+        REQUIRE(number_of_targets(value_set, p, ns)==2);
+        REQUIRE(number_of_targets(value_set, q, ns)==1);
+
+        REQUIRE(!value_set.make_union(copy));
+      }
+    }
+  }
+}
@@ -0,0 +1,61 @@
+/*******************************************************************\
+
+ Module: Unit test utilities
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include "points_to.h"
+
+#include <util/std_code.h>
+
+/// Add a global variable to the symbol table
+/// \param symbol_table: The symbol table to add the variable to
+/// \param name: The name of the variable
+/// \param type: The type of the variable
+/// \return The symbol expression of the variable
+symbol_exprt add_variable(
+  symbol_tablet &symbol_table,
+  const irep_idt &name,
+  const typet &type)
+{
+  symbolt symbol;
+  symbol.name=name;
+  symbol.base_name=name;
+  symbol.type=type;
+  symbol.is_lvalue=true;
+  symbol.is_static_lifetime=true;
+  symbol_table.add(symbol);
+  return symbol.symbol_expr();
+}
+
+/// Append the assignment `lhs=rhs` to \p goto_program
+void add_assignment(
+  goto_programt &goto_program,
+  const exprt &lhs,
+  const exprt &rhs)
+{
+  goto_programt::targett t=goto_program.add_instruction(ASSIGN);
+  t->code=code_assignt(lhs, rhs);
+}
+
+/// Check whether the result of a points-to query includes a variable
+/// \param values: The result of value_setst::get_values
+/// \param identifier: The name of the variable
+/// \return True if \p values includes the object \p identifier
+bool points_to(
+  const value_setst::valuest &values,
+  const irep_idt &identifier)
+{
+  for(const auto &value : values)
+  {
+    if(value.id()==ID_object_descriptor &&
+       to_object_descriptor_expr(value).object().id()==ID_symbol &&
+       to_symbol_expr(to_object_descriptor_expr(value).object())
+         .get_identifier()==identifier)
+      return true;
+  }
+
+  return false;
+}
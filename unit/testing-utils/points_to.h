@@ -0,0 +1,36 @@
+/*******************************************************************\
+
+ Module: Unit test utilities
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Helper functions for building small programs for points-to analyses and
+/// checking their results during unit tests
+
+#ifndef CPROVER_TESTING_UTILS_POINTS_TO_H
+#define CPROVER_TESTING_UTILS_POINTS_TO_H
+
+#include <util/symbol_table.h>
+
+#include <goto-programs/goto_program.h>
+
+#include <pointer-analysis/value_sets.h>
+
+symbol_exprt add_variable(
+  symbol_tablet &symbol_table,
+  const irep_idt &name,
+  const typet &type);
+
+void add_assignment(
+  goto_programt &goto_program,
+  const exprt &lhs,
+  const exprt &rhs);
+
+bool points_to(
+  const value_setst::valuest &values,
+  const irep_idt &identifier);
+
+#endif // CPROVER_TESTING_UTILS_POINTS_TO_H
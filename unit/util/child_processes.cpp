@@ -0,0 +1,63 @@
+/*******************************************************************\
+
+Module: Unit tests for run_in_child_processes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <iostream>
+#include <sstream>
+
+#include <testing-utils/catch.hpp>
+
+#include <util/child_processes.h>
+#include <util/message.h>
+#include <util/tempdir.h>
+
+#ifndef _WIN32
+SCENARIO("run_in_child_processes", "[core][util][child_processes]")
+{
+  GIVEN("More jobs than processes")
+  {
+    temp_dirt tmp_dir("child-processes-XXXXXX");
+    stream_message_handlert message_handler(std::cerr);
+    int parent_state=0;
+
+    const std::vector<int> status=run_in_child_processes(
+      5,
+      2,
+      tmp_dir.path,
+      message_handler,
+      [&parent_state](std::size_t job) {
+        parent_state=1;
+        std::cout << "output of job " << job << '\n';
+        if(job==3)
+          throw std::string("job 3 failed");
+        return static_cast<int>(job);
+      });
+
+    THEN("Each job runs in a child process of its own")
+    {
+      REQUIRE(status==std::vector<int>({0, 1, 2, 1, 4}));
+      REQUIRE(parent_state==0);
+    }
+
+    THEN("The output of each job is replayed")
+    {
+      std::ostringstream out, err;
+      std::streambuf *cout_buf=std::cout.rdbuf(out.rdbuf());
+      std::streambuf *cerr_buf=std::cerr.rdbuf(err.rdbuf());
+
+      replay_child_output(tmp_dir.path, 1);
+      replay_child_output(tmp_dir.path, 3);
+
+      std::cout.rdbuf(cout_buf);
+      std::cerr.rdbuf(cerr_buf);
+
+      REQUIRE(out.str()=="output of job 1\noutput of job 3\n");
+      REQUIRE(err.str()=="job 3 failed\n");
+    }
+  }
+}
+#endif
@@ -5,6 +5,8 @@
 #include <testing-utils/catch.hpp>
 #include <util/small_map.h>
 
+#include <memory>
+
 void small_map_test()
 {
   SECTION("Basic")
@@ -208,6 +210,45 @@ void small_map_test()
     auto it = m.find(2);
     REQUIRE(it != m.end());
   }
+
+  SECTION("Non-trivially copyable values")
+  {
+    const std::shared_ptr<int> a = std::make_shared<int>(1);
+    const std::shared_ptr<int> b = std::make_shared<int>(2);
+    const std::shared_ptr<int> c = std::make_shared<int>(3);
+
+    {
+      small_mapt<std::shared_ptr<int>> m;
+
+      m[2] = a;
+      m[5] = b;
+      m[6] = c;
+
+      REQUIRE(a.use_count() == 2);
+      REQUIRE(b.use_count() == 2);
+      REQUIRE(c.use_count() == 2);
+
+      m.erase(2);
+
+      REQUIRE(a.use_count() == 1);
+      REQUIRE(b.use_count() == 2);
+      REQUIRE(c.use_count() == 2);
+      REQUIRE(m.size() == 2);
+      REQUIRE(*m[5] == 2);
+      REQUIRE(*m[6] == 3);
+
+      m[0] = a;
+
+      REQUIRE(a.use_count() == 2);
+      REQUIRE(*m[0] == 1);
+      REQUIRE(*m[5] == 2);
+      REQUIRE(*m[6] == 3);
+    }
+
+    REQUIRE(a.use_count() == 1);
+    REQUIRE(b.use_count() == 1);
+    REQUIRE(c.use_count() == 1);
+  }
 }
 
 TEST_CASE("Small map")
@@ -0,0 +1,80 @@
+/*******************************************************************\
+
+ Module: sparse_bitsett unit tests
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+#include <util/sparse_bitset.h>
+
+#include <vector>
+
+TEST_CASE("Sparse bitset insert and erase", "[core][util][sparse_bitset]")
+{
+  sparse_bitsett s;
+  REQUIRE(s.empty());
+  REQUIRE(s.begin() == s.end());
+
+  REQUIRE(s.insert(3));
+  REQUIRE(s.insert(1000));
+  REQUIRE(s.insert(64));
+  REQUIRE(s.insert(63));
+  REQUIRE(!s.insert(64));
+
+  REQUIRE(s.size() == 4);
+  REQUIRE(s.contains(63));
+  REQUIRE(!s.contains(65));
+
+  const std::vector<std::size_t> expected = {3, 63, 64, 1000};
+  REQUIRE(std::vector<std::size_t>(s.begin(), s.end()) == expected);
+
+  REQUIRE(s.erase(1000) == 1);
+  REQUIRE(s.erase(1000) == 0);
+  REQUIRE(s.size() == 3);
+
+  s.clear();
+  REQUIRE(s.empty());
+}
+
+TEST_CASE("Sparse bitset copy on write", "[core][util][sparse_bitset]")
+{
+  sparse_bitsett a;
+  a.insert(1);
+  a.insert(200);
+
+  sparse_bitsett b(a);
+  REQUIRE(a == b);
+
+  b.insert(5);
+  REQUIRE(!a.contains(5));
+  REQUIRE(b.contains(5));
+  REQUIRE(a != b);
+
+  b.erase(5);
+  REQUIRE(a == b);
+}
+
+TEST_CASE("Sparse bitset union", "[core][util][sparse_bitset]")
+{
+  sparse_bitsett a;
+  a.insert(1);
+  a.insert(130);
+
+  sparse_bitsett b;
+  b.insert(2);
+  b.insert(130);
+  b.insert(4000);
+
+  REQUIRE(a.make_union(b));
+  REQUIRE(!a.make_union(b));
+  REQUIRE(!a.make_union(a));
+
+  const std::vector<std::size_t> expected = {1, 2, 130, 4000};
+  REQUIRE(std::vector<std::size_t>(a.begin(), a.end()) == expected);
+
+  sparse_bitsett empty;
+  REQUIRE(empty.make_union(b));
+  REQUIRE(empty == b);
+}